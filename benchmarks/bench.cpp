@@ -0,0 +1,162 @@
+#include "bench.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <vector>
+#if defined(_MSC_VER)
+#include <malloc.h>
+#endif
+
+// every heap allocation of the process goes through these operators, the counters are read around a benchmark
+static std::atomic<uint64_t> nof_allocations{0};
+static std::atomic<uint64_t> nof_allocated_bytes{0};
+
+static void *allocate(std::size_t size, std::size_t alignment) {
+    nof_allocations.fetch_add(1, std::memory_order_relaxed);
+    nof_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (size == 0) { size = 1; }
+    if (alignment <= alignof(std::max_align_t)) { return std::malloc(size); }
+#if defined(_MSC_VER)
+    // the CRT of MSVC has no aligned_alloc, its aligned blocks are released with _aligned_free
+    return _aligned_malloc(size, alignment);
+#else
+    return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+#endif
+}
+
+static void release_aligned(void *ptr) noexcept {
+#if defined(_MSC_VER)
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+void *operator new(std::size_t size) {
+    if (void *ptr = allocate(size, alignof(std::max_align_t))) { return ptr; }
+    throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+    if (void *ptr = allocate(size, (std::size_t)alignment)) { return ptr; }
+    throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+    return allocate(size, alignof(std::max_align_t));
+}
+
+void *operator new[](std::size_t size) { return operator new(size); }
+void *operator new[](std::size_t size, std::align_val_t alignment) { return operator new(size, alignment); }
+void *operator new[](std::size_t size, const std::nothrow_t &tag) noexcept { return operator new(size, tag); }
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::align_val_t) noexcept { release_aligned(ptr); }
+void operator delete(void *ptr, std::size_t, std::align_val_t) noexcept { release_aligned(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::align_val_t) noexcept { release_aligned(ptr); }
+void operator delete[](void *ptr, std::size_t, std::align_val_t) noexcept { release_aligned(ptr); }
+
+void BenchContext::pause() {
+    _pause_start = clock::now();
+    _pause_allocations = nof_allocations.load(std::memory_order_relaxed);
+    _pause_bytes = nof_allocated_bytes.load(std::memory_order_relaxed);
+}
+
+void BenchContext::resume() {
+    _paused_allocations += nof_allocations.load(std::memory_order_relaxed) - _pause_allocations;
+    _paused_bytes += nof_allocated_bytes.load(std::memory_order_relaxed) - _pause_bytes;
+    _paused += clock::now() - _pause_start;
+}
+
+struct Bench {
+    std::string name;
+    BenchBody body;
+};
+
+static std::vector<Bench> &get_benches() {
+    static std::vector<Bench> benches;
+    return benches;
+}
+
+bool register_bench(const std::string &name, BenchBody body) {
+    get_benches().push_back({name, std::move(body)});
+    return true;
+}
+
+// one JSON object per line: the name, the operations measured, the time and the heap allocations per operation
+static void run_bench(const Bench &bench, double min_seconds) {
+    using clock = std::chrono::steady_clock;
+
+    BenchContext warm_up;
+    bench.body(warm_up);
+
+    BenchContext ctx;
+    uint64_t ops = 0;
+    const uint64_t allocations = nof_allocations.load(std::memory_order_relaxed);
+    const uint64_t bytes = nof_allocated_bytes.load(std::memory_order_relaxed);
+    const auto start = clock::now();
+    auto end = start;
+    do {
+        ops += bench.body(ctx);
+        end = clock::now();
+    } while (std::chrono::duration<double>(end - start - ctx.get_paused()).count() < min_seconds);
+
+    const double seconds = std::chrono::duration<double>(end - start - ctx.get_paused()).count();
+    const uint64_t measured_allocations = nof_allocations.load(std::memory_order_relaxed) - allocations
+                                          - ctx.get_paused_allocations();
+    const uint64_t measured_bytes = nof_allocated_bytes.load(std::memory_order_relaxed) - bytes
+                                    - ctx.get_paused_bytes();
+    const double nof_ops = (double)std::max<uint64_t>(ops, 1);
+    std::printf("{\"name\":\"%s\",\"ops\":%llu,\"ns_per_op\":%.2f,\"allocs_per_op\":%.3f,\"bytes_per_op\":%.1f}\n",
+                bench.name.c_str(), (unsigned long long)ops, seconds * 1e9 / nof_ops,
+                (double)measured_allocations / nof_ops, (double)measured_bytes / nof_ops);
+    std::fflush(stdout);
+}
+
+static void print_usage() {
+    std::cerr << "usage: Tichu-bench [--filter TEXT] [--min-time MS] [--list]" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    std::string filter;
+    double min_seconds = 0.5;
+    bool list = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const bool has_value = i + 1 < argc;
+        if (!std::strcmp(argv[i], "--filter") && has_value) {
+            filter = argv[++i];
+        } else if (!std::strcmp(argv[i], "--min-time") && has_value) {
+            min_seconds = std::stod(argv[++i]) / 1000.0;
+        } else if (!std::strcmp(argv[i], "--list")) {
+            list = true;
+        } else {
+            print_usage();
+            return 1;
+        }
+    }
+
+#ifndef __OPTIMIZE__
+    std::cerr << "warning: Tichu-bench was built without optimization, configure with -DCMAKE_BUILD_TYPE=Release"
+              << std::endl;
+#endif
+
+    for (const Bench &bench: get_benches()) {
+        if (bench.name.find(filter) == std::string::npos) { continue; }
+        if (list) {
+            std::printf("%s\n", bench.name.c_str());
+        } else {
+            run_bench(bench, min_seconds);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,70 @@
+/*! \class BenchContext
+    \brief Handed to a benchmark body, lets it exclude its setup from the measurement.
+
+ Benchmarks are registered with TICHU_BENCH(name) and return the number of operations one call of the body
+ performed. The runner calls the body until the minimum time is reached and reports the time and the heap
+ allocations per operation (counted by the replaced global operator new of Tichu-bench). Work between pause and
+ resume is neither timed nor counted. Every workload is generated from fixed seeds, so runs are comparable.
+*/
+
+#ifndef TICHU_BENCH_H
+#define TICHU_BENCH_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+class BenchContext {
+
+private:
+    using clock = std::chrono::steady_clock;
+
+    clock::duration _paused{};
+    uint64_t _paused_allocations = 0;
+    uint64_t _paused_bytes = 0;
+    clock::time_point _pause_start{};
+    uint64_t _pause_allocations = 0;
+    uint64_t _pause_bytes = 0;
+
+public:
+    void pause();
+    void resume();
+
+    [[nodiscard]] clock::duration get_paused() const { return _paused; }
+    [[nodiscard]] uint64_t get_paused_allocations() const { return _paused_allocations; }
+    [[nodiscard]] uint64_t get_paused_bytes() const { return _paused_bytes; }
+};
+
+using BenchBody = std::function<uint64_t(BenchContext &)>;
+
+/**
+ * \brief Registers a benchmark, used by TICHU_BENCH.
+ */
+bool register_bench(const std::string &name, BenchBody body);
+
+/**
+ * \brief Keeps the compiler from optimizing a computed value away.
+ */
+template<typename T>
+inline void do_not_optimize(const T &value) {
+#if defined(_MSC_VER)
+    // MSVC has no inline assembly on x64, a volatile read of the value and a compiler barrier do the same
+    volatile char sink = *reinterpret_cast<const volatile char *>(&value);
+    (void)sink;
+    _ReadWriteBarrier();
+#else
+    asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+#define TICHU_BENCH(name) \
+    static uint64_t bench_##name(BenchContext &ctx); \
+    static const bool bench_##name##_registered = register_bench(#name, bench_##name); \
+    static uint64_t bench_##name(BenchContext &ctx)
+
+
+#endif //TICHU_BENCH_H
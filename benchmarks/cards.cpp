@@ -0,0 +1,143 @@
+#include "bench.h"
+#include "../src/common/game_state/cards/card_combination.h"
+#include "../src/common/game_state/cards/combination_table.h"
+#include "../src/common/game_state/cards/hand_partition.h"
+#include "../src/common/game_state/cards/move_generator.h"
+#include "../src/common/game_state/cards/xoshiro256.h"
+#include "../src/common/game_state/player/hand.h"
+
+#include <optional>
+
+// 64 hands of 14 cards with up to 48 of their possible leads and 16 random subsets each, all from a fixed seed
+struct CardWorkload {
+    std::vector<uint64_t> hands;
+    std::vector<std::vector<Card>> candidates;
+    std::vector<uint64_t> masks;
+    std::vector<CardCombination> combis;
+    std::vector<std::optional<CardCombination>> tops;
+};
+
+static const CardWorkload &get_workload() {
+    static const CardWorkload workload = []() {
+        CardWorkload res;
+        Xoshiro256 rng(0x5EED0001);
+        for (int deal = 0; deal < 64; ++deal) {
+            std::array<uint8_t, card_table::nof_cards> deck;
+            for (int id = 0; id < card_table::nof_cards; ++id) { deck[id] = (uint8_t)id; }
+            uint64_t mask = 0;
+            for (int i = 0; i < 14; ++i) {
+                std::swap(deck[i], deck[i + rng.below(card_table::nof_cards - i)]);
+                mask |= 1ull << deck[i];
+            }
+            res.hands.push_back(mask);
+
+            std::vector<CardCombination> leads = MoveGenerator::get_legal_moves(CardSet(mask), std::nullopt);
+            for (int i = 0; i < 48 && !leads.empty(); ++i) {
+                res.candidates.push_back(leads[rng.below((uint32_t)leads.size())].get_cards());
+            }
+            for (int i = 0; i < 16; ++i) {
+                const int size = 1 + (int)rng.below(8);
+                std::vector<Card> cards;
+                for (int k = 0; k < size; ++k) { cards.push_back(Card::from_id(deck[rng.below(14)])); }
+                res.candidates.push_back(cards);
+            }
+        }
+
+        for (const std::vector<Card> &cards: res.candidates) {
+            res.masks.push_back(CardSet(cards).get_mask());
+            CardCombination combi(cards);
+            if (combi.get_combination_type() == NONE) { continue; }
+            res.combis.push_back(combi);
+        }
+        // every combination is checked against another one of the workload or an empty table
+        for (size_t i = 0; i < res.combis.size(); ++i) {
+            const uint32_t other = rng.below((uint32_t)res.combis.size() + 8);
+            if (other < res.combis.size()) {
+                res.tops.emplace_back(res.combis[other]);
+            } else {
+                res.tops.emplace_back(std::nullopt);
+            }
+        }
+        return res;
+    }();
+    return workload;
+}
+
+TICHU_BENCH(card_combination_construct) {
+    const CardWorkload &workload = get_workload();
+    for (const std::vector<Card> &cards: workload.candidates) {
+        CardCombination combi(cards);
+        do_not_optimize(combi.get_key());
+    }
+    return workload.candidates.size();
+}
+
+TICHU_BENCH(classify_cards) {
+    const CardWorkload &workload = get_workload();
+    for (const std::vector<Card> &cards: workload.candidates) {
+        do_not_optimize(CardCombination::classify_cards(cards));
+    }
+    return workload.candidates.size();
+}
+
+TICHU_BENCH(combination_table_classify) {
+    const CardWorkload &workload = get_workload();
+    for (uint64_t mask: workload.masks) {
+        do_not_optimize(CombinationTable::classify(CardSet(mask)));
+    }
+    return workload.masks.size();
+}
+
+TICHU_BENCH(combination_table_classify_batch) {
+    const CardWorkload &workload = get_workload();
+    static std::vector<uint8_t> types(workload.masks.size());
+    static std::vector<int8_t> ranks(workload.masks.size());
+    static std::vector<uint8_t> lengths(workload.masks.size());
+    CombinationTable::classify_batch(workload.masks.data(), workload.masks.size(), types.data(), ranks.data(),
+                                     lengths.data());
+    do_not_optimize(types.data());
+    return workload.masks.size();
+}
+
+TICHU_BENCH(can_be_played_on) {
+    const CardWorkload &workload = get_workload();
+    std::string err;
+    int allowed = 0;
+    for (size_t i = 0; i < workload.combis.size(); ++i) {
+        allowed += workload.combis[i].can_be_played_on(workload.tops[i], err);
+    }
+    do_not_optimize(allowed);
+    return workload.combis.size();
+}
+
+TICHU_BENCH(hand_partition_solve) {
+    const CardWorkload &workload = get_workload();
+    for (uint64_t mask: workload.hands) {
+        do_not_optimize(HandPartition::solve(CardSet(mask)).size());
+    }
+    return workload.hands.size();
+}
+
+// every card of each hand is removed and added back, one operation is the pair
+TICHU_BENCH(hand_remove_add) {
+    const CardWorkload &workload = get_workload();
+    static std::vector<hand> hands;
+    static std::vector<std::vector<Card>> cards;
+    if (hands.empty()) {
+        for (uint64_t mask: workload.hands) {
+            hands.emplace_back(CardSet(mask));
+            cards.push_back(CardSet(mask).to_vector());
+        }
+    }
+    std::string err;
+    uint64_t ops = 0;
+    for (size_t i = 0; i < hands.size(); ++i) {
+        for (const Card &card: cards[i]) {
+            hands[i].remove_card(card, err);
+            hands[i].add_card(card, err);
+        }
+        ops += cards[i].size();
+    }
+    do_not_optimize(hands.data());
+    return ops;
+}
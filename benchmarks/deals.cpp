@@ -0,0 +1,24 @@
+#include "bench.h"
+#include "../src/stats/deal_statistics.h"
+
+#include <thread>
+
+// one op is one deal: the 8 + 6 cards dealt to four seats and the eight hands classified
+TICHU_BENCH(deal_statistics) {
+    DealStatistics::Settings settings;
+    settings.nof_deals = 256;
+    const DealCounts counts = DealStatistics(settings).run();
+    do_not_optimize(counts.full.bombs);
+    return counts.deals;
+}
+
+// the same deals on all cores, the time per deal against deal_statistics gives the speedup of the threads
+TICHU_BENCH(deal_statistics_all_threads) {
+    DealStatistics::Settings settings;
+    settings.nof_threads = (int)std::max(std::thread::hardware_concurrency(), 1u);
+    settings.nof_deals = 256 * (uint64_t)settings.nof_threads;
+    settings.block_size = 16;
+    const DealCounts counts = DealStatistics(settings).run();
+    do_not_optimize(counts.full.bombs);
+    return counts.deals;
+}
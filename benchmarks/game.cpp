@@ -0,0 +1,246 @@
+#include "bench.h"
+#include "game.h"
+#include "../src/common/game_state/endgame_solver.h"
+#include "../src/common/game_state/game_engine.h"
+#include "../src/common/game_state/ismcts.h"
+#include "../src/common/game_state/swap_optimizer.h"
+#include "../src/common/game_state/tichu_advisor.h"
+#include "../src/common/game_state/cards/move_generator.h"
+#include "../src/common/game_state/cards/xoshiro256.h"
+
+#include <bit>
+
+// a move of a scripted round, either a play (or pass) of a player or the gift of a Dragon trick
+struct ScriptStep {
+    int player;
+    CardCombination combi;
+    int target = -1;
+};
+
+struct ScriptedRound {
+    std::unique_ptr<GameState> game;
+    GameSnapshot start;
+    std::vector<ScriptStep> steps;
+};
+
+static std::vector<player_ptr> start_table(GameState &game, uint64_t seed) {
+    std::string err;
+    game.set_seed(seed);
+    for (int i = 0; i < GameSnapshot::nof_players; ++i) {
+        game.add_player(std::make_shared<Player>("player " + std::to_string(i)), err);
+    }
+    game.start_game(err);
+    std::vector<player_ptr> players = game.get_players();
+    for (const player_ptr &player: players) { game.call_grand_tichu(*player, Tichu::NONE, err); }
+    // the first three cards of each hand are passed on
+    for (const player_ptr &player: players) {
+        std::vector<std::vector<Event>> events(GameSnapshot::nof_players);
+        std::vector<Card> cards = player->get_hand().get_cards();
+        game.swap_cards(*player, {cards.begin(), cards.begin() + 3}, events, err);
+    }
+    return players;
+}
+
+// plays a round with random legal moves and records them, the round ends with the deal of the next one
+static ScriptedRound record_round(uint64_t seed, std::optional<full_state_response> *message = nullptr) {
+    ScriptedRound res;
+    res.game = std::make_unique<GameState>();
+    GameState &game = *res.game;
+    std::vector<player_ptr> players = start_table(game, seed);
+    res.start = game.to_snapshot();
+
+    Xoshiro256 rng(seed);
+    std::string err;
+    std::vector<Event> events;
+    while (game.get_game_phase() == GamePhase::INROUND || game.get_game_phase() == GamePhase::SELECTING) {
+        if (game.get_game_phase() == GamePhase::SELECTING) {
+            const int player = game.get_last_player_idx();
+            const int target = (player + 1) % GameSnapshot::nof_players;
+            game.dragon_selection(*players.at(player), players.at(target)->get_id(), err);
+            res.steps.push_back({player, CardCombination(), target});
+            continue;
+        }
+        const int player = game.get_next_player_idx();
+        std::vector<CardCombination> moves = MoveGenerator::get_legal_moves(players.at(player)->get_hand(),
+                                                                           game.get_active_pile().get_top_combi());
+        const CardCombination &combi = moves.at(rng.below((uint32_t)moves.size()));
+        events.clear();
+        if (!game.play_combi(*players.at(player), combi, events, err)) { break; }
+        res.steps.push_back({player, combi});
+
+        // the state in the middle of the round is the one the messages are measured with
+        if (message && res.steps.size() == 12) { message->emplace(full_state_response{game, events}); }
+    }
+    return res;
+}
+
+static std::vector<ScriptedRound> &get_rounds() {
+    static std::vector<ScriptedRound> rounds = []() {
+        std::vector<ScriptedRound> res;
+        for (uint64_t seed = 1; seed <= 8; ++seed) { res.push_back(record_round(0x5EED0100 + seed)); }
+        return res;
+    }();
+    return rounds;
+}
+
+const full_state_response &get_full_state_workload() {
+    static const full_state_response message = []() {
+        std::optional<full_state_response> res;
+        const ScriptedRound round = record_round(0x5EED0200, &res);
+        return *res;
+    }();
+    return message;
+}
+
+// the recorded rounds replayed on their tables, restoring the start of a round is not measured
+TICHU_BENCH(game_state_play_combi) {
+    std::string err;
+    std::vector<Event> events;
+    uint64_t ops = 0;
+    for (ScriptedRound &round: get_rounds()) {
+        ctx.pause();
+        round.game->restore(round.start, err);
+        const std::vector<player_ptr> &players = round.game->get_players();
+        ctx.resume();
+        for (const ScriptStep &step: round.steps) {
+            events.clear();
+            const bool ok = step.target >= 0
+                            ? round.game->dragon_selection(*players[step.player], players[step.target]->get_id(), err)
+                            : round.game->play_combi(*players[step.player], step.combi, events, err);
+            if (!ok) { throw std::logic_error("the scripted round does not replay: " + err); }
+        }
+        ops += round.steps.size();
+    }
+    return ops;
+}
+
+// random playouts of the same deals on a GameEngine, every move is applied and then taken back
+TICHU_BENCH(game_engine_apply_undo) {
+    struct Playout {
+        GameSnapshot start;
+        std::vector<Move> moves;
+    };
+    static const std::vector<Playout> playouts = []() {
+        std::vector<Playout> res;
+        std::vector<Move> legal;
+        for (const ScriptedRound &round: get_rounds()) {
+            Playout playout{round.start, {}};
+            GameEngine engine(round.start);
+            Xoshiro256 rng(round.start.hash);
+            while (!(engine.get_state().flags & GameSnapshot::round_finished)) {
+                engine.get_legal_moves(engine.get_current_player(), legal);
+                playout.moves.push_back(legal.at(rng.below((uint32_t)legal.size())));
+                engine.apply(playout.moves.back());
+            }
+            res.push_back(playout);
+        }
+        return res;
+    }();
+    static GameEngine engine;
+    static std::vector<UndoRecord> records;
+
+    uint64_t ops = 0;
+    for (const Playout &playout: playouts) {
+        ctx.pause();
+        engine = GameEngine(playout.start);
+        records.resize(playout.moves.size());
+        ctx.resume();
+        for (size_t i = 0; i < playout.moves.size(); ++i) { records[i] = engine.apply(playout.moves[i]); }
+        for (size_t i = playout.moves.size(); i-- > 0;) { engine.undo(records[i]); }
+        ops += playout.moves.size();
+    }
+    do_not_optimize(engine.get_state().hash);
+    return ops;
+}
+
+// the recorded rounds at the point where ten cards are left in the hands, solved with an empty table
+TICHU_BENCH(endgame_solve) {
+    static const std::vector<GameSnapshot> positions = []() {
+        std::vector<GameSnapshot> res;
+        std::vector<Move> legal;
+        for (const ScriptedRound &round: get_rounds()) {
+            GameEngine engine(round.start);
+            Xoshiro256 rng(round.start.hash);
+            while (!(engine.get_state().flags & GameSnapshot::round_finished)) {
+                int nof_cards = 0;
+                for (uint64_t hand: engine.get_state().hands) { nof_cards += std::popcount(hand); }
+                if (nof_cards <= 10) {
+                    res.push_back(engine.get_state());
+                    break;
+                }
+                engine.get_legal_moves(engine.get_current_player(), legal);
+                engine.apply(legal.at(rng.below((uint32_t)legal.size())));
+            }
+        }
+        return res;
+    }();
+    static EndgameSolver solver({1, std::chrono::seconds(60), 1 << 16});
+
+    uint64_t ops = 0;
+    for (const GameSnapshot &position: positions) {
+        ctx.pause();
+        solver.clear();
+        ctx.resume();
+        const EndgameResult res = solver.solve(position);
+        do_not_optimize(res.value);
+        ++ops;
+    }
+    return ops;
+}
+
+// searches of the first position of each recorded round after the swap, one op is one iteration
+TICHU_BENCH(ismcts_iteration) {
+    static const std::vector<GameSnapshot> positions = []() {
+        std::vector<GameSnapshot> res;
+        for (const ScriptedRound &round: get_rounds()) { res.push_back(round.start); }
+        return res;
+    }();
+    IsmctsSearch::Settings settings;
+    settings.budget = std::chrono::milliseconds(0);
+    settings.max_iterations = 100;
+    const IsmctsSearch search(settings);
+
+    uint64_t ops = 0;
+    for (const GameSnapshot &position: positions) {
+        const int observer = GameEngine(position).get_current_player();
+        const IsmctsResult res = search.search(position, observer, CardTracker(position));
+        do_not_optimize(res.move.cards);
+        ops += res.iterations;
+    }
+    return ops;
+}
+
+// Grand Tichu advices on the first 8 cards of each seat of the recorded rounds, one op is one sampled round
+TICHU_BENCH(tichu_advice_sample) {
+    TichuAdvisor::Settings settings;
+    settings.budget = std::chrono::milliseconds(0);
+    settings.max_samples = 20;
+    const TichuAdvisor advisor(settings);
+
+    uint64_t ops = 0;
+    for (const ScriptedRound &round: get_rounds()) {
+        for (uint64_t hand: round.start.hands) {
+            // the 8 cards of the hand with the lowest ids stand in for the first cards dealt
+            uint64_t first_cards = hand;
+            while (std::popcount(first_cards) > 8) { first_cards &= ~std::bit_floor(first_cards); }
+            const TichuAdvice res = advisor.advise(CardSet(first_cards), Tichu::GRAND_TICHU);
+            do_not_optimize(res.probability);
+            ops += res.samples;
+        }
+    }
+    return ops;
+}
+
+// swaps of the hands of the recorded rounds, one op is one choice on one thread
+TICHU_BENCH(swap_choose) {
+    const SwapOptimizer optimizer({});
+    uint64_t ops = 0;
+    for (const ScriptedRound &round: get_rounds()) {
+        for (uint64_t hand: round.start.hands) {
+            const SwapChoice res = optimizer.choose(CardSet(hand));
+            do_not_optimize(res.cards[0]);
+            ++ops;
+        }
+    }
+    return ops;
+}
@@ -0,0 +1,12 @@
+#ifndef TICHU_BENCH_GAME_H
+#define TICHU_BENCH_GAME_H
+
+#include "../src/common/messages.h"
+
+/**
+ * \brief The full state message of a table in the middle of a scripted round, with the events of the last play.
+ */
+const full_state_response &get_full_state_workload();
+
+
+#endif //TICHU_BENCH_GAME_H
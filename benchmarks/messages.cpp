@@ -0,0 +1,32 @@
+#include "bench.h"
+#include "game.h"
+
+#include <nlohmann/json.hpp>
+
+// the way the server sends a message and the client reads it: to_json, dump, parse and from_json
+template<typename T>
+static void round_trip(const T &send, T &receive) {
+    json data;
+    to_json(data, send);
+    const std::string msg = data.dump();
+    from_json(json::parse(msg), receive);
+}
+
+TICHU_BENCH(json_full_state_response) {
+    static const ServerMsg send(get_full_state_workload());
+    ServerMsg receive;
+    round_trip(send, receive);
+    do_not_optimize(receive.get_type());
+    return 1;
+}
+
+TICHU_BENCH(json_client_msg_play_combi) {
+    static const ClientMsg send(UUID("4f5e8b61-52d3-4c5e-9a0b-6a1d2c3e4f50"),
+                                play_combi_req{CardCombination(std::vector<Card>{Card(7, GREEN), Card(7, BLUE),
+                                                                                 Card(8, RED), Card(8, SCHWARZ)}),
+                                               std::nullopt});
+    ClientMsg receive;
+    round_trip(send, receive);
+    do_not_optimize(receive.get_type());
+    return 1;
+}
@@ -0,0 +1,107 @@
+#include <atomic>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <sockpp/tcp_connector.h>
+#include "../common/bot_player.h"
+#include "../common/listener.h"
+
+static void print_usage() {
+    std::cerr << "usage: Tichu-bot [--host HOST] [--port N] [--name NAME] [--team 0|1|2] [--threads N]"
+              << " [--budget MS] [--iterations N] [--start]" << std::endl;
+}
+
+// the framing of TichuGame::send_message: the length as hexadecimal int, a colon and the json
+static void send_message(sockpp::tcp_connector &connection, const ClientMsg &msg) {
+    json data;
+    to_json(data, msg);
+    const std::string msg_str = data.dump();
+    std::stringstream ss;
+    ss << std::setfill('0') << std::setw(sizeof(int) * 2) << std::hex << (int)msg_str.size() << ':' << msg_str;
+    connection.write(ss.str());
+}
+
+static ServerMsg parse_message(const std::string &msg) {
+    ServerMsg server_msg;
+    from_json(json::parse(msg), server_msg);
+    return server_msg;
+}
+
+int main(int argc, char *argv[]) {
+    std::string host = "127.0.0.1";
+    uint16_t port = 50505;
+    std::string name = "bot";
+    int team = 0;
+    bool start = false;
+    IsmctsSearch::Settings settings;
+    settings.nof_threads = (int)std::max(std::thread::hardware_concurrency(), 1u);
+
+    for (int i = 1; i < argc; ++i) {
+        const bool has_value = i + 1 < argc;
+        if (!std::strcmp(argv[i], "--host") && has_value) {
+            host = argv[++i];
+        } else if (!std::strcmp(argv[i], "--port") && has_value) {
+            port = (uint16_t)std::stoi(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--name") && has_value) {
+            name = argv[++i];
+        } else if (!std::strcmp(argv[i], "--team") && has_value) {
+            team = std::stoi(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--threads") && has_value) {
+            settings.nof_threads = std::stoi(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--budget") && has_value) {
+            settings.budget = std::chrono::milliseconds(std::stoll(argv[++i]));
+        } else if (!std::strcmp(argv[i], "--iterations") && has_value) {
+            settings.max_iterations = std::stoull(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--start")) {
+            start = true;
+        } else {
+            print_usage();
+            return 1;
+        }
+    }
+
+    sockpp::socket_initializer::initialize();
+    sockpp::tcp_connector connection;
+    if (!connection.connect(sockpp::inet_address(host, port))) {
+        std::cerr << "failed to connect to " << host << ":" << port << std::endl;
+        return 1;
+    }
+
+    BotPlayer bot(name, team, settings);
+    MessageQueue<ServerMsg> messages;
+    std::atomic<bool> connected{true};
+    std::thread listener([&, socket = connection.clone()]() mutable {
+        tcp_listener<ServerMsg>(std::move(socket), parse_message, &messages);
+        connected = false;
+    });
+    send_message(connection, bot.join());
+
+    bool sent_start = false;
+    while (connected) {
+        std::optional<ServerMsg> msg = messages.try_pop();
+        if (!msg) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            continue;
+        }
+        if (std::optional<ClientMsg> request = bot.process(*msg)) { send_message(connection, *request); }
+
+        const std::optional<GameState> &state = bot.get_state();
+        if (!state) { continue; }
+        // with --start the bot starts the game as soon as the table is full
+        if (start && !sent_start && state->get_game_phase() == PREGAME && state->is_full()) {
+            send_message(connection, ClientMsg(bot.get_id(), start_game_req{}));
+            sent_start = true;
+        }
+        if (state->get_game_phase() == POSTGAME) {
+            std::cout << "game over, team A " << state->get_score_team_A() << ", team B "
+                      << state->get_score_team_B() << std::endl;
+            break;
+        }
+    }
+
+    connection.shutdown();
+    listener.join();
+    return 0;
+}
@@ -4,6 +4,8 @@
 #include <map>
 #include <deque>
 #include <chrono>
+#include <cmath>
+#include <thread>
 
 #include "Renderer/application.h"
 #include "Renderer/imgui_build.h"
@@ -422,8 +424,9 @@ namespace GamePanel
         }
 
         auto player = data->game_state.get_players().at(player_index);
-        auto &hand = player->get_hand();
-        int n_cards = hand.get_nof_cards();
+        // the hand is iterated in place, the renderer does not copy it every frame
+        const CardSet &cards = player->get_hand().get_card_set();
+        int n_cards = (int)cards.size();
 
         const float hover_height = .05f;
 
@@ -453,10 +456,11 @@ namespace GamePanel
 
         // check if any card is hovered
         bool hovered_any = false;
-        for (int i = 0; i < n_cards; i++)
+        auto card_it = cards.begin();
+        for (int i = 0; i < n_cards; i++, ++card_it)
         {
 
-            auto &card = hand.get_cards().at(i);
+            const Card card = *card_it;
 
             float card_begin = positions.at(i).x;
             float card_end = card_begin + card_size.x;
@@ -483,8 +487,9 @@ namespace GamePanel
                         data->selected_cards.insert(card);
                         if (card == ONE) data->selected_majong = true;
                     }
-                    auto combi = CardCombination({data->selected_cards.begin(), data->selected_cards.end()});
-                    data->can_play_bomb = combi.get_combination_type() == BOMB;
+                    // the hand tracks its bombs, the selection only has to be checked against them
+                    data->can_play_bomb = player->get_hand().is_bomb(
+                            CardSet({data->selected_cards.begin(), data->selected_cards.end()}));
                 }
 
                 break;
@@ -515,12 +520,13 @@ namespace GamePanel
         }
 
         // draw all cards except hovered card
-        for (int i = 0; i < n_cards; i++)
+        card_it = cards.begin();
+        for (int i = 0; i < n_cards; i++, ++card_it)
         {
             if (i == current_hover)
                 continue;
             auto pos = positions.at(i);
-            auto &card = hand.get_cards().at(i);
+            const Card card = *card_it;
             draw_card(pos, card_size, card, 0, data->selected_cards.contains(card));
         }
 
@@ -529,7 +535,7 @@ namespace GamePanel
         const float d_angle = hover_angle * 2.f / (float)n_cards;
         if (current_hover != -1)
         {
-            auto &card = hand.get_cards().at(current_hover);
+            const Card card = cards.nth(current_hover);
             auto pos = positions.at(current_hover);
             draw_card(pos, card_size, card, hover_angle - d_angle * (float)current_hover, data->selected_cards.contains(card));
         }
@@ -948,7 +954,7 @@ namespace GamePanel
         ImGui::SetNextWindowSize({card_size.x * x + padding.x * 2.f + 1, card_size.y * y + padding.y * 2 + 1}, ImGuiCond_Once);
     }
 
-    void show_selectable_card_grid(const char *label, const std::vector<Card> &cards, SelectionData *data, std::vector<bool> filter)
+    void show_selectable_card_grid(const char *label, const std::vector<Card> &cards, SelectionData *data, const std::vector<bool> &filter)
     {
         auto card_size = imgui_card_size();
         const ImVec2 select_pad = {5.f, 5.f};
@@ -1156,7 +1162,7 @@ namespace GamePanel
         ImGui::SetNextWindowSize({card_size.x * 4 + win_padding * 2 + 1, 0}, ImGuiCond_Once);
         ImGui::Begin("Grand Tichu", nullptr, ImGuiWindowFlags_NoCollapse);
 
-        auto &cards = data->game_state.get_players().at(data->my_index)->get_hand().get_cards();
+        const CardSet &cards = data->game_state.get_players().at(data->my_index)->get_hand().get_card_set();
         if (cards.size() < 8)
         {
             WARN("could not find 8 cards in players hand");
@@ -1166,6 +1172,36 @@ namespace GamePanel
         //     ImGui::Image(get_card_texture(cards[i]), imgui_card_size());
         // });
 
+        // the advice is computed once per hand, it takes about 20 ms on all cores but one and is not waited for in
+        // the frame. The advice of a hand that changed meanwhile is dropped, the next one starts when it is done
+        auto &task = data->grand_tichu_advice_task;
+        if (task && task->done.load(std::memory_order_acquire))
+        {
+            if (task->hand == cards.get_mask())
+                data->grand_tichu_advice = task->advice;
+            task.reset();
+        }
+        if (!task && cards.size() >= 8 && data->grand_tichu_advice_hand != cards.get_mask())
+        {
+            data->grand_tichu_advice.reset();
+            data->grand_tichu_advice_hand = cards.get_mask();
+            task = std::make_shared<AdviceTask>();
+            task->hand = cards.get_mask();
+            std::thread([task]() {
+                TichuAdvisor::Settings settings;
+                // one core is left to the renderer
+                settings.nof_threads = (int)std::max(std::thread::hardware_concurrency(), 2u) - 1;
+                task->advice = TichuAdvisor(settings).advise(CardSet(task->hand), Tichu::GRAND_TICHU);
+                task->done.store(true, std::memory_order_release);
+            }).detach();
+        }
+        if (data->grand_tichu_advice)
+        {
+            ImGui::TextWrapped("chance to go out first: %d%%, %+d points on average",
+                               (int)std::lround(data->grand_tichu_advice->probability * 100),
+                               (int)std::lround(data->grand_tichu_advice->expected_delta));
+        }
+
         if (!data->wait_for_others_grand_tichu)
         {
             auto style = ImGui::ScopedStyle{};
@@ -1217,7 +1253,8 @@ namespace GamePanel
         bool filled_selection = n_total_selections == 3;
         float button_height = ImGui::GetFontSize() * 2.f;
 
-        auto cards = players.at(data->my_index)->get_hand().get_cards();
+        players.at(data->my_index)->get_hand().get_cards(data->swap_hand);
+        const auto &cards = data->swap_hand;
 
         ImGui::PushStyleColor(ImGuiCol_WindowBg, 0);
         ImGui::BeginTabBar("players");
@@ -2,9 +2,12 @@
 #ifndef TICHU_GAME_PANEL_H
 #define TICHU_GAME_PANEL_H
 
+#include <atomic>
+#include <memory>
 #include <set>
 
 #include "../common/messages.h"
+#include "../common/game_state/tichu_advisor.h"
 #include <sstream>
 
 namespace GamePanel {
@@ -19,6 +22,18 @@ namespace GamePanel {
         std::deque<int> selected{};
     };
 
+    /**
+     * \brief The Grand Tichu advice of a hand, computed on a detached thread that publishes it here.
+     *
+     * The thread shares the task with the GamePanel, so neither the frame nor the destruction of Data waits for it.
+    */
+    struct AdviceTask {
+        uint64_t hand{};
+        std::optional<TichuAdvice> advice{};
+        /** set after advice is written */
+        std::atomic<bool> done{false};
+    };
+
     /**
      * \brief input / output for the GamePanel 
      * 
@@ -47,6 +62,9 @@ namespace GamePanel {
         */  
         std::array<SelectionData, 3> swap_window_data{};
 
+        /** the hand shown in the swap window, refilled every frame into the same buffer */
+        std::vector<Card> swap_hand{};
+
         /** store cards to be swapped at the beginning*/
         std::array<Card, 3> cards_for_swapping{};
 
@@ -68,6 +86,12 @@ namespace GamePanel {
         bool wait_for_others_grand_tichu = false;
         bool wait_for_others_swap = false;
 
+        /** the Grand Tichu advice shown on the pre round screen and the card mask of the hand it was made for */
+        std::optional<TichuAdvice> grand_tichu_advice{};
+        uint64_t grand_tichu_advice_hand{};
+        /** the advice being computed, a new one is only started once it is done */
+        std::shared_ptr<AdviceTask> grand_tichu_advice_task{};
+
         // read only
         std::optional<UUID> player_id{};
         GameState game_state{};
@@ -0,0 +1,192 @@
+#include "bot_player.h"
+
+#include <algorithm>
+#include "game_state/cards/move_generator.h"
+
+// the budget of a Tichu advice, the calls are answered within the time a human takes to look at the cards
+static constexpr std::chrono::milliseconds advice_budget{20};
+
+// the parts of a position that change with every answer of the seat, a state with the same key asks the same
+static uint64_t decision_key(const GameSnapshot &state, int seat) {
+    uint64_t res = state.hands[seat] * 0x9E3779B97F4A7C15ull;
+    // the calls and the swap are answered once per phase, whatever the other seats do meanwhile
+    if (state.phase == PREROUND || state.phase == SWAPPING) { return res ^ state.phase; }
+    res ^= (state.trick + state.top_key) * 0xC2B2AE3D27D4EB4Full;
+    res ^= (uint64_t)state.phase | ((uint64_t)state.next << 8) | ((uint64_t)state.last << 16)
+           | ((uint64_t)state.skipped << 24) | ((uint64_t)state.wish << 32);
+    return res;
+}
+
+// true if the state waits for an answer of the seat
+static bool is_asked(const GameSnapshot &state, int seat) {
+    switch (state.phase) {
+        case PREROUND:
+        case SWAPPING:
+            return !(state.responded & (1u << seat));
+        case INROUND:
+        case SELECTING:
+            return !(state.flags & GameSnapshot::round_finished) && GameEngine(state).get_current_player() == seat;
+        default:
+            return false;
+    }
+}
+
+static ClientMsg to_request(const UUID &id, const GameState &state, const Move &move) {
+    switch (move.type) {
+        case MoveType::PLAY: {
+            std::optional<Card> wish;
+            if (move.wish) { wish = Card(move.wish, SCHWARZ); }
+            return ClientMsg(id, play_combi_req{CardCombination(CardSet(move.cards).to_vector()), wish});
+        }
+        case MoveType::GIFT:
+            return ClientMsg(id, dragon_req{state.get_players().at(move.target)->get_id()});
+        default:
+            return ClientMsg(id, play_combi_req{});
+    }
+}
+
+static TichuAdvisor::Settings advisor_settings(const IsmctsSearch::Settings &settings) {
+    TichuAdvisor::Settings res;
+    res.nof_threads = settings.nof_threads;
+    res.budget = advice_budget;
+    res.seed = settings.seed;
+    return res;
+}
+
+static SwapOptimizer::Settings swapper_settings(const IsmctsSearch::Settings &settings) {
+    SwapOptimizer::Settings res;
+    res.nof_threads = settings.nof_threads;
+    res.seed = settings.seed;
+    return res;
+}
+
+BotPlayer::BotPlayer(std::string name, int team, const IsmctsSearch::Settings &settings)
+        : BotPlayer(UUID::create(), std::move(name), team, settings) {}
+
+BotPlayer::BotPlayer(UUID id, std::string name, int team, const IsmctsSearch::Settings &settings)
+        : _id(std::move(id)), _name(std::move(name)), _team(team), _search(settings),
+          _advisor(advisor_settings(settings)), _swapper(swapper_settings(settings)) {}
+
+ClientMsg BotPlayer::join() const {
+    return ClientMsg(_id, join_game_req{_name, _team});
+}
+
+std::optional<ClientMsg> BotPlayer::process(const ServerMsg &msg) {
+    switch (msg.get_type()) {
+        case ServerMsgType::full_state:
+            return process(msg.get_msg_data<full_state_response>());
+
+        case ServerMsgType::req_response:
+            // the server rejected a request, if the last state still waits for the bot the fallback is sent once
+            if (_state && _answered && !_sent_fallback) {
+                _sent_fallback = true;
+                return fallback(*_state);
+            }
+            return {};
+
+        default:
+            return {};
+    }
+}
+
+void BotPlayer::observe(const full_state_response &data) {
+    const GameState &state = data.state;
+    const int seat = state.get_player_index(_id);
+    // a bot taking over a seat during a round starts from the cards played so far
+    if (!_state && seat >= 0 && seat < GameSnapshot::nof_players && state.get_game_phase() != PREGAME) {
+        _tracker = CardTracker(state.to_snapshot());
+    }
+    _state = state;
+    if (seat < 0 || seat >= GameSnapshot::nof_players) { return; }
+
+    for (const Event &event: data.events) { _tracker.apply(seat, event, state); }
+    _tracker.add_hand(seat, state.get_players().at(seat)->get_hand().get_card_set());
+}
+
+std::optional<ClientMsg> BotPlayer::process(const full_state_response &data) {
+    observe(data);
+    const GameState &state = data.state;
+    const int seat = state.get_player_index(_id);
+    if (seat < 0 || seat >= GameSnapshot::nof_players) { return {}; }
+
+    const uint64_t key = decision_key(state.to_snapshot(), seat);
+    if (_answered == key) { return {}; }
+    // the Tichu is called before the first move, the state sent after the call asks for the move again
+    if (std::optional<ClientMsg> call = consider_tichu(state, seat)) { return call; }
+    std::optional<ClientMsg> res = decide(state);
+    if (res) {
+        _answered = key;
+        _sent_fallback = false;
+    }
+    return res;
+}
+
+std::optional<ClientMsg> BotPlayer::decide(const GameState &state) const {
+    const int seat = state.get_player_index(_id);
+    if (seat < 0 || !state.is_full()) { return {}; }
+    const GameSnapshot view = state.to_snapshot();
+    if (!is_asked(view, seat)) { return {}; }
+
+    switch (state.get_game_phase()) {
+        case PREROUND: {
+            const TichuAdvice advice = _advisor.advise(view.get_hand(seat), Tichu::GRAND_TICHU);
+            return ClientMsg(_id, grand_tichu_req{TichuAdvisor::should_call(advice) ? Tichu::GRAND_TICHU : Tichu::NONE});
+        }
+
+        case SWAPPING: {
+            const std::array<Card, 3> cards = _swapper.choose(view.get_hand(seat)).cards;
+            return ClientMsg(_id, swap_req{{cards.begin(), cards.end()}});
+        }
+
+        default:
+            return to_request(_id, state, _search.search(view, seat, _tracker).move);
+    }
+}
+
+std::optional<ClientMsg> BotPlayer::consider_tichu(const GameState &state, int seat) {
+    if (state.get_game_phase() == PREROUND) { _considered_tichu = false; }
+    if (_considered_tichu || state.get_game_phase() != INROUND || !state.is_full()) { return {}; }
+    const Player &player = *state.get_players().at(seat);
+    const GameSnapshot view = state.to_snapshot();
+    if (player.get_tichu() != Tichu::NONE || player.get_nof_cards() != 14 || !is_asked(view, seat)) { return {}; }
+
+    _considered_tichu = true;
+    const TichuAdvice advice = _advisor.advise(view.get_hand(seat), Tichu::TICHU, true);
+    if (!TichuAdvisor::should_call(advice)) { return {}; }
+    return ClientMsg(_id, small_tichu_req{Tichu::TICHU});
+}
+
+std::optional<ClientMsg> BotPlayer::fallback(const GameState &state) const {
+    const int seat = state.get_player_index(_id);
+    if (seat < 0 || !state.is_full() || !is_asked(state.to_snapshot(), seat)) { return {}; }
+    const hand &cards = state.get_players().at(seat)->get_hand();
+
+    switch (state.get_game_phase()) {
+        case PREROUND:
+            return ClientMsg(_id, grand_tichu_req{Tichu::NONE});
+
+        case SWAPPING: {
+            const std::vector<Card> hand_cards = cards.get_card_set().to_vector();
+            if (hand_cards.size() < 3) { return {}; }
+            return ClientMsg(_id, swap_req{{hand_cards.begin(), hand_cards.begin() + 3}});
+        }
+
+        case INROUND: {
+            // a pass if it is allowed, the first legal combination otherwise
+            const std::vector<CardCombination> moves = MoveGenerator::get_legal_moves(
+                    cards, state.get_active_pile().get_top_combi(), state.get_wish());
+            if (moves.empty()) { return {}; }
+            auto pass = std::find_if(moves.begin(), moves.end(),
+                                     [](const CardCombination &combi) { return combi.get_combination_type() == PASS; });
+            return ClientMsg(_id, play_combi_req{pass != moves.end() ? *pass : moves.front(), {}});
+        }
+
+        case SELECTING: {
+            const player_ptr &next = state.get_players().at((seat + 1) % GameSnapshot::nof_players);
+            return ClientMsg(_id, dragon_req{next->get_id()});
+        }
+
+        default:
+            return {};
+    }
+}
@@ -0,0 +1,99 @@
+/*! \class BotPlayer
+    \brief A computer player that takes part in a game through the same messages as a human client.
+
+ The bot joins with a join_game ClientMsg and answers every full_state_response that asks something of its seat:
+ the Grand Tichu call (grand_tichu_req), the swap (swap_req), its turn in a trick (play_combi_req) and the gift of
+ a Dragon trick (dragon_req). The moves of a trick and the gift are chosen with an IsmctsSearch, the bot sees no
+ other hand than its own: the events of each response update a CardTracker, which restricts the hands the search
+ deals to the other seats. A TichuAdvisor decides on the Grand Tichu and, the first time the bot is asked to play
+ in a round, on a Tichu (small_tichu_req). The cards to swap are chosen by a SwapOptimizer. The bot plays no bombs
+ out of turn.
+
+ The bot is not tied to a transport: process takes the ServerMsg received and returns the ClientMsg to send, if
+ any. Each position is answered once, a request the server rejects is followed by a plain fallback request.
+*/
+
+#ifndef TICHU_BOT_PLAYER_H
+#define TICHU_BOT_PLAYER_H
+
+#include <optional>
+#include <string>
+#include "messages.h"
+#include "game_state/card_tracker.h"
+#include "game_state/ismcts.h"
+#include "game_state/swap_optimizer.h"
+#include "game_state/tichu_advisor.h"
+
+class BotPlayer {
+
+private:
+    UUID _id;
+    std::string _name;
+    int _team;
+    IsmctsSearch _search;
+    TichuAdvisor _advisor;
+    SwapOptimizer _swapper;
+    CardTracker _tracker;
+    std::optional<GameState> _state;
+    // the position the last request was sent for, see decision_key
+    std::optional<uint64_t> _answered;
+    bool _sent_fallback = false;
+    // whether the Tichu call of the round was considered
+    bool _considered_tichu = false;
+
+    [[nodiscard]] std::optional<ClientMsg> fallback(const GameState &state) const;
+
+    std::optional<ClientMsg> consider_tichu(const GameState &state, int seat);
+
+public:
+    /**
+     * \brief A bot with a new id, team is the team asked for in join_game_req (0 for any). The Tichu calls and the
+     * swap use the threads and the seed of the search settings.
+     */
+    BotPlayer(std::string name, int team, const IsmctsSearch::Settings &settings);
+
+    /**
+     * \brief A bot playing as the player with the id, for a seat taken over from another player.
+     */
+    BotPlayer(UUID id, std::string name, int team, const IsmctsSearch::Settings &settings);
+
+    [[nodiscard]] const UUID &get_id() const { return _id; }
+
+    [[nodiscard]] const std::string &get_name() const { return _name; }
+
+    /**
+     * \brief The last state the server sent, empty before the bot joined a game.
+     */
+    [[nodiscard]] const std::optional<GameState> &get_state() const { return _state; }
+
+    /**
+     * \brief The request to join a game.
+     */
+    [[nodiscard]] ClientMsg join() const;
+
+    /**
+     * \brief Takes in a message of the server and returns the request to answer it with.
+     */
+    std::optional<ClientMsg> process(const ServerMsg &msg);
+
+    /**
+     * \brief Updates the bot with a state of the game without answering it, for states already followed by newer
+     * ones.
+     */
+    void observe(const full_state_response &data);
+
+    /**
+     * \brief Updates the bot with a state of the game and returns its request if the state asks for one and was
+     * not answered before.
+     */
+    std::optional<ClientMsg> process(const full_state_response &data);
+
+    /**
+     * \brief The request of the bot in the state, whether answered before or not. Empty if nothing is asked of
+     * its seat.
+     */
+    [[nodiscard]] std::optional<ClientMsg> decide(const GameState &state) const;
+};
+
+
+#endif //TICHU_BOT_PLAYER_H
@@ -0,0 +1,148 @@
+#include "card_tracker.h"
+
+#include "game_state.h"
+#include "../event.h"
+
+// true if a card of the wished rank could be played on the top combination, so a seat holding one had to
+static bool wish_is_playable(uint32_t top_key, int wish) {
+    if (!wish) { return false; }
+    if (!top_key) { return true; }
+    const int type = (int)(top_key >> 16);
+    const int rank = (int)(top_key & 0xFF) - 1;
+    return type == MAJONG || (type == SINGLE && rank < wish);
+}
+
+static uint64_t rank_cards(int rank) {
+    return 0xFull << ((rank - 1) * card_table::nof_suits);
+}
+
+CardTracker::CardTracker(const GameSnapshot &state) {
+    _played = state.trick;
+    for (int seat = 0; seat < nof_players; ++seat) {
+        _played |= state.won[seat];
+        _seen[seat] = state.hands[seat];
+    }
+}
+
+void CardTracker::reset() {
+    *this = CardTracker();
+}
+
+void CardTracker::receive_swapped_cards() {
+    for (int seat = 0; seat < nof_players; ++seat) {
+        _seen[seat] |= _incoming[seat];
+        _incoming[seat] = 0;
+    }
+}
+
+void CardTracker::add_hand(int seat, const CardSet &cards) {
+    _seen[seat] |= cards.get_mask();
+}
+
+void CardTracker::add_swap(int from, int to, Card card) {
+    const uint64_t mask = CardSet(card).get_mask();
+    _seen[from] |= mask;
+    _given[from][to] |= mask;
+    _incoming[to] |= mask;
+}
+
+void CardTracker::add_play(int seat, const CardSet &cards, uint32_t top_key, int wish) {
+    receive_swapped_cards();
+    const uint64_t mask = cards.get_mask();
+    _played |= mask;
+    for (int from = 0; from < nof_players; ++from) { _given[from][seat] &= ~mask; }
+    if (wish_is_playable(top_key, wish) && cards.count_rank(wish) == 0) { _excluded[seat] |= rank_cards(wish); }
+}
+
+void CardTracker::add_pass(int seat, uint32_t top_key, int wish) {
+    receive_swapped_cards();
+    if (top_key && wish_is_playable(top_key, wish)) { _excluded[seat] |= rank_cards(wish); }
+}
+
+void CardTracker::apply(const GameSnapshot &before, const Move &move) {
+    switch (move.type) {
+        case MoveType::PLAY: {
+            // only the seat whose turn it is has to fulfill the wish, a bomb out of turn tells nothing
+            const bool in_turn = move.player == before.next;
+            add_play(move.player, CardSet(move.cards), in_turn ? before.top_key : 0, in_turn ? before.wish : 0);
+            break;
+        }
+        case MoveType::PASS:
+            add_pass(move.player, before.top_key, before.wish);
+            break;
+        case MoveType::GIFT:
+            receive_swapped_cards();
+            break;
+        case MoveType::SWAP:
+            for (int i = 0; i < nof_players - 1; ++i) {
+                add_swap(move.player, (move.player + 1 + i) % nof_players, Card::from_id(move.swap[i]));
+            }
+            // the cards are exchanged once all four seats have handed in theirs
+            if ((before.responded | (1u << move.player)) == (1u << nof_players) - 1) { receive_swapped_cards(); }
+            break;
+    }
+}
+
+void CardTracker::apply(int observer, const Event &event, const GameState &state) {
+    const int seat = event.player_id ? state.get_player_index(*event.player_id) : -1;
+    switch (event.event_type) {
+        case EventType::ROUND_END:
+            reset();
+            break;
+
+        case EventType::SWAP_OUT:
+            if (seat >= 0 && event.card) { add_swap(observer, seat, *event.card); }
+            break;
+
+        case EventType::SWAP_IN:
+            if (event.card) { add_hand(observer, CardSet(*event.card)); }
+            break;
+
+        // the Majong is announced with its wish
+        case EventType::PLAY_COMBI:
+        case EventType::BOMB:
+        case EventType::SWITCH:
+        case EventType::WISH: {
+            // the cards that became public with the play: the trick and the won cards of all players
+            uint64_t open = 0;
+            for (const CardCombination &combi: state.get_active_pile().get_pile()) {
+                open |= CardSet(combi.get_cards()).get_mask();
+            }
+            for (const player_ptr &player: state.get_players()) {
+                open |= player->get_won_cards().get_card_set().get_mask();
+            }
+            if (seat >= 0) { add_play(seat, CardSet(open & ~_played)); }
+            break;
+        }
+
+        case EventType::PASS: {
+            // a pass that ended the trick leaves no top combination to look at
+            const std::optional<CardCombination> top = state.get_active_pile().get_top_combi();
+            const std::optional<Card> &wish = state.get_wish();
+            if (seat >= 0 && top && wish) { add_pass(seat, top->get_key(), wish->get_rank()); }
+            break;
+        }
+
+        default:
+            break;
+    }
+
+    // the observer sees its own hand with every update
+    const int nof_seats = (int)state.get_players().size();
+    if (observer < nof_seats) { add_hand(observer, state.get_players().at(observer)->get_hand().get_card_set()); }
+}
+
+CardSet CardTracker::get_hand(int observer) const {
+    uint64_t given = 0;
+    for (int seat = 0; seat < nof_players; ++seat) { given |= _given[observer][seat]; }
+    return CardSet(_seen[observer] & ~given & ~_played);
+}
+
+CardSet CardTracker::get_out(int observer) const {
+    return CardSet::full_deck() - get_hand(observer) - CardSet(_played);
+}
+
+CardSet CardTracker::get_candidates(int observer, int seat) const {
+    if (seat == observer) { return get_hand(observer); }
+    return (get_unseen(observer) - CardSet(_excluded[seat])) | get_known(observer, seat);
+}
@@ -0,0 +1,133 @@
+/*! \class CardTracker
+    \brief Keeps track of the cards each seat has not seen yet in the current round.
+
+ Every seat has seen the cards it was dealt or received in the swap and every card played to the ActivePile. The
+ cards a seat passed on in the swap are known to be in the receiving hand until they are played. Passes tell
+ something as well: a seat that passes while a wish is active and a card of the wished rank would beat the top
+ combination holds no card of that rank.
+
+ The tracker is updated move by move, either with the moves of a GameEngine (all four seats at once) or with the
+ Event stream a client receives with its full_state_response (the seat of that client). Queries are answered from
+ a handful of card masks, bots sampling the hidden hands ask them at every decision.
+*/
+
+#ifndef TICHU_CARD_TRACKER_H
+#define TICHU_CARD_TRACKER_H
+
+#include <array>
+#include <cstdint>
+#include "game_snapshot.h"
+#include "game_engine.h"
+#include "cards/card_set.h"
+
+class GameState;
+struct Event;
+
+class CardTracker {
+
+private:
+    static constexpr int nof_players = GameSnapshot::nof_players;
+
+    // cards played this round, everyone has seen them
+    uint64_t _played = 0;
+    // cards each seat has held this round
+    std::array<uint64_t, nof_players> _seen{};
+    // _given[from][to]: cards seat 'from' passed to seat 'to' in the swap and 'to' has not played yet
+    std::array<std::array<uint64_t, nof_players>, nof_players> _given{};
+    // cards of the swap that have not arrived yet, they are added to the seen cards with the first play
+    std::array<uint64_t, nof_players> _incoming{};
+    // cards a seat can not hold, from the wishes it did not fulfill
+    std::array<uint64_t, nof_players> _excluded{};
+
+    void receive_swapped_cards();
+
+public:
+    CardTracker() = default;
+
+    /**
+     * \brief Starts from a position, every seat has seen its hand and the cards already played.
+     */
+    explicit CardTracker(const GameSnapshot &state);
+
+    /**
+     * \brief Forgets everything, for the deal of a new round.
+     */
+    void reset();
+
+    /**
+     * \brief The seat has seen these cards of its own hand (the deal, or cards received in the swap).
+     */
+    void add_hand(int seat, const CardSet &cards);
+
+    /**
+     * \brief The seat 'from' passes a card to the seat 'to', the card arrives with the first play of the round.
+     */
+    void add_swap(int from, int to, Card card);
+
+    /**
+     * \brief The seat plays the cards, top_key and wish describe the trick and the wish before the play.
+     */
+    void add_play(int seat, const CardSet &cards, uint32_t top_key = 0, int wish = 0);
+
+    /**
+     * \brief The seat passes on the top combination (CardCombination::get_key()) while the wish is active.
+     */
+    void add_pass(int seat, uint32_t top_key, int wish);
+
+    /**
+     * \brief Updates all seats with a move of the GameEngine, before is the state the move is applied to.
+     */
+    void apply(const GameSnapshot &before, const Move &move);
+
+    /**
+     * \brief Updates the seat of a client with an event of a full_state_response, state is the state sent along.
+     */
+    void apply(int observer, const Event &event, const GameState &state);
+
+// queries
+    /**
+     * \brief The cards the observer has neither held nor seen played.
+     */
+    [[nodiscard]] CardSet get_unseen(int observer) const {
+        return CardSet::full_deck() - CardSet(_seen[observer] | _played);
+    }
+
+    /**
+     * \brief The cards in the hand of the observer, as far as the tracker was told.
+     */
+    [[nodiscard]] CardSet get_hand(int observer) const;
+
+    /**
+     * \brief The cards still out from the view of the observer: all cards in the hands of the other seats.
+     */
+    [[nodiscard]] CardSet get_out(int observer) const;
+
+    /**
+     * \brief The cards the seat may hold from the view of the observer.
+     */
+    [[nodiscard]] CardSet get_candidates(int observer, int seat) const;
+
+    /**
+     * \brief The cards the seat is known to hold from the view of the observer, passed to it in the swap.
+     */
+    [[nodiscard]] CardSet get_known(int observer, int seat) const { return CardSet(_given[observer][seat]); }
+
+    [[nodiscard]] CardSet get_played() const { return CardSet(_played); }
+
+    [[nodiscard]] CardSet get_excluded(int seat) const { return CardSet(_excluded[seat]); }
+
+    /**
+     * \brief Number of cards of the rank still out from the view of the observer.
+     */
+    [[nodiscard]] int count_out(int observer, int rank) const { return get_out(observer).count_rank(rank); }
+
+    /**
+     * \brief Number of cards still out per rank from the view of the observer, indexed by Rank.
+     */
+    [[nodiscard]] std::array<uint8_t, ACE + 1> get_out_histogram(int observer) const {
+        return get_out(observer).rank_histogram();
+    }
+};
+
+
+#endif //TICHU_CARD_TRACKER_H
@@ -1,22 +1,23 @@
-
 #include "card.h"
 
-#include <utility>
+#include "../../utils.h"
 
-Card::Card(int rank, int suit, int val) : _rank(rank), _suit(suit), _value(val) {}
+void to_json(nlohmann::json &j, const Card &card) {
+    j = nlohmann::json{{"_rank", card.get_rank()}, {"_suit", card.get_suit()}, {"_value", card.get_value()}};
+}
 
-Card::Card(int rank, int suit) : _rank(rank), _suit(suit) {
-    int value = 0;
-    if (rank == 5) { value = 5; }
-    else if (rank == 10 || rank == 13) { value = 10; }
-    else if (rank == 1 && suit == 1) { value = -25; }
-    else if (rank == 1 && suit == 2) { value = 25; }
-    _value = value;
+void from_json(const nlohmann::json &j, Card &card) {
+    int rank = j.at("_rank").get<int>();
+    int suit = j.at("_suit").get<int>();
+    if (!Card::is_valid(rank, suit)) {
+        throw TichuException("Invalid card with rank " + std::to_string(rank) + " and suit " + std::to_string(suit));
+    }
+    card = Card(rank, suit);
 }
 
 std::string Card::to_string(bool print_suit) const {
-    if(_rank == SPECIAL) {
-        switch(_suit) {
+    if(get_rank() == SPECIAL) {
+        switch(get_suit()) {
             case GREEN: 
                 return "[Phoenix]";
             case RED: 
@@ -31,7 +32,7 @@ std::string Card::to_string(bool print_suit) const {
     std::string card_string = "[";
 
     if(print_suit) {
-        switch(_suit) {
+        switch(get_suit()) {
             case GREEN:
                 card_string += "Green";
                 break;
@@ -47,7 +48,7 @@ std::string Card::to_string(bool print_suit) const {
         }
     card_string += " ";
     }
-    switch(_rank) {
+    switch(get_rank()) {
         case TWO:
             card_string += "Two";
             break;
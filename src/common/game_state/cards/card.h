@@ -1,15 +1,21 @@
 /*! \class Card
     \brief Represents a card.
-    
+
  Every card object has a rank, a suit and a value and every object is unique (no two objects will have the same rank
- and the same suit). The total number of class objects can never exceed 56. 
- 
+ and the same suit). The total number of class objects can never exceed 56.
+
+ A card is stored as a single byte index in the range [0, 56). Rank, suit, point value and sort key are looked up
+ in the constexpr tables of the card_table namespace, so copying and comparing cards is as cheap as copying and
+ comparing a byte.
+
  These cards are created in the setup_round function of the GameState
 */
 
 #ifndef TICHU_CARD_H
 #define TICHU_CARD_H
 
+#include <array>
+#include <cstdint>
 #include <string>
 #include <nlohmann/json.hpp>
 
@@ -28,48 +34,107 @@ enum Suit {
     // For Special cards: RED = Dragon, GREEN = Phoenix, BLUE = Dog, SCHWARZ = One
 };
 
+/**
+ * \namespace card_table
+ * \brief Lookup tables indexed by the card id.
+ *
+ * The id of a card is (rank - 1) * 4 + (suit - 1), so the four special cards occupy the ids 0 to 3 and every
+ * regular rank occupies four consecutive ids.
+ */
+namespace card_table {
+    constexpr int nof_cards = 56;
+    constexpr int nof_suits = 4;
+
+    constexpr int id_of(int rank, int suit) { return (rank - 1) * nof_suits + (suit - 1); }
+
+    constexpr std::array<int8_t, nof_cards> make_ranks() {
+        std::array<int8_t, nof_cards> res{};
+        for (int id = 0; id < nof_cards; ++id) { res[id] = (int8_t)(id / nof_suits + 1); }
+        return res;
+    }
+
+    constexpr std::array<int8_t, nof_cards> make_suits() {
+        std::array<int8_t, nof_cards> res{};
+        for (int id = 0; id < nof_cards; ++id) { res[id] = (int8_t)(id % nof_suits + 1); }
+        return res;
+    }
+
+    constexpr std::array<int8_t, nof_cards> make_values() {
+        std::array<int8_t, nof_cards> res{};
+        for (int suit = GREEN; suit <= SCHWARZ; ++suit) {
+            res[id_of(FIVE, suit)] = 5;
+            res[id_of(TEN, suit)] = 10;
+            res[id_of(KING, suit)] = 10;
+        }
+        res[id_of(SPECIAL, GREEN)] = -25;
+        res[id_of(SPECIAL, RED)] = 25;
+        return res;
+    }
+
+    // Dog and Majong sort below the TWOs, the Phoenix above the ACEs and the Dragon above everything else
+    constexpr std::array<uint8_t, nof_cards> make_sort_keys() {
+        std::array<uint8_t, nof_cards> res{};
+        for (int id = 0; id < nof_cards; ++id) { res[id] = (uint8_t)id; }
+        res[id_of(SPECIAL, GREEN)] = nof_cards;
+        res[id_of(SPECIAL, RED)] = nof_cards + 1;
+        return res;
+    }
+
+    inline constexpr std::array<int8_t, nof_cards> rank = make_ranks();
+    inline constexpr std::array<int8_t, nof_cards> suit = make_suits();
+    inline constexpr std::array<int8_t, nof_cards> value = make_values();
+    inline constexpr std::array<uint8_t, nof_cards> sort_key = make_sort_keys();
+}
+
 class Card {
 private:
-    int _rank;
-    int _suit;
-    int _value;
+    uint8_t _id{};
 
 public:
-    Card() = default;
-    Card(int rank, int suit, int val);
-    Card(int rank, int suit);
+    constexpr Card() = default;
+
+    // the value is fully determined by rank and suit, the parameter is only kept for the special card macros
+    constexpr Card(int rank, int suit, int val) : Card(rank, suit) {}
+    constexpr Card(int rank, int suit) : _id((uint8_t)card_table::id_of(rank, suit)) {}
+
+    static constexpr Card from_id(uint8_t id) {
+        Card card;
+        card._id = id;
+        return card;
+    }
 
-    bool operator==(const Card &other) const {
-        return _rank == other._rank && _suit == other._suit && _value == other._value;
+    [[nodiscard]] static constexpr bool is_valid(int rank, int suit) {
+        return rank >= SPECIAL && rank <= ACE && suit >= GREEN && suit <= SCHWARZ;
     }
 
-    bool operator!=(const Card &other) const {
+    constexpr bool operator==(const Card &other) const {
+        return _id == other._id;
+    }
+
+    constexpr bool operator!=(const Card &other) const {
         return !(*this == other);
     }
 
-    bool operator<(const Card &other) const {
-        if (*this == DRAGON) { return false; }
-        if (other == DRAGON) { return true; }
-        if (*this == PHONIX) { return false; }
-        if (other == PHONIX) { return true; }
-        if (this->get_rank() == other.get_rank()) {
-            return this->get_suit() < other.get_suit();
-        } else {
-            return this->get_rank() < other.get_rank();
-        }
+    constexpr bool operator<(const Card &other) const {
+        return get_sort_key() < other.get_sort_key();
     }
 
 // accessors
-    [[nodiscard]] int get_rank() const noexcept { return _rank; }
-    [[nodiscard]] int get_suit() const noexcept { return _suit; }
-    [[nodiscard]] int get_value() const noexcept { return _value; }
+    [[nodiscard]] constexpr uint8_t get_id() const noexcept { return _id; }
+    [[nodiscard]] constexpr int get_rank() const noexcept { return card_table::rank[_id]; }
+    [[nodiscard]] constexpr int get_suit() const noexcept { return card_table::suit[_id]; }
+    [[nodiscard]] constexpr int get_value() const noexcept { return card_table::value[_id]; }
+    [[nodiscard]] constexpr int get_sort_key() const noexcept { return card_table::sort_key[_id]; }
 
     std::string to_string(bool print_suit) const;
 
-
-    NLOHMANN_DEFINE_TYPE_INTRUSIVE(Card, _rank, _suit, _value);
+    // the wire format stays {_rank, _suit, _value}, the value is recomputed from the tables when parsing
+    friend void to_json(nlohmann::json &j, const Card &card);
+    friend void from_json(const nlohmann::json &j, Card &card);
 };
 
+static_assert(sizeof(Card) == 1, "Card must fit into a single byte");
+
 NLOHMANN_JSON_SERIALIZE_ENUM( Rank, {
     {SPECIAL, "special"},
     {TWO, "two"},
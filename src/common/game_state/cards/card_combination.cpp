@@ -1,346 +1,219 @@
 
 #include "card_combination.h"
-
-
-CardCombination::CardCombination(std::vector<Card> cards) {
-    for (Card c: cards) {
-        _cards.push_back(c);
-    }
-    update_combination_type_and_rank();
-}
-
-CardCombination::CardCombination(Card c) {
-    _cards.push_back(c);
-    update_combination_type_and_rank();
-}
-
-
-int CardCombination::count_occurances(Card card) const {
-    int count = 0;
-    if (card.get_rank() == SPECIAL) {
-        for (Card c: _cards) {
-            if (c.get_rank() == card.get_rank() && c.get_suit() == card.get_suit()) { ++count; }
-        }
-    } else {
-        for (Card c: _cards) {
-            if (c.get_rank() == card.get_rank()) { ++count; }
-        }
-    }
-    return count;
-}
-
-bool CardCombination::are_all_same_rank() {
-    int rank = _cards.at(0).get_rank();
-    for (Card c: _cards) {
-        if (c != PHONIX && c.get_rank() != rank) {
-            return false;
-        }
+#include "card_set.h"
+#include "combination_table.h"
+
+#include <array>
+#include <bit>
+#include <utility>
+
+
+std::pair<int, int> CardCombination::classify_cards(const std::vector<Card> &cards) {
+    // single pass over the cards: count per rank (the Majong counts as rank 1), a mask of the present ranks
+    // and the suits of the regular cards. The Phoenix, Dog and Dragon are tracked separately.
+    std::array<uint8_t, ACE + 1> counts{};
+    uint64_t seen = 0;
+    uint16_t rank_mask = 0;
+    uint8_t suit_mask = 0;
+    bool has_phoenix = false;
+    bool has_dog = false;
+    bool has_dragon = false;
+    bool has_duplicate = false;
+
+    for (Card card: cards) {
+        uint64_t bit = 1ull << card.get_id();
+        has_duplicate |= (seen & bit) != 0;
+        seen |= bit;
+
+        if (card == PHONIX) { has_phoenix = true; continue; }
+        if (card == HUND) { has_dog = true; continue; }
+        if (card == DRAGON) { has_dragon = true; continue; }
+
+        int rank = card.get_rank();
+        ++counts[rank];
+        rank_mask |= (uint16_t)(1u << rank);
+        if (rank != SPECIAL) { suit_mask |= (uint8_t)(1u << card.get_suit()); }
     }
-    return true;
-}
-
-void CardCombination::update_combination_type_and_rank() {
-    // making sure cards are sorted before determining type / rank
-    std::sort(_cards.begin(), _cards.end());
 
-    int size = _cards.size();
-    bool has_phoenix = count_occurances(PHONIX);
-    bool has_dog = count_occurances(HUND);
-    bool has_dragon = count_occurances(DRAGON);
-    bool has_one = count_occurances(ONE);
+    const int size = (int)cards.size();
 
     // PASS
     if (size == 0) {
-        _combination_type = PASS;
-        _combination_rank = 0;
-        return;
+        return {PASS, 0};
     }
 
+    if (has_duplicate) { return {NONE, 0}; }
+
     // SINGLE CARDS
     if (size == 1) {
-
-        // DOG
-        if (has_dog) {
-            _combination_type = SWITCH;
-            _combination_rank = 0;
-            return;
-        }
-        // DRAGON
-        if (has_dragon) {
-            _combination_type = SINGLE;
-            _combination_rank = 15;
-            return;
-        }
-
-        // MAJONG
-        if (has_one) {
-            _combination_type = MAJONG;
-            _combination_rank = 1;
-            return;
-        }
-
-        // SINGLE CARD
-        if (has_phoenix) {
-            _combination_rank = -1;
-        } else {
-            _combination_rank = _cards.at(0).get_rank();
-        }
-        _combination_type = SINGLE;
-        return;
+        if (has_dog) { return {SWITCH, 0}; }
+        if (has_dragon) { return {SINGLE, 15}; }
+        // the rank of a single Phoenix is decided by the combination it is played on
+        if (has_phoenix) { return {SINGLE, -1}; }
+        if (counts[SPECIAL]) { return {MAJONG, 1}; }
+        return {SINGLE, cards.at(0).get_rank()};
     }
 
-    // DOUBLE , TRIPPLE , BOMB
-    if (are_all_same_rank()) {
-        if (size == 2) {
-            _combination_type = DOUBLE;
-            _combination_rank = _cards.at(0).get_rank();
-            return;
-        }
-        if (size == 3) {
-            _combination_type = TRIPLE;
-            _combination_rank = _cards.at(0).get_rank();
-            return;
-        }
-        if (size == 4 && !has_phoenix) {
-            _combination_type = BOMB;
-            _combination_rank = _cards.at(0).get_rank();
-            return;
-        }
-        _combination_type = NONE;
-        _combination_rank = 0;
-        return;
+    // the Dog and the Dragon can only be played alone
+    if (has_dog || has_dragon) { return {NONE, 0}; }
+
+    const int phoenix = has_phoenix ? 1 : 0;
+    const int nof_regular = size - phoenix;
+    const int nof_ranks = std::popcount(rank_mask);
+    const int lowest = std::countr_zero(rank_mask);
+    const int highest = std::bit_width(rank_mask) - 1;
+    const bool consecutive = highest - lowest + 1 == nof_ranks;
+    int max_count = 0;
+    for (int rank = SPECIAL; rank <= ACE; ++rank) { max_count = std::max<int>(max_count, counts[rank]); }
+
+    // DOUBLE , TRIPPLE , BOMB (the Phoenix can substitute a card of a double or a tripple, but not of a bomb)
+    if (nof_ranks == 1) {
+        if (lowest == SPECIAL) { return {NONE, 0}; }
+        if (size == 2 || size == 3) { return {size == 2 ? DOUBLE : TRIPLE, lowest}; }
+        if (size == 4 && !has_phoenix) { return {BOMB, lowest}; }
+        return {NONE, 0};
     }
 
-    if (has_dog || has_dragon) {
-        _combination_type = NONE;
-        _combination_rank = 0;
-        return;
-    }
+    // the Majong can only be part of a street
+    const bool has_majong = counts[SPECIAL] > 0;
 
-    // FULLHOUSE
-    if (size == 5) {
-        if (has_phoenix) {
-            if (count_occurances(_cards.at(0)) == 2 && count_occurances(_cards.at(2)) == 2) {
-                _combination_type = FULLHOUSE;
-                _combination_rank = _cards.at(2).get_rank();
-                return;
-            } else if (count_occurances(_cards.at(0)) == 1 && count_occurances(_cards.at(2)) == 3) {
-                _combination_type = FULLHOUSE;
-                _combination_rank = _cards.at(2).get_rank();
-                return;
-            } else if (count_occurances(_cards.at(0)) == 3) {
-                _combination_type = FULLHOUSE;
-                _combination_rank = _cards.at(0).get_rank();
-                return;
-            }
-        } else {
-            if (count_occurances(_cards.at(0)) == 3) {
-                if (count_occurances(_cards.at(4)) == 2) {
-                    _combination_type = FULLHOUSE;
-                    _combination_rank = _cards.at(0).get_rank();
-                    return;
-                } else {
-                    _combination_type = NONE;
-                    _combination_rank = 0;
-                    return;
-                }
-            }
-            if (count_occurances(_cards.at(0)) == 2) {
-                if (count_occurances(_cards.at(4)) == 3) {
-                    _combination_type = FULLHOUSE;
-                    _combination_rank = _cards.at(4).get_rank();
-                    return;
-                } else {
-                    _combination_type = NONE;
-                    _combination_rank = 0;
-                    return;
-                }
+    // FULLHOUSE: a tripple and a double, the Phoenix completes either of them
+    if (size == 5 && nof_ranks == 2 && !has_majong) {
+        if (counts[lowest] == 3 || counts[highest] == 3) {
+            if (counts[lowest] + counts[highest] == 5 || has_phoenix) {
+                return {FULLHOUSE, counts[highest] == 3 ? highest : lowest};
             }
+        } else if (has_phoenix && counts[lowest] == 2 && counts[highest] == 2) {
+            // the Phoenix turns the higher double into the tripple
+            return {FULLHOUSE, highest};
         }
     }
 
-    // STRASSE
-    Card previous = _cards.at(0);
-    if (size >= 5) {
+    // STRASSE: at least 5 distinct consecutive ranks, the Phoenix fills a single gap or extends the street
+    if (size >= 5 && max_count == 1) {
+        if (!has_phoenix && consecutive) {
+            // street bomb: no Majong and all cards of the same suit
+            return {!has_majong && std::popcount(suit_mask) == 1 ? BOMB : STRASS, lowest};
+        }
         if (has_phoenix) {
-            int number_of_two_gaps = 0;
-            bool first_loop = true;
-            previous = _cards.at(0);
-            for (Card card: _cards) {
-                if (first_loop) {
-                    first_loop = false;
-                    continue;
-                }
-                if (card == PHONIX) { break; }
-                if (card.get_rank() - previous.get_rank() == 2) {
-                    ++number_of_two_gaps;
-                    break;
-                }
-                if (card.get_rank() - previous.get_rank() == 0) {
-                    number_of_two_gaps = 2;
-                    break;
-                }
-                previous = card;
-            }
-            if (number_of_two_gaps <= 1) {
-                _combination_type = STRASS;
-                _combination_rank = _cards.at(0).get_rank();
-                return;
-            }
-        } else {
-            bool is_Strass = true;
-            bool first_loop = true;
-            previous = _cards.at(0);
-            for (Card card: _cards) {
-                if (first_loop) {
-                    first_loop = false;
-                    continue;
-                }
-                if (card.get_rank() - previous.get_rank() != 1) {
-                    is_Strass = false;
-                    break;
-                }
-                previous = card;
+            if (highest - lowest + 1 == nof_regular + 1) {
+                return {STRASS, lowest};
             }
-            //check for strassenbombe
-            bool all_same_suit = true;
-            int first_suit = _cards.at(0).get_suit();
-            for (Card card: _cards) {
-                if (card.get_suit() != first_suit) {
-                    all_same_suit = false;
-                    break;
-                }
-            }
-            if (all_same_suit) {
-                _combination_type = BOMB;
-                _combination_rank = _cards.at(0).get_rank();
-                return;
-            }
-            if (is_Strass) {
-                _combination_type = STRASS;
-                _combination_rank = _cards.at(0).get_rank();
-                return;
+            if (consecutive) {
+                // extend at the top if possible, otherwise below the lowest card
+                if (highest < ACE) { return {STRASS, lowest}; }
+                if (lowest > TWO) { return {STRASS, lowest - 1}; }
+                return {NONE, 0};
             }
         }
     }
 
-    // TREPPE 
-    bool is_Treppe = true;
-    if (size % 2 == 0) {
-        if (has_phoenix) {
-            bool expect_gap = 0;
-            bool first_loop = true;
-            int mistake_count = 0;
-            previous = _cards.at(0);
-            for (Card card: _cards) {
-                if (card == PHONIX) { break; }
-                if (first_loop) {
-                    first_loop = false;
-                    continue;
-                }
-                if (card.get_rank() - previous.get_rank() != expect_gap) {
-                    if (mistake_count == 0) {
-                        mistake_count++;
-                        previous = card;
-                        continue;
-                    } else {
-                        is_Treppe = false;
-                        break;
-                    }
-                }
-                previous = card;
-                expect_gap = !expect_gap;
-            }
+    // TREPPE: at least 2 consecutive doubles, the Phoenix completes one of them
+    if (size % 2 == 0 && !has_majong && consecutive && max_count <= 2 && nof_regular == 2 * nof_ranks - phoenix) {
+        return {TREPPE, lowest};
+    }
+    return {NONE, 0};
+}
 
-        } else {
-            bool expect_gap = 0;
-            bool first_loop = true;
-            previous = _cards.at(0);
-            for (const Card& card: _cards) {
-                if (first_loop) {
-                    first_loop = false;
-                    continue;
-                }
-                if (card.get_rank() - previous.get_rank() != expect_gap) {
-                    is_Treppe = false;
-                    break;
-                }
-                previous = card;
-                expect_gap = !expect_gap;
-            }
 
+CardCombination::CardCombination(std::vector<Card> cards) :
+        _cards(std::move(cards)) {
+    classify();
+}
+
+CardCombination::CardCombination(Card c) :
+        _cards{c} {
+    classify();
+}
+
+
+int CardCombination::count_occurances(Card card) const {
+    int count = 0;
+    if (card.get_rank() == SPECIAL) {
+        for (Card c: _cards) {
+            if (c == card) { ++count; }
         }
-        if (is_Treppe) {
-            _combination_type = TREPPE;
-            _combination_rank = _cards.at(0).get_rank();
-            return;
+    } else {
+        for (Card c: _cards) {
+            if (c.get_rank() == card.get_rank()) { ++count; }
         }
     }
+    return count;
+}
 
-    _combination_type = NONE;
-    _combination_rank = 0;
+void CardCombination::classify() {
+    const CardSet cards(_cards);
+    // a card given twice is no combination
+    if (cards.size() != (int)_cards.size()) {
+        _key = pack(NONE, (int)_cards.size(), 0);
+        return;
+    }
+    const Classification res = CombinationTable::classify(cards);
+    _key = pack(res.type, res.length, res.rank);
 }
 
-bool CardCombination::can_be_played_on(const std::optional<CardCombination> &other_opt, std::string &err) {
-    update_combination_type_and_rank();
+bool CardCombination::can_be_played_on(const std::optional<CardCombination> &other_opt, std::string &err) const {
+    const int type = get_combination_type();
     //nothing
-    if (this->_combination_type == NONE) {
+    if (type == NONE) {
         err = "Invalid combination";
         return false;
     }
 
-
     //pass
-    if (this->_combination_type == PASS) {
+    if (type == PASS) {
         return true;
     }
 
-    
-
     if (!other_opt) { return true; }
-    const CardCombination& other = other_opt.value();
-    if(other.get_combination_type() == MAJONG && this->get_combination_type() == SINGLE) { return true; }
-    if (other.get_combination_type() == SWITCH) { return true; }
-
-    //bombs
-    if (this->_combination_type == BOMB) {
-        if (other.get_combination_type() != BOMB) { return true; }
-        else if (this->get_cards().size() > other.get_cards().size()) { return true; }
-        else if (this->get_cards().size() == other.get_cards().size()
-                 && this->get_combination_rank() > other.get_combination_rank()) { return true; }
-        else {
-            err = "bomb not high enough";
-            return false;
-        }
+    const CardCombination &other = other_opt.value();
+    const int other_type = other.get_combination_type();
+    if (other_type == MAJONG && type == SINGLE) { return true; }
+    if (other_type == SWITCH) { return true; }
+
+    //bombs: longer bombs beat shorter ones, bombs of the same length compare by rank
+    if (type == BOMB) {
+        if (other_type != BOMB || _key > other._key) { return true; }
+        err = "bomb not high enough";
+        return false;
     }
 
     // single Phoenix
-    if (this->_combination_type == SINGLE && this->_combination_rank == -1) {
-        if (other.get_combination_type() == SINGLE) {
-            if (other.get_combination_rank() != 15) {
-                _combination_rank = other.get_combination_rank();
-                return true;
-            } else {
-                return false;
-            }
-        } else {
-            return false;
-        }
+    if (is_single_phoenix()) {
+        return other_type == SINGLE && other.get_combination_rank() != 15;
     }
 
-    if (this->_combination_type == other.get_combination_type()
-        && this->get_cards().size() == other.get_cards().size()) {
-        if (this->_combination_rank > other.get_combination_rank()) {
-            return true;
-        } else {
-            err = "The Combination is not high enough";
-            return false;
-        }
-
-    } else {
-        err = "Wrong Combination Type";
+    if ((_key >> 8) == (other._key >> 8)) {
+        if (_key > other._key) { return true; }
+        err = "The Combination is not high enough";
         return false;
     }
-    return true;
-    //TO-DO
-}
\ No newline at end of file
+    err = "Wrong Combination Type";
+    return false;
+}
+
+CardCombination CardCombination::played_on(const std::optional<CardCombination> &other) const {
+    if (!is_single_phoenix()) { return *this; }
+    CardCombination res = *this;
+    int rank = other && other->get_combination_type() == SINGLE ? other->get_combination_rank() : -1;
+    res._key = pack(SINGLE, 1, rank);
+    return res;
+}
+
+void to_json(nlohmann::json &j, const CardCombination &combi) {
+    j = nlohmann::json{{"_cards", combi._cards},
+                       {"_combination_type", combi.get_combination_type()},
+                       {"_combination_rank", combi.get_combination_rank()}};
+}
+
+void from_json(const nlohmann::json &j, CardCombination &combi) {
+    combi._cards = j.at("_cards").get<std::vector<Card>>();
+    combi.classify();
+    // the rank of a single Phoenix depends on the trick it was played in, it is recomputed by the server when the
+    // Phoenix is played, so only the range is checked here
+    if (combi.is_single_phoenix() && j.contains("_combination_rank")) {
+        int rank = j.at("_combination_rank").get<int>();
+        if (rank < -1 || rank > ACE) { throw TichuException("Invalid rank of a single Phoenix"); }
+        combi._key = CardCombination::pack(SINGLE, 1, rank);
+    }
+}
@@ -11,6 +11,9 @@
 #define TICHU_CARD_COMBINATION_H
 
 #include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <string>
 #include <vector>
 #include "../../utils.h"
 #include "card.h"
@@ -32,33 +35,68 @@ class CardCombination {
 
 private:
     std::vector<Card> _cards;
-    int _combination_type{};
-    int _combination_rank{};
+    // (type, length, rank + 1) packed into one integer: combinations of the same type and length compare by rank,
+    // bombs compare by length first and then by rank
+    uint32_t _key{};
 
+    [[nodiscard]] bool is_single_phoenix() const noexcept { return _cards.size() == 1 && _cards[0] == PHONIX; }
+
+    /**
+     * \brief Classifies the cards with the CombinationTable. Only called on construction, a CardCombination is
+     * immutable afterwards.
+     */
+    void classify();
 
 public:
-    CardCombination() = default;
+    /**
+     * \brief The key of a combination of the type, number of cards and rank, as returned by get_key().
+     */
+    static constexpr uint32_t pack(int type, int length, int rank) {
+        return ((uint32_t)type << 16) | ((uint32_t)length << 8) | (uint32_t)(rank + 1);
+    }
+
+    CardCombination() : _key(pack(PASS, 0, 0)) {}
     explicit CardCombination(std::vector<Card> cards);
     explicit CardCombination(Card card);
 
 // accessors
-    [[nodiscard]] int get_combination_type() const noexcept { return _combination_type; }
+    [[nodiscard]] int get_combination_type() const noexcept { return (int)(_key >> 16); }
+
+    [[nodiscard]] int get_combination_rank() const noexcept { return (int)(_key & 0xFF) - 1; }
+
+    [[nodiscard]] int get_length() const noexcept { return (int)((_key >> 8) & 0xFF); }
 
-    [[nodiscard]] int get_combination_rank() const noexcept { return _combination_rank; }
+    [[nodiscard]] uint32_t get_key() const noexcept { return _key; }
 
     [[nodiscard]] const std::vector<Card> &get_cards() const noexcept { return _cards; }
 
 // card combination functions
-    [[nodiscard]] int count_occurances(Card card) const;
-
-    bool are_all_same_rank();
+    /**
+     * \brief Classifies the cards into a COMBI type and rank without the CombinationTable.
+     *
+     * Builds a per rank count vector and a suit mask in a single pass over the cards and decides the combination
+     * from that signature, without sorting the cards. This is the reference the CombinationTable is tested against.
+     *
+     * \return The COMBI type and the rank.
+     */
+    static std::pair<int, int> classify_cards(const std::vector<Card> &cards);
 
-    void update_combination_type_and_rank();
+    [[nodiscard]] int count_occurances(Card card) const;
 
-    bool can_be_played_on(const std::optional<CardCombination> &other, std::string &err);
+    [[nodiscard]] bool can_be_played_on(const std::optional<CardCombination> &other, std::string &err) const;
 
-    NLOHMANN_DEFINE_TYPE_INTRUSIVE(CardCombination, _cards, _combination_type, _combination_rank);
+    /**
+     * \brief Returns the combination as it lies on the ActivePile after being played on other.
+     *
+     * A single Phoenix takes the rank of the single card it is played on (-1 if it leads the trick), every other
+     * combination is returned unchanged.
+     */
+    [[nodiscard]] CardCombination played_on(const std::optional<CardCombination> &other) const;
 
+    // serialized as {_cards, _combination_type, _combination_rank}, the type and rank are recomputed from the cards
+    // on deserialization, except for the rank of a single Phoenix on the ActivePile
+    friend void to_json(nlohmann::json &j, const CardCombination &combi);
+    friend void from_json(const nlohmann::json &j, CardCombination &combi);
 };
 
 
@@ -0,0 +1,26 @@
+#include "card_set.h"
+
+Card CardSet::nth(int n) const {
+    uint64_t sorted = to_sorted(_mask);
+    for (int i = 0; i < n; ++i) {
+        sorted &= sorted - 1;
+    }
+    return Card::from_id((uint8_t)id_of_sorted(std::countr_zero(sorted)));
+}
+
+std::vector<Card> CardSet::to_vector() const {
+    std::vector<Card> res;
+    res.reserve(size());
+    for (Card card: *this) {
+        res.push_back(card);
+    }
+    return res;
+}
+
+void to_json(nlohmann::json &j, const CardSet &cards) {
+    j = cards.to_vector();
+}
+
+void from_json(const nlohmann::json &j, CardSet &cards) {
+    cards = CardSet(j.get<std::vector<Card>>());
+}
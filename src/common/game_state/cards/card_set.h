@@ -0,0 +1,202 @@
+/*! \class CardSet
+    \brief Represents an unordered set of cards as a 56-bit mask.
+
+ Bit i of the mask is set if the card with id i (see Card::get_id) is part of the set. Since the four suits of a
+ rank occupy four consecutive bits, rank histograms and suit masks can be computed with a handful of shifts and
+ popcounts. Insert, remove and contains are O(1).
+
+ Iterating a CardSet yields the cards in the same order as sorting them with Card::operator<.
+*/
+
+#ifndef TICHU_CARD_SET_H
+#define TICHU_CARD_SET_H
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <vector>
+#include "card.h"
+#include <nlohmann/json.hpp>
+
+namespace card_table {
+    // the ids of all cards worth the given number of points as a mask
+    constexpr uint64_t make_value_mask(int points) {
+        uint64_t res = 0;
+        for (int id = 0; id < nof_cards; ++id) {
+            if (value[id] == points) { res |= 1ull << id; }
+        }
+        return res;
+    }
+
+    inline constexpr uint64_t five_points = make_value_mask(5);
+    inline constexpr uint64_t ten_points = make_value_mask(10);
+    inline constexpr uint64_t dragon_points = make_value_mask(25);
+    inline constexpr uint64_t phoenix_points = make_value_mask(-25);
+}
+
+class CardSet {
+private:
+    uint64_t _mask{};
+
+    // Phoenix (id 0) and Dragon (id 1) sort above the ACEs, rotating them to the top gives the sort order
+    static constexpr int rotation = 2;
+
+    static constexpr uint64_t to_sorted(uint64_t mask) {
+        return (mask >> rotation) | ((mask & ((1ull << rotation) - 1)) << (card_table::nof_cards - rotation));
+    }
+
+    static constexpr int id_of_sorted(int pos) {
+        return (pos + rotation) % card_table::nof_cards;
+    }
+
+public:
+    static constexpr uint64_t full_mask = (1ull << card_table::nof_cards) - 1;
+    static constexpr uint64_t special_mask = 0xFull;
+    // lowest bit of every rank nibble
+    static constexpr uint64_t nibble_mask = 0x11111111111111ull;
+
+    class iterator {
+    private:
+        uint64_t _sorted;
+
+    public:
+        constexpr explicit iterator(uint64_t sorted) : _sorted(sorted) {}
+
+        constexpr Card operator*() const { return Card::from_id((uint8_t)id_of_sorted(std::countr_zero(_sorted))); }
+
+        constexpr iterator &operator++() {
+            _sorted &= _sorted - 1;
+            return *this;
+        }
+
+        constexpr bool operator==(const iterator &other) const { return _sorted == other._sorted; }
+
+        constexpr bool operator!=(const iterator &other) const { return _sorted != other._sorted; }
+    };
+
+    constexpr CardSet() = default;
+
+    constexpr explicit CardSet(uint64_t mask) : _mask(mask & full_mask) {}
+
+    constexpr explicit CardSet(Card card) : _mask(1ull << card.get_id()) {}
+
+    explicit CardSet(const std::vector<Card> &cards) {
+        for (const Card &card: cards) { insert(card); }
+    }
+
+    static constexpr CardSet full_deck() { return CardSet(full_mask); }
+
+    constexpr bool operator==(const CardSet &other) const { return _mask == other._mask; }
+
+    constexpr bool operator!=(const CardSet &other) const { return _mask != other._mask; }
+
+    constexpr CardSet operator|(const CardSet &other) const { return CardSet(_mask | other._mask); }
+
+    constexpr CardSet operator&(const CardSet &other) const { return CardSet(_mask & other._mask); }
+
+    constexpr CardSet operator-(const CardSet &other) const { return CardSet(_mask & ~other._mask); }
+
+    constexpr CardSet &operator|=(const CardSet &other) {
+        _mask |= other._mask;
+        return *this;
+    }
+
+    constexpr CardSet &operator-=(const CardSet &other) {
+        _mask &= ~other._mask;
+        return *this;
+    }
+
+// accessors
+    [[nodiscard]] constexpr uint64_t get_mask() const noexcept { return _mask; }
+
+    [[nodiscard]] constexpr int size() const noexcept { return std::popcount(_mask); }
+
+    [[nodiscard]] constexpr bool empty() const noexcept { return _mask == 0; }
+
+    [[nodiscard]] constexpr bool contains(Card card) const noexcept { return (_mask >> card.get_id()) & 1; }
+
+    [[nodiscard]] constexpr bool contains(const CardSet &other) const noexcept {
+        return (other._mask & ~_mask) == 0;
+    }
+
+    /**
+     * \brief Number of cards of the given rank. For SPECIAL this is the number of special cards in the set.
+     */
+    [[nodiscard]] constexpr int count_rank(int rank) const noexcept {
+        return std::popcount((_mask >> ((rank - 1) * card_table::nof_suits)) & 0xF);
+    }
+
+    /**
+     * \brief Number of cards per rank, indexed by Rank (index 0 is unused).
+     */
+    [[nodiscard]] constexpr std::array<uint8_t, ACE + 1> rank_histogram() const noexcept {
+        std::array<uint8_t, ACE + 1> res{};
+        for (int rank = SPECIAL; rank <= ACE; ++rank) { res[rank] = (uint8_t)count_rank(rank); }
+        return res;
+    }
+
+    /**
+     * \brief All regular (non special) cards of the given suit.
+     */
+    [[nodiscard]] constexpr CardSet suit_mask(int suit) const noexcept {
+        return CardSet(_mask & (nibble_mask << (suit - 1)) & ~special_mask);
+    }
+
+    /**
+     * \brief Sum of the card values: 5 per FIVE, 10 per TEN and KING, 25 for the Dragon and -25 for the Phoenix.
+     */
+    [[nodiscard]] constexpr int score() const noexcept {
+        return 5 * std::popcount(_mask & card_table::five_points) + 10 * std::popcount(_mask & card_table::ten_points)
+               + 25 * std::popcount(_mask & card_table::dragon_points)
+               - 25 * std::popcount(_mask & card_table::phoenix_points);
+    }
+
+    /**
+     * \brief Bit (rank - 1) is set if the set holds at least min_count cards of that rank.
+     */
+    [[nodiscard]] constexpr uint16_t rank_mask(int min_count = 1) const noexcept {
+        uint16_t res = 0;
+        for (int rank = SPECIAL; rank <= ACE; ++rank) {
+            if (count_rank(rank) >= min_count) { res |= (uint16_t)(1u << (rank - 1)); }
+        }
+        return res;
+    }
+
+    /**
+     * \brief Bit (rank - 1) is set if the set holds the regular card of that rank and suit.
+     */
+    [[nodiscard]] constexpr uint16_t suit_rank_mask(int suit) const noexcept {
+        const uint64_t cards = suit_mask(suit).get_mask() >> (suit - 1);
+        uint16_t res = 0;
+        for (int rank = TWO; rank <= ACE; ++rank) {
+            res |= (uint16_t)(((cards >> ((rank - 1) * card_table::nof_suits)) & 1) << (rank - 1));
+        }
+        return res;
+    }
+
+    [[nodiscard]] constexpr iterator begin() const { return iterator(to_sorted(_mask)); }
+
+    [[nodiscard]] constexpr iterator end() const { return iterator(0); }
+
+    /**
+     * \brief Returns the n-th card in sort order, n must be smaller than size().
+     */
+    [[nodiscard]] Card nth(int n) const;
+
+    [[nodiscard]] std::vector<Card> to_vector() const;
+
+// modifiers
+    constexpr void insert(Card card) noexcept { _mask |= 1ull << card.get_id(); }
+
+    constexpr void erase(Card card) noexcept { _mask &= ~(1ull << card.get_id()); }
+
+    constexpr void clear() noexcept { _mask = 0; }
+
+    // serialized as a sorted array of cards, the same shape as the std::vector<Card> it replaces
+    friend void to_json(nlohmann::json &j, const CardSet &cards);
+    friend void from_json(const nlohmann::json &j, CardSet &cards);
+};
+
+static_assert(CardSet::full_deck().score() == 100, "the cards of a deck are worth 100 points");
+
+#endif //TICHU_CARD_SET_H
@@ -0,0 +1,304 @@
+#include "combination_table.h"
+
+#include <algorithm>
+#include <array>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define TICHU_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace {
+    constexpr int table_size = 1 << CombinationTable::table_bits;
+    constexpr uint64_t empty_slot = ~0ull;
+
+    constexpr uint64_t phoenix_bit = 1ull << PHONIX.get_id();
+    constexpr uint64_t dragon_bit = 1ull << DRAGON.get_id();
+    constexpr uint64_t dog_bit = 1ull << HUND.get_id();
+    constexpr uint64_t majong_bit = 1ull << ONE.get_id();
+
+    constexpr size_t slot_of(uint64_t key) {
+        return (size_t)((key * 0x9E3779B97F4A7C15ull) >> (64 - CombinationTable::table_bits));
+    }
+
+    struct Table {
+        std::array<uint64_t, table_size> keys{};
+        std::array<Classification, table_size> values{};
+        int nof_entries = 0;
+        int max_probe = 0;
+        bool conflict = false;
+
+        constexpr Table() {
+            for (uint64_t &key: keys) { key = empty_slot; }
+        }
+
+        // the signature of a shape given by the number of cards per regular rank and the special cards
+        static constexpr uint64_t key_of(const std::array<int, ACE + 1> &counts, uint64_t specials, bool same_suit) {
+            uint64_t key = specials;
+            for (int rank = TWO; rank <= ACE; ++rank) { key |= (uint64_t)counts[rank] << ((rank - 1) * 4); }
+            return same_suit ? key | CombinationTable::same_suit_flag : key;
+        }
+
+        constexpr void add(const std::array<int, ACE + 1> &counts, uint64_t specials, bool same_suit, int type,
+                           int rank) {
+            const uint64_t key = key_of(counts, specials, same_suit);
+            int length = std::popcount(specials);
+            for (int rank_count: counts) { length += rank_count; }
+            const Classification value{(uint8_t)type, (int8_t)rank, (uint8_t)length};
+
+            size_t slot = slot_of(key);
+            int probe = 0;
+            while (keys[slot] != empty_slot && keys[slot] != key) {
+                slot = (slot + 1) % table_size;
+                ++probe;
+            }
+            if (keys[slot] == key) {
+                // a shape reached twice has to be classified the same way
+                conflict |= values[slot].type != value.type || values[slot].rank != value.rank;
+                return;
+            }
+            keys[slot] = key;
+            values[slot] = value;
+            ++nof_entries;
+            max_probe = std::max(max_probe, probe);
+        }
+    };
+
+    constexpr Table make_table() {
+        Table table;
+        std::array<int, ACE + 1> counts{};
+
+        // PASS and the single cards
+        table.add(counts, 0, false, PASS, 0);
+        table.add(counts, majong_bit, false, MAJONG, 1);
+        table.add(counts, dog_bit, false, SWITCH, 0);
+        table.add(counts, dragon_bit, false, SINGLE, 15);
+        table.add(counts, phoenix_bit, false, SINGLE, -1);
+
+        // SINGLE, DOUBLE, TRIPPLE, BOMB, the Phoenix substitutes a card of a double or a tripple
+        for (int rank = TWO; rank <= ACE; ++rank) {
+            counts = {};
+            for (int count = 1; count <= card_table::nof_suits; ++count) {
+                counts[rank] = count;
+                constexpr int types[] = {NONE, SINGLE, DOUBLE, TRIPLE, BOMB};
+                table.add(counts, 0, false, types[count], rank);
+                if (count == 1 || count == 2) { table.add(counts, phoenix_bit, false, types[count + 1], rank); }
+            }
+        }
+
+        // FULLHOUSE, the rank is the rank of the tripple
+        for (int triple = TWO; triple <= ACE; ++triple) {
+            for (int pair = TWO; pair <= ACE; ++pair) {
+                if (pair == triple) { continue; }
+                counts = {};
+                counts[triple] = 3;
+                counts[pair] = 2;
+                table.add(counts, 0, false, FULLHOUSE, triple);
+                counts[pair] = 1;
+                table.add(counts, phoenix_bit, false, FULLHOUSE, triple);
+                // two doubles and the Phoenix, the Phoenix turns the higher double into the tripple
+                if (triple > pair) {
+                    counts[triple] = 2;
+                    counts[pair] = 2;
+                    table.add(counts, phoenix_bit, false, FULLHOUSE, triple);
+                }
+            }
+        }
+
+        // STRASS from the Majong (rank 1) up to the ACE, a street of a single suit without the Majong is a bomb
+        for (int length = 5; length <= ACE; ++length) {
+            for (int start = SPECIAL; start + length - 1 <= ACE; ++start) {
+                const int end = start + length - 1;
+                const uint64_t majong = start == SPECIAL ? majong_bit : 0;
+                counts = {};
+                for (int rank = std::max(start, (int)TWO); rank <= end; ++rank) { counts[rank] = 1; }
+
+                table.add(counts, majong, false, STRASS, start);
+                if (!majong) { table.add(counts, 0, true, BOMB, start); }
+
+                // the Phoenix replaces any card but the Majong
+                for (int gap = std::max(start, (int)TWO); gap <= end; ++gap) {
+                    counts[gap] = 0;
+                    // the Phoenix extends the remaining cards at the top if possible, so a missing lowest card
+                    // gives the street one rank higher, unless it ends with the ACE
+                    const int rank = gap == start && end < ACE ? start + 1 : start;
+                    table.add(counts, majong | phoenix_bit, false, STRASS, rank);
+                    counts[gap] = 1;
+                }
+            }
+        }
+
+        // TREPPE of at least two consecutive doubles, the Phoenix completes one of them
+        for (int length = 2; length <= ACE - 1; ++length) {
+            for (int start = TWO; start + length - 1 <= ACE; ++start) {
+                counts = {};
+                for (int rank = start; rank < start + length; ++rank) { counts[rank] = 2; }
+                table.add(counts, 0, false, TREPPE, start);
+                for (int single = start; single < start + length; ++single) {
+                    counts[single] = 1;
+                    table.add(counts, phoenix_bit, false, TREPPE, start);
+                    counts[single] = 2;
+                }
+            }
+        }
+        return table;
+    }
+
+    constexpr Table table = make_table();
+
+    static_assert(!table.conflict, "two shapes with the same signature are classified differently");
+    static_assert(table.nof_entries < table_size / 2, "the combination table is too full");
+    static_assert(table.max_probe <= 8, "too many collisions in the combination table");
+}
+
+namespace {
+    Classification lookup(uint64_t key, int length) {
+        size_t slot = slot_of(key);
+        while (table.keys[slot] != key) {
+            if (table.keys[slot] == empty_slot) { return {NONE, 0, (uint8_t)length}; }
+            slot = (slot + 1) % table_size;
+        }
+        return table.values[slot];
+    }
+
+    // the signature kernels write the signature and the number of cards of count masks
+    void signatures_scalar(const uint64_t *masks, size_t count, uint64_t *keys, uint8_t *lengths) {
+        for (size_t i = 0; i < count; ++i) {
+            keys[i] = CombinationTable::signature(masks[i]);
+            lengths[i] = (uint8_t)std::popcount(masks[i]);
+        }
+    }
+
+#ifdef TICHU_X86_SIMD
+    // 2 masks per register, the same steps as CombinationTable::signature
+    __attribute__((target("sse4.1")))
+    void signatures_sse(const uint64_t *masks, size_t count, uint64_t *keys, uint8_t *lengths) {
+        const __m128i m1 = _mm_set1_epi64x(0x5555555555555555ll);
+        const __m128i m2 = _mm_set1_epi64x(0x3333333333333333ll);
+        const __m128i m4 = _mm_set1_epi64x(0x0F0F0F0F0F0F0F0Fll);
+        const __m128i specials = _mm_set1_epi64x((long long)CardSet::special_mask);
+        const __m128i flag = _mm_set1_epi64x((long long)CombinationTable::same_suit_flag);
+        const __m128i four = _mm_set1_epi64x(4);
+        const __m128i zero = _mm_setzero_si128();
+        __m128i other_suits[card_table::nof_suits];
+        for (int suit = 0; suit < card_table::nof_suits; ++suit) {
+            other_suits[suit] = _mm_set1_epi64x((long long)~(CardSet::nibble_mask << suit));
+        }
+
+        size_t i = 0;
+        for (; i + 2 <= count; i += 2) {
+            const __m128i mask = _mm_loadu_si128((const __m128i *)(masks + i));
+            __m128i counts = _mm_sub_epi64(mask, _mm_and_si128(_mm_srli_epi64(mask, 1), m1));
+            counts = _mm_add_epi64(_mm_and_si128(counts, m2), _mm_and_si128(_mm_srli_epi64(counts, 2), m2));
+            const __m128i length = _mm_sad_epu8(_mm_and_si128(_mm_add_epi64(counts, _mm_srli_epi64(counts, 4)), m4),
+                                                zero);
+            __m128i key = _mm_or_si128(_mm_andnot_si128(specials, counts), _mm_and_si128(mask, specials));
+
+            // the lengths are at most 56, comparing the low halves and copying the result to the high halves
+            // replaces the 64 bit compare SSE4.1 does not have
+            __m128i street = _mm_shuffle_epi32(_mm_cmpgt_epi32(length, four), _MM_SHUFFLE(2, 2, 0, 0));
+            street = _mm_and_si128(street, _mm_cmpeq_epi64(_mm_and_si128(mask, specials), zero));
+            __m128i same_suit = zero;
+            for (const __m128i &other: other_suits) {
+                same_suit = _mm_or_si128(same_suit, _mm_cmpeq_epi64(_mm_and_si128(mask, other), zero));
+            }
+            key = _mm_or_si128(key, _mm_and_si128(flag, _mm_and_si128(street, same_suit)));
+
+            _mm_storeu_si128((__m128i *)(keys + i), key);
+            lengths[i] = (uint8_t)_mm_extract_epi64(length, 0);
+            lengths[i + 1] = (uint8_t)_mm_extract_epi64(length, 1);
+        }
+        signatures_scalar(masks + i, count - i, keys + i, lengths + i);
+    }
+
+    // the signatures and lengths of 4 masks
+    __attribute__((target("avx2")))
+    inline void signature4_avx2(const uint64_t *masks, uint64_t *keys, uint64_t *lengths) {
+        const __m256i m1 = _mm256_set1_epi64x(0x5555555555555555ll);
+        const __m256i m2 = _mm256_set1_epi64x(0x3333333333333333ll);
+        const __m256i m4 = _mm256_set1_epi64x(0x0F0F0F0F0F0F0F0Fll);
+        const __m256i specials = _mm256_set1_epi64x((long long)CardSet::special_mask);
+        const __m256i flag = _mm256_set1_epi64x((long long)CombinationTable::same_suit_flag);
+        const __m256i four = _mm256_set1_epi64x(4);
+        const __m256i zero = _mm256_setzero_si256();
+
+        const __m256i mask = _mm256_loadu_si256((const __m256i *)masks);
+        __m256i counts = _mm256_sub_epi64(mask, _mm256_and_si256(_mm256_srli_epi64(mask, 1), m1));
+        counts = _mm256_add_epi64(_mm256_and_si256(counts, m2), _mm256_and_si256(_mm256_srli_epi64(counts, 2), m2));
+        const __m256i length = _mm256_sad_epu8(
+                _mm256_and_si256(_mm256_add_epi64(counts, _mm256_srli_epi64(counts, 4)), m4), zero);
+        __m256i key = _mm256_or_si256(_mm256_andnot_si256(specials, counts), _mm256_and_si256(mask, specials));
+
+        const __m256i street = _mm256_and_si256(_mm256_cmpgt_epi64(length, four),
+                                                _mm256_cmpeq_epi64(_mm256_and_si256(mask, specials), zero));
+        __m256i same_suit = zero;
+        for (int suit = 0; suit < card_table::nof_suits; ++suit) {
+            const __m256i other = _mm256_set1_epi64x((long long)~(CardSet::nibble_mask << suit));
+            same_suit = _mm256_or_si256(same_suit, _mm256_cmpeq_epi64(_mm256_and_si256(mask, other), zero));
+        }
+        key = _mm256_or_si256(key, _mm256_and_si256(flag, _mm256_and_si256(street, same_suit)));
+
+        _mm256_storeu_si256((__m256i *)keys, key);
+        _mm256_storeu_si256((__m256i *)lengths, length);
+    }
+
+    // 4 masks per register, two registers per iteration
+    __attribute__((target("avx2")))
+    void signatures_avx2(const uint64_t *masks, size_t count, uint64_t *keys, uint8_t *lengths) {
+        size_t i = 0;
+        uint64_t length_lanes[8];
+        for (; i + 8 <= count; i += 8) {
+            signature4_avx2(masks + i, keys + i, length_lanes);
+            signature4_avx2(masks + i + 4, keys + i + 4, length_lanes + 4);
+            for (int lane = 0; lane < 8; ++lane) { lengths[i + lane] = (uint8_t)length_lanes[lane]; }
+        }
+        signatures_scalar(masks + i, count - i, keys + i, lengths + i);
+    }
+#endif
+}
+
+Classification CombinationTable::classify(const CardSet &cards) {
+    return lookup(signature(cards.get_mask()), cards.size());
+}
+
+CombinationTable::Backend CombinationTable::get_backend() {
+#ifdef TICHU_X86_SIMD
+    static const Backend backend = __builtin_cpu_supports("avx2") ? Backend::AVX2
+                                   : __builtin_cpu_supports("sse4.1") ? Backend::SSE
+                                   : Backend::SCALAR;
+    return backend;
+#else
+    return Backend::SCALAR;
+#endif
+}
+
+void CombinationTable::classify_batch(Backend backend, const uint64_t *masks, size_t count, uint8_t *types,
+                                      int8_t *ranks, uint8_t *lengths) {
+    // signatures are computed in blocks that stay in the L1 cache until they are looked up
+    constexpr size_t block = 256;
+    uint64_t keys[block];
+    uint8_t block_lengths[block];
+
+    for (size_t start = 0; start < count; start += block) {
+        const size_t n = std::min(block, count - start);
+        switch (backend) {
+#ifdef TICHU_X86_SIMD
+            case Backend::AVX2:
+                signatures_avx2(masks + start, n, keys, block_lengths);
+                break;
+            case Backend::SSE:
+                signatures_sse(masks + start, n, keys, block_lengths);
+                break;
+#endif
+            default:
+                signatures_scalar(masks + start, n, keys, block_lengths);
+                break;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            const Classification res = lookup(keys[i], block_lengths[i]);
+            types[start + i] = res.type;
+            ranks[start + i] = res.rank;
+            lengths[start + i] = block_lengths[i];
+        }
+    }
+}
@@ -0,0 +1,96 @@
+/*! \class CombinationTable
+    \brief Classifies a set of cards with a single lookup in a compile-time generated table.
+
+ Whether a set of cards forms a combination only depends on its signature: the number of cards per regular rank,
+ which special cards are present and, for streets, whether all cards share one suit. The signature is computed
+ from the card mask with a few shifts (one nibble per rank holds the count) and looked up in an open addressing
+ hash table that is generated at compile time from the list of all valid combination shapes. Signatures that are
+ not in the table are no combination.
+
+ The table agrees with CardCombination::classify_cards on every input, see the CombinationTable unit tests.
+
+ Large numbers of candidate combinations are classified with classify_batch, which computes the signatures of
+ several masks per instruction with AVX2 or SSE4.1 (whichever the CPU supports, detected at runtime) before the
+ table lookups.
+*/
+
+#ifndef TICHU_COMBINATION_TABLE_H
+#define TICHU_COMBINATION_TABLE_H
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include "card.h"
+#include "card_set.h"
+#include "card_combination.h"
+
+/**
+ * \struct Classification
+ * \brief The COMBI type, rank and number of cards of a set of cards.
+ */
+struct Classification {
+    uint8_t type;
+    int8_t rank;
+    uint8_t length;
+};
+
+class CombinationTable {
+
+public:
+    /**
+     * \enum Backend
+     * \brief The instruction sets classify_batch can compute the signatures with.
+     */
+    enum class Backend {
+        SCALAR, SSE, AVX2
+    };
+
+    static constexpr int table_bits = 12;
+    static constexpr uint64_t same_suit_flag = 1ull << card_table::nof_cards;
+
+    /**
+     * \brief Returns the signature of a card mask.
+     *
+     * Nibble r - 1 holds the number of cards of rank r, the lowest nibble holds the special cards as they are. The
+     * same_suit_flag is set for sets of at least 5 regular cards of a single suit, the only case where suits matter.
+     */
+    static constexpr uint64_t signature(uint64_t mask) {
+        uint64_t counts = mask - ((mask >> 1) & 0x5555555555555555ull);
+        counts = (counts & 0x3333333333333333ull) + ((counts >> 2) & 0x3333333333333333ull);
+        uint64_t key = (counts & ~CardSet::special_mask) | (mask & CardSet::special_mask);
+
+        if ((mask & CardSet::special_mask) == 0 && std::popcount(mask) >= 5) {
+            for (int suit = 0; suit < card_table::nof_suits; ++suit) {
+                if ((mask & ~(CardSet::nibble_mask << suit)) == 0) { key |= same_suit_flag; }
+            }
+        }
+        return key;
+    }
+
+    /**
+     * \brief Classifies the cards, NONE if they do not form a combination.
+     */
+    static Classification classify(const CardSet &cards);
+
+    /**
+     * \brief The fastest backend supported by this CPU.
+     */
+    static Backend get_backend();
+
+    /**
+     * \brief Classifies count card masks at once, the results are written to the parallel arrays types, ranks and
+     * lengths (one entry per mask).
+     */
+    static void classify_batch(const uint64_t *masks, size_t count, uint8_t *types, int8_t *ranks, uint8_t *lengths) {
+        classify_batch(get_backend(), masks, count, types, ranks, lengths);
+    }
+
+    /**
+     * \brief Same as classify_batch, with the given backend. The backend has to be supported by the CPU.
+     */
+    static void classify_batch(Backend backend, const uint64_t *masks, size_t count, uint8_t *types, int8_t *ranks,
+                               uint8_t *lengths);
+};
+
+
+#endif //TICHU_COMBINATION_TABLE_H
@@ -1,17 +1,13 @@
 #include "draw_pile.h"
 
+#include <array>
 #include <utility>
-#include <random>
 
 
-DrawPile::DrawPile(std::vector<Card> cards)
-        : _cards(std::move(cards)) {}
+DrawPile::DrawPile(const std::vector<Card> &cards)
+        : _cards(cards) {}
 
 
-void DrawPile::shuffle() {
-    std::shuffle(_cards.begin(), _cards.end(), std::mt19937(std::random_device()()));
-}
-
 bool DrawPile::is_empty() const noexcept {
     return _cards.empty();
 }
@@ -23,41 +19,34 @@ int DrawPile::get_nof_cards() const noexcept {
 
 #ifdef TICHU_SERVER
 void DrawPile::setup_game(std::string &err) {
-    // remove all cards (if any) and add the change to the "cards" array_diff
-    _cards.clear();
+    // replace all cards (if any) by a fresh set of cards, they are drawn in random order
+    _cards = CardSet::full_deck();
+}
 
-    // add a fresh set of cards
-    for (int card_rank = 1; card_rank <= 14; card_rank++) {
-        for (int card_suit = 1; card_suit <= 4; card_suit++) {
-            _cards.push_back(Card(card_rank, card_suit));
-        }
+bool DrawPile::deal(const std::vector<player_ptr> &players, int nof_cards, Xoshiro256 &rng, std::string &err) {
+    const int nof_dealt = (int)players.size() * nof_cards;
+    const int nof_left = _cards.size();
+    if (nof_dealt > nof_left) {
+        err = "Could not deal the cards because the draw pile has too few cards.";
+        return false;
     }
-    // shuffle them
-    this->shuffle();
-}
 
-std::optional<Card> DrawPile::draw(Player &Player, std::string &err)  {
-    if (!_cards.empty()) {
-        auto drawn_card = _cards.back();
-        if (Player.add_card_to_hand(drawn_card, err)) {
-            _cards.pop_back();
-            return drawn_card;
-        }
-    } else {
-        err = "Could not draw card because draw pile is empty.";
+    std::array<Card, card_table::nof_cards> cards;
+    int pos = 0;
+    for (Card card: _cards) { cards[pos++] = card; }
+    // position i gets a uniformly random card of the ones behind it, only the dealt positions are shuffled
+    for (int i = 0; i < nof_dealt; ++i) {
+        std::swap(cards[i], cards[i + rng.below(nof_left - i)]);
     }
-    return {};
-}
 
-std::optional<Card> DrawPile::remove_top(std::string& err) {
-    if (!_cards.empty()) {
-        auto drawn_card = _cards.back();
-        _cards.pop_back();
-        return drawn_card;
-    } else {
-        err = "Could not draw card because draw pile is empty.";
-        return {};
+    bool res = true;
+    for (int i = 0; i < (int)players.size(); ++i) {
+        CardSet dealt;
+        for (int j = 0; j < nof_cards; ++j) { dealt.insert(cards[i * nof_cards + j]); }
+        _cards -= dealt;
+        res &= players[i]->add_cards_to_hand(dealt, err);
     }
+    return res;
 }
 
 #endif
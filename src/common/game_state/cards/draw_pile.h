@@ -3,13 +3,16 @@
     
  The DrawPile is needed to set up a round and distribute the cards to the players randomly. As soon as
  all 4 players have 14 cards, the pile must be empty and the object has no further function until the 
- next round is started.
+ next round is started. The cards are dealt with the random generator of the game, so a game replays
+ the same deals from the same seed.
 */
 
 #ifndef TICHU_DRAW_PILE_H
 #define TICHU_DRAW_PILE_H
 
 #include "card.h"
+#include "card_set.h"
+#include "xoshiro256.h"
 #include <vector>
 #include <string>
 #include <algorithm>
@@ -19,21 +22,19 @@
 
 class DrawPile {
 private:
-    std::vector<Card> _cards;
-
-    void shuffle();
+    CardSet _cards;
 
 public:
 // constructors
     DrawPile() = default;
 
-    explicit DrawPile(std::vector<Card> cards);
+    explicit DrawPile(const std::vector<Card> &cards);
 
 
 // accessors
     [[nodiscard]] bool is_empty() const noexcept;
     [[nodiscard]] int get_nof_cards() const noexcept;
-    [[nodiscard]] const std::vector<Card> &get_cards() const { return _cards; }
+    [[nodiscard]] std::vector<Card> get_cards() const { return _cards.to_vector(); }
 
 #ifdef TICHU_SERVER
     // state update functions
@@ -41,8 +42,13 @@ public:
          * Fills the stack with all cards of the game
         */
         void setup_game(std::string& err); 
-        std::optional<Card> draw(Player &Player, std::string& err);
-        std::optional<Card> remove_top(std::string& err);
+        /**
+         * \brief Deals nof_cards random cards from the pile to each player.
+         *
+         * A single partial Fisher-Yates pass over the cards of the pile picks the cards of all players, each
+         * player receives them in one bulk add to the hand.
+         */
+        bool deal(const std::vector<player_ptr> &players, int nof_cards, Xoshiro256 &rng, std::string& err);
 #endif
 
     NLOHMANN_DEFINE_TYPE_INTRUSIVE(DrawPile, _cards);
@@ -0,0 +1,369 @@
+#include "hand_partition.h"
+
+#include <algorithm>
+#include <bit>
+#include <unordered_map>
+
+namespace {
+
+    // the search compares partitions by a single cost: combinations first, then bombs, then control
+    constexpr int32_t combination_cost = 1 << 16;
+    constexpr int32_t bomb_bonus = 1 << 10;
+
+    constexpr int phoenix_control = 15;
+    constexpr int dragon_control = 16;
+
+    // count vectors up to this many states are memoized in a flat table, larger ones in a hash map
+    constexpr uint64_t max_dense_states = 1 << 18;
+
+    enum class Kind : uint8_t { NONE, SINGLE, DOUBLE, TRIPLE, FULLHOUSE, STREET, STAIRS };
+
+    // a combination of the count vector: ranks low to high (the triple and the double of a full house)
+    struct Choice {
+        Kind kind = Kind::NONE;
+        uint8_t low = 0;
+        uint8_t high = 0;
+    };
+
+    struct Entry {
+        uint32_t stamp = 0;
+        int32_t cost = 0;
+        Choice choice;
+    };
+
+    using Counts = std::array<uint8_t, ACE + 1>;
+
+    class Solver {
+
+    private:
+        Counts _counts{};
+        std::array<uint64_t, ACE + 2> _radix{};
+        uint64_t _index = 0;
+        int _phoenix = 0;
+        uint32_t _stamp = 1;
+        bool _dense = true;
+        std::vector<Entry> _table;
+        std::unordered_map<uint64_t, Entry> _map;
+
+        Entry &lookup() {
+            if (!_dense) { return _map[_index]; }
+            return _table[_index];
+        }
+
+        // the number of cards the Phoenix has to complete the choice with
+        int missing(const Choice &choice) const {
+            switch (choice.kind) {
+                case Kind::SINGLE: return 0;
+                case Kind::DOUBLE: return std::max(0, 2 - _counts[choice.low]);
+                case Kind::TRIPLE: return std::max(0, 3 - _counts[choice.low]);
+                case Kind::FULLHOUSE:
+                    return std::max(0, 3 - _counts[choice.low]) + std::max(0, 2 - _counts[choice.high]);
+                case Kind::STREET: {
+                    int res = 0;
+                    for (int rank = choice.low; rank <= choice.high; ++rank) { res += _counts[rank] == 0; }
+                    return res;
+                }
+                case Kind::STAIRS: {
+                    int res = 0;
+                    for (int rank = choice.low; rank <= choice.high; ++rank) { res += std::max(0, 2 - _counts[rank]); }
+                    return res;
+                }
+                default: return 0;
+            }
+        }
+
+        static int take(const Choice &choice, int rank, int count) {
+            switch (choice.kind) {
+                case Kind::SINGLE: return rank == choice.low ? std::min(count, 1) : 0;
+                case Kind::DOUBLE: return rank == choice.low ? std::min(count, 2) : 0;
+                case Kind::TRIPLE: return rank == choice.low ? std::min(count, 3) : 0;
+                case Kind::FULLHOUSE:
+                    if (rank == choice.low) { return std::min(count, 3); }
+                    return rank == choice.high ? std::min(count, 2) : 0;
+                case Kind::STREET: return rank >= choice.low && rank <= choice.high ? std::min(count, 1) : 0;
+                case Kind::STAIRS: return rank >= choice.low && rank <= choice.high ? std::min(count, 2) : 0;
+                default: return 0;
+            }
+        }
+
+        // the highest rank of the combination, for a full house the rank of the triple
+        static int control(const Choice &choice) {
+            if (choice.kind == Kind::FULLHOUSE || choice.kind == Kind::SINGLE || choice.kind == Kind::DOUBLE
+                || choice.kind == Kind::TRIPLE) {
+                return choice.low;
+            }
+            return choice.high;
+        }
+
+        void remove(const Choice &choice, int phoenix) {
+            for (int rank = choice.low; rank <= std::max(choice.low, choice.high); ++rank) {
+                const int n = take(choice, rank, _counts[rank]);
+                _counts[rank] = (uint8_t)(_counts[rank] - n);
+                _index -= n * _radix[rank];
+            }
+            if (choice.kind == Kind::FULLHOUSE && choice.high < choice.low) {
+                const int n = take(choice, choice.high, _counts[choice.high]);
+                _counts[choice.high] = (uint8_t)(_counts[choice.high] - n);
+                _index -= n * _radix[choice.high];
+            }
+            _phoenix -= phoenix;
+            _index -= phoenix * _radix[ACE + 1];
+        }
+
+        void restore(const Counts &before, uint64_t index, int phoenix) {
+            _counts = before;
+            _index = index;
+            _phoenix = phoenix;
+        }
+
+        void consider(const Choice &choice, int32_t &best, Choice &best_choice) {
+            const int phoenix = missing(choice);
+            if (phoenix > _phoenix) { return; }
+            const Counts before = _counts;
+            const uint64_t index = _index;
+            const int phoenix_before = _phoenix;
+            remove(choice, phoenix);
+            const int32_t cost = combination_cost - control(choice) + search();
+            restore(before, index, phoenix_before);
+            if (cost < best) {
+                best = cost;
+                best_choice = choice;
+            }
+        }
+
+        void enumerate(int32_t &best, Choice &best_choice) {
+            int low = SPECIAL;
+            while (_counts[low] == 0) { ++low; }
+            const int count = _counts[low];
+            auto add = [&](Kind kind, int from, int to) {
+                consider({kind, (uint8_t)from, (uint8_t)to}, best, best_choice);
+            };
+
+            add(Kind::SINGLE, low, low);
+
+            // streets start at the lowest rank or with the Phoenix right below it, the Phoenix only goes below the
+            // lowest card if the street ends with the ace, otherwise it is played on top of the street
+            for (int start = low - _phoenix; start <= low; ++start) {
+                if (start < low && start < TWO) { continue; }
+                int gaps = 0;
+                for (int end = start; end <= ACE; ++end) {
+                    gaps += _counts[end] == 0;
+                    if (gaps > _phoenix) { break; }
+                    if (end - start + 1 < 5) { continue; }
+                    if (start < low && end != ACE) { continue; }
+                    add(Kind::STREET, start, end);
+                }
+            }
+
+            // the Majong is only a single or the start of a street
+            if (low == SPECIAL) { return; }
+
+            if (count + _phoenix >= 2) { add(Kind::DOUBLE, low, low); }
+            if (count + _phoenix >= 3) { add(Kind::TRIPLE, low, low); }
+
+            // full houses with the lowest rank as the triple or as the double. With two doubles the Phoenix
+            // completes the higher one, so the lower double is never the triple of a full house with the Phoenix.
+            for (int other = low + 1; other <= ACE; ++other) {
+                if (_counts[other] == 0) { continue; }
+                if (count >= 3) { add(Kind::FULLHOUSE, low, other); }
+                if (_counts[other] >= 2) { add(Kind::FULLHOUSE, other, low); }
+            }
+
+            // stairs of consecutive doubles, the Phoenix completes one of them
+            int missing_cards = 0;
+            for (int end = low; end <= ACE && _counts[end] > 0; ++end) {
+                missing_cards += std::max(0, 2 - _counts[end]);
+                if (missing_cards > _phoenix) { break; }
+                if (end > low) { add(Kind::STAIRS, low, end); }
+            }
+        }
+
+    public:
+        // prepares the table for the counts and the Phoenix, the ranks of a later search can only be lower
+        void reset(const Counts &counts, int phoenix) {
+            uint64_t states = 1;
+            for (int rank = SPECIAL; rank <= ACE; ++rank) {
+                _radix[rank] = states;
+                states *= counts[rank] + 1;
+            }
+            _radix[ACE + 1] = states;
+            states *= phoenix + 1;
+
+            _dense = states <= max_dense_states;
+            if (_dense) {
+                if (_table.size() < states) { _table.resize(states); }
+                if (++_stamp == 0) {
+                    std::fill(_table.begin(), _table.end(), Entry{});
+                    _stamp = 1;
+                }
+            } else {
+                _map.clear();
+            }
+        }
+
+        void set(const Counts &counts, int phoenix) {
+            _counts = counts;
+            _phoenix = phoenix;
+            _index = phoenix * _radix[ACE + 1];
+            for (int rank = SPECIAL; rank <= ACE; ++rank) { _index += counts[rank] * _radix[rank]; }
+        }
+
+        int32_t search() {
+            Entry &entry = lookup();
+            if (entry.stamp == _stamp) { return entry.cost; }
+
+            int32_t best = 0;
+            Choice best_choice;
+            if (std::all_of(_counts.begin(), _counts.end(), [](uint8_t count) { return count == 0; })) {
+                // a Phoenix left over is a single
+                best = _phoenix ? combination_cost - phoenix_control : 0;
+            } else {
+                best = INT32_MAX;
+                enumerate(best, best_choice);
+            }
+
+            // the table may have grown in a hash map, look the entry up again
+            Entry &res = lookup();
+            res.stamp = _stamp;
+            res.cost = best;
+            res.choice = best_choice;
+            return best;
+        }
+
+        [[nodiscard]] Choice get_choice() { return lookup().choice; }
+
+        // the number of cards of each rank the best choice takes, and the Phoenix it needs
+        int advance(const Choice &choice, Counts &taken) {
+            const int phoenix = missing(choice);
+            for (int rank = SPECIAL; rank <= ACE; ++rank) { taken[rank] = (uint8_t)take(choice, rank, _counts[rank]); }
+            remove(choice, phoenix);
+            return phoenix;
+        }
+
+        [[nodiscard]] int get_phoenix() const { return _phoenix; }
+
+        [[nodiscard]] bool empty() const {
+            return std::all_of(_counts.begin(), _counts.end(), [](uint8_t count) { return count == 0; });
+        }
+
+        static int get_control(const Choice &choice) { return control(choice); }
+    };
+
+    // the ranks the count vector is built from: the Majong counts as rank 1, the other special cards are left out
+    Counts count_ranks(uint64_t cards) {
+        Counts res{};
+        const CardSet set(cards);
+        res[SPECIAL] = set.contains(ONE) ? 1 : 0;
+        for (int rank = TWO; rank <= ACE; ++rank) { res[rank] = (uint8_t)set.count_rank(rank); }
+        return res;
+    }
+
+    uint64_t rank_cards(int rank) {
+        if (rank == SPECIAL) { return CardSet(ONE).get_mask(); }
+        return 0xFull << ((rank - 1) * card_table::nof_suits);
+    }
+
+    // every four of a kind and every run of at least 5 cards within a street of one suit
+    std::vector<uint64_t> find_bombs(const CardSet &cards) {
+        std::vector<uint64_t> res;
+        for (int rank = TWO; rank <= ACE; ++rank) {
+            if (cards.count_rank(rank) == card_table::nof_suits) { res.push_back(rank_cards(rank)); }
+        }
+        for (int suit = GREEN; suit <= SCHWARZ; ++suit) {
+            const uint16_t ranks = cards.suit_rank_mask(suit);
+            for (int low = TWO; low <= ACE - 4; ++low) {
+                uint64_t street = 0;
+                for (int high = low; high <= ACE && ((ranks >> (high - 1)) & 1); ++high) {
+                    street |= 1ull << card_table::id_of(high, suit);
+                    if (high - low >= 4) { res.push_back(street); }
+                }
+            }
+        }
+        return res;
+    }
+
+    int highest_rank(uint64_t cards) {
+        return (int)(std::bit_width(cards) - 1) / card_table::nof_suits + 1;
+    }
+
+    // tries every set of disjoint bombs, the rest of the cards is partitioned by the solver
+    struct BombSearch {
+        Solver &solver;
+        const std::vector<uint64_t> &bombs;
+        uint64_t regular;
+        int phoenix;
+        int32_t best = INT32_MAX;
+        std::vector<uint64_t> chosen;
+        std::vector<uint64_t> best_chosen;
+
+        void run(size_t next, uint64_t used, int32_t bomb_cost) {
+            solver.set(count_ranks(regular & ~used), phoenix);
+            const int32_t cost = bomb_cost + solver.search();
+            if (cost < best) {
+                best = cost;
+                best_chosen = chosen;
+            }
+            for (size_t i = next; i < bombs.size(); ++i) {
+                if (bombs[i] & used) { continue; }
+                chosen.push_back(bombs[i]);
+                run(i + 1, used | bombs[i], bomb_cost + combination_cost - bomb_bonus - highest_rank(bombs[i]));
+                chosen.pop_back();
+            }
+        }
+    };
+}
+
+void HandPartition::add_group(uint64_t cards, bool is_bomb, int control) {
+    _groups[_nof_groups++] = cards;
+    _nof_bombs += is_bomb;
+    _control = (int16_t)(_control + control);
+}
+
+HandPartition HandPartition::solve(const CardSet &cards) {
+    thread_local Solver solver;
+    HandPartition res;
+
+    const uint64_t specials = CardSet(HUND).get_mask() | CardSet(DRAGON).get_mask() | CardSet(PHONIX).get_mask();
+    const uint64_t regular = cards.get_mask() & ~specials;
+    const int phoenix = cards.contains(PHONIX) ? 1 : 0;
+
+    const std::vector<uint64_t> bombs = find_bombs(cards);
+    solver.reset(count_ranks(regular), phoenix);
+    BombSearch bomb_search{solver, bombs, regular, phoenix};
+    bomb_search.run(0, 0, 0);
+
+    if (cards.contains(HUND)) { res.add_group(CardSet(HUND).get_mask(), false, 0); }
+
+    // follow the best choices from the counts left after the bombs, the cards of each rank are taken in suit order
+    uint64_t left = regular;
+    for (uint64_t bomb: bomb_search.best_chosen) { left &= ~bomb; }
+    solver.set(count_ranks(left), phoenix);
+    while (!solver.empty()) {
+        solver.search();
+        const Choice choice = solver.get_choice();
+        Counts taken{};
+        uint64_t group = solver.advance(choice, taken) ? CardSet(PHONIX).get_mask() : 0;
+        for (int rank = SPECIAL; rank <= ACE; ++rank) {
+            uint64_t available = left & rank_cards(rank);
+            for (int i = 0; i < taken[rank]; ++i) {
+                const uint64_t card = available & -available;
+                group |= card;
+                available ^= card;
+            }
+        }
+        left &= ~group;
+        res.add_group(group, false, Solver::get_control(choice));
+    }
+    if (solver.get_phoenix()) { res.add_group(CardSet(PHONIX).get_mask(), false, phoenix_control); }
+    if (cards.contains(DRAGON)) { res.add_group(CardSet(DRAGON).get_mask(), false, dragon_control); }
+
+    for (uint64_t bomb: bomb_search.best_chosen) { res.add_group(bomb, true, highest_rank(bomb)); }
+    return res;
+}
+
+std::vector<CardCombination> HandPartition::get_combinations() const {
+    std::vector<CardCombination> res;
+    res.reserve(_nof_groups);
+    for (int i = 0; i < _nof_groups; ++i) { res.emplace_back(CardSet(_groups[i]).to_vector()); }
+    return res;
+}
@@ -0,0 +1,69 @@
+/*! \class HandPartition
+    \brief Splits a hand into the fewest combinations it can be played out with.
+
+ The number of combinations a hand needs to get rid of all its cards is the basic measure of its strength. The
+ solver searches over the per-rank count vector of the regular cards (and the Majong): the lowest remaining rank
+ has to be part of some combination, so only the combinations starting at that rank are tried. Results are
+ memoized per count vector and per use of the Phoenix, which can complete any combination except a bomb or stay
+ a single. The Dog and the Dragon are always played alone.
+
+ Bombs are chosen before the search, as the count vector does not know the suits. Every set of disjoint bombs of
+ the hand is tried and the rest of the cards is partitioned.
+
+ Partitions with the same number of combinations are ranked by the number of bombs kept intact and then by the
+ control of the hand, the sum of the highest rank of each combination. High cards that lead a combination of
+ their own are worth more than high cards that only end a street.
+*/
+
+#ifndef TICHU_HAND_PARTITION_H
+#define TICHU_HAND_PARTITION_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "card_set.h"
+#include "card_combination.h"
+
+class HandPartition {
+
+public:
+    static constexpr int max_groups = card_table::nof_cards;
+
+private:
+    std::array<uint64_t, max_groups> _groups{};
+    uint8_t _nof_groups = 0;
+    uint8_t _nof_bombs = 0;
+    int16_t _control = 0;
+
+    void add_group(uint64_t cards, bool is_bomb, int control);
+
+public:
+
+    /**
+     * \brief Returns the best partition of the cards, a hand of 14 cards takes a few microseconds.
+     */
+    static HandPartition solve(const CardSet &cards);
+
+    /**
+     * \brief The number of combinations of the partition.
+     */
+    [[nodiscard]] int size() const noexcept { return _nof_groups; }
+
+    [[nodiscard]] int get_nof_bombs() const noexcept { return _nof_bombs; }
+
+    /**
+     * \brief Sum of the highest rank of each combination (Phoenix 15, Dragon 16, Dog 0).
+     */
+    [[nodiscard]] int get_control() const noexcept { return _control; }
+
+    /**
+     * \brief The cards of the i-th combination. The Dog comes first, the bombs last, the other combinations are
+     * ordered by their lowest card.
+     */
+    [[nodiscard]] CardSet get_group(int i) const { return CardSet(_groups.at(i)); }
+
+    [[nodiscard]] std::vector<CardCombination> get_combinations() const;
+};
+
+
+#endif //TICHU_HAND_PARTITION_H
@@ -0,0 +1,294 @@
+#include "move_generator.h"
+#include "combination_table.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+
+namespace {
+    constexpr uint64_t phoenix_bit = 1ull << PHONIX.get_id();
+    constexpr uint64_t majong_bit = 1ull << ONE.get_id();
+
+    // run_masks[length][start] is the rank mask (bit r = rank r) of the run start .. start + length - 1
+    constexpr std::array<std::array<uint16_t, ACE + 1>, ACE + 1> make_run_masks() {
+        std::array<std::array<uint16_t, ACE + 1>, ACE + 1> res{};
+        for (int length = 1; length <= ACE; ++length) {
+            for (int start = SPECIAL; start + length - 1 <= ACE; ++start) {
+                res[length][start] = (uint16_t)(((1u << length) - 1) << start);
+            }
+        }
+        return res;
+    }
+
+    constexpr auto run_masks = make_run_masks();
+
+    // the cards of the given rank, for SPECIAL only the Majong is part of a rank
+    uint64_t rank_cards(uint64_t hand, int rank) {
+        if (rank == SPECIAL) { return hand & majong_bit; }
+        return hand & (0xFull << ((rank - 1) * card_table::nof_suits));
+    }
+
+    // the rules of CardCombination::can_be_played_on on the keys of two combinations, the first is a valid one
+    bool can_be_played_on(uint64_t cards, uint32_t key, uint32_t top_key) {
+        if (!top_key) { return true; }
+        const int type = (int)(key >> 16);
+        const int top_type = (int)(top_key >> 16);
+        if (top_type == MAJONG && type == SINGLE) { return true; }
+        if (top_type == SWITCH) { return true; }
+        if (type == BOMB) { return top_type != BOMB || key > top_key; }
+        // a single Phoenix beats every single but the Dragon
+        if (cards == phoenix_bit) { return top_type == SINGLE && (int)(top_key & 0xFF) - 1 != 15; }
+        return (key >> 8) == (top_key >> 8) && key > top_key;
+    }
+}
+
+MoveGenerator::Options MoveGenerator::subsets(uint64_t cards, int k) {
+    Options res;
+    for (uint64_t sub = cards; sub; sub = (sub - 1) & cards) {
+        if (std::popcount(sub) == k) { res.masks[res.count++] = sub; }
+    }
+    return res;
+}
+
+void MoveGenerator::add_products(const Options *options, int nof_options, uint64_t base) {
+    // odometer over one option per entry
+    std::array<int, ACE + 1> idx{};
+    for (int i = 0; i < nof_options; ++i) {
+        if (!options[i].count) { return; }
+    }
+    while (true) {
+        uint64_t mask = base;
+        for (int i = 0; i < nof_options; ++i) { mask |= options[i].masks[idx[i]]; }
+        _candidates.push_back(mask);
+
+        int i = 0;
+        while (i < nof_options && ++idx[i] == options[i].count) {
+            idx[i] = 0;
+            ++i;
+        }
+        if (i == nof_options) { return; }
+    }
+}
+
+void MoveGenerator::add_singles() {
+    for (uint64_t cards = _hand; cards; cards &= cards - 1) {
+        _candidates.push_back(cards & -cards);
+    }
+}
+
+void MoveGenerator::add_same_rank(int size) {
+    const uint64_t hand = _hand;
+    for (int rank = TWO; rank <= ACE; ++rank) {
+        uint64_t cards = rank_cards(hand, rank);
+        const Options plain = subsets(cards, size);
+        for (int i = 0; i < plain.count; ++i) { _candidates.push_back(plain.masks[i]); }
+        if (hand & phoenix_bit) {
+            const Options with_phoenix = subsets(cards, size - 1);
+            for (int i = 0; i < with_phoenix.count; ++i) { _candidates.push_back(with_phoenix.masks[i] | phoenix_bit); }
+        }
+    }
+}
+
+void MoveGenerator::add_bombs() {
+    const uint64_t hand = _hand;
+    for (int rank = TWO; rank <= ACE; ++rank) {
+        uint64_t cards = rank_cards(hand, rank);
+        if (std::popcount(cards) == card_table::nof_suits) { _candidates.push_back(cards); }
+    }
+    add_streets(true);
+}
+
+void MoveGenerator::add_fullhouses() {
+    const uint64_t hand = _hand;
+    const bool has_phoenix = hand & phoenix_bit;
+    for (int triple = TWO; triple <= ACE; ++triple) {
+        uint64_t triple_cards = rank_cards(hand, triple);
+        if (std::popcount(triple_cards) < (has_phoenix ? 2 : 3)) { continue; }
+        for (int pair = TWO; pair <= ACE; ++pair) {
+            uint64_t pair_cards = rank_cards(hand, pair);
+            if (pair == triple || !pair_cards) { continue; }
+
+            const Options plain[2] = {subsets(triple_cards, 3), subsets(pair_cards, 2)};
+            add_products(plain, 2, 0);
+            if (has_phoenix) {
+                const Options short_triple[2] = {subsets(triple_cards, 2), subsets(pair_cards, 2)};
+                const Options short_pair[2] = {subsets(triple_cards, 3), subsets(pair_cards, 1)};
+                add_products(short_triple, 2, phoenix_bit);
+                add_products(short_pair, 2, phoenix_bit);
+            }
+        }
+    }
+}
+
+void MoveGenerator::add_streets(bool bombs_only) {
+    const uint64_t hand = _hand;
+    const bool has_phoenix = hand & phoenix_bit;
+
+    uint16_t present = 0;
+    for (int rank = SPECIAL; rank <= ACE; ++rank) {
+        if (rank_cards(hand, rank)) { present |= (uint16_t)(1u << rank); }
+    }
+
+    std::array<Options, ACE + 1> options;
+    for (int length = 5; length <= ACE; ++length) {
+        for (int start = SPECIAL; start + length - 1 <= ACE; ++start) {
+            const uint16_t run = run_masks[length][start];
+            const uint16_t missing = run & ~present;
+            if (std::popcount(missing) > (has_phoenix && !bombs_only ? 1 : 0)) { continue; }
+
+            if (bombs_only) {
+                // street bombs consist of regular cards of a single suit
+                if (start == SPECIAL) { continue; }
+                for (int suit = GREEN; suit <= SCHWARZ; ++suit) {
+                    uint64_t street = 0;
+                    for (int rank = start; rank < start + length; ++rank) {
+                        street |= hand & (1ull << card_table::id_of(rank, suit));
+                    }
+                    if (std::popcount(street) == length) { _candidates.push_back(street); }
+                }
+                continue;
+            }
+
+            for (int rank = start; rank < start + length; ++rank) {
+                options[rank - start] = subsets(rank_cards(hand, rank), 1);
+            }
+            if (!missing) { add_products(options.data(), length, 0); }
+            if (!has_phoenix) { continue; }
+
+            // the Phoenix substitutes the missing rank or, if nothing is missing, any rank but the Majong
+            for (int rank = std::max(start, (int)TWO); rank < start + length; ++rank) {
+                if (missing && !(missing & (1u << rank))) { continue; }
+                const Options replaced = options[rank - start];
+                options[rank - start] = Options{1, {0}};
+                add_products(options.data(), length, phoenix_bit);
+                options[rank - start] = replaced;
+            }
+        }
+    }
+}
+
+void MoveGenerator::add_stairs() {
+    const uint64_t hand = _hand;
+    const bool has_phoenix = hand & phoenix_bit;
+
+    std::array<Options, ACE + 1> options;
+    for (int length = 2; length <= ACE - 1; ++length) {
+        for (int start = TWO; start + length - 1 <= ACE; ++start) {
+            int nof_short = 0;
+            for (int rank = start; rank < start + length; ++rank) {
+                int count = std::popcount(rank_cards(hand, rank));
+                if (count < 2) { ++nof_short; }
+                if (count == 0) { nof_short = length + 1; }
+                options[rank - start] = subsets(rank_cards(hand, rank), 2);
+            }
+            if (nof_short > (has_phoenix ? 1 : 0)) { continue; }
+
+            if (nof_short == 0) { add_products(options.data(), length, 0); }
+            if (!has_phoenix) { continue; }
+
+            // the Phoenix completes one of the doubles
+            for (int rank = start; rank < start + length; ++rank) {
+                if (nof_short == 1 && options[rank - start].count) { continue; }
+                const Options replaced = options[rank - start];
+                options[rank - start] = subsets(rank_cards(hand, rank), 1);
+                add_products(options.data(), length, phoenix_bit);
+                options[rank - start] = replaced;
+            }
+        }
+    }
+}
+
+void MoveGenerator::collect(uint32_t top_key, int wish, std::vector<LegalPlay> &plays) {
+    std::sort(_candidates.begin(), _candidates.end());
+    _candidates.erase(std::unique(_candidates.begin(), _candidates.end()), _candidates.end());
+
+    // most candidates are no combination at all, they are dropped before their key is built
+    const size_t count = _candidates.size();
+    _types.resize(count);
+    _ranks.resize(count);
+    _lengths.resize(count);
+    CombinationTable::classify_batch(_candidates.data(), count, _types.data(), _ranks.data(), _lengths.data());
+
+    const int top_type = (int)(top_key >> 16);
+    for (size_t i = 0; i < count; ++i) {
+        if (_types[i] == NONE) { continue; }
+        uint32_t key = CardCombination::pack(_types[i], _lengths[i], _ranks[i]);
+        if (!can_be_played_on(_candidates[i], key, top_key)) { continue; }
+        // a single Phoenix takes the rank of the single card it is played on
+        if (_candidates[i] == phoenix_bit) {
+            key = CardCombination::pack(SINGLE, 1, top_type == SINGLE ? (int)(top_key & 0xFF) - 1 : -1);
+        }
+        plays.push_back({_candidates[i], key});
+    }
+
+    // the wished for rank has to be played if possible
+    if (wish) {
+        const uint64_t wished = rank_cards(~0ull, wish);
+        auto fulfils = [wished](const LegalPlay &play) { return (play.cards & wished) != 0; };
+        if (std::any_of(plays.begin(), plays.end(), fulfils)) {
+            std::erase_if(plays, [&](const LegalPlay &play) { return !fulfils(play); });
+            return;
+        }
+    }
+
+    // the player leading a trick has to play something
+    if (top_key) { plays.push_back({0, CardCombination::pack(PASS, 0, 0)}); }
+}
+
+void MoveGenerator::get_legal_plays(uint64_t hand, uint32_t top_key, int wish, std::vector<LegalPlay> &plays) {
+    // the buffers of the generator only grow, they are kept per thread
+    thread_local MoveGenerator generator;
+    generator._hand = hand;
+    generator._candidates.clear();
+    plays.clear();
+
+    const int top_type = top_key ? (int)(top_key >> 16) : NONE;
+    if (!top_key || top_type == SWITCH) {
+        generator.add_singles();
+        generator.add_same_rank(2);
+        generator.add_same_rank(3);
+        generator.add_fullhouses();
+        generator.add_streets(false);
+        generator.add_stairs();
+    } else {
+        switch (top_type) {
+            case SINGLE:
+            case MAJONG:
+                generator.add_singles();
+                break;
+            case DOUBLE:
+                generator.add_same_rank(2);
+                break;
+            case TRIPLE:
+                generator.add_same_rank(3);
+                break;
+            case FULLHOUSE:
+                generator.add_fullhouses();
+                break;
+            case STRASS:
+                generator.add_streets(false);
+                break;
+            case TREPPE:
+                generator.add_stairs();
+                break;
+            default:
+                break;
+        }
+    }
+    generator.add_bombs();
+
+    generator.collect(top_key, wish, plays);
+}
+
+std::vector<CardCombination> MoveGenerator::get_legal_moves(const CardSet &hand, const std::optional<CardCombination> &top,
+                                                           const std::optional<Card> &wish) {
+    std::vector<LegalPlay> plays;
+    get_legal_plays(hand.get_mask(), top ? top->get_key() : 0, wish ? wish->get_rank() : 0, plays);
+
+    std::vector<CardCombination> moves;
+    moves.reserve(plays.size());
+    for (const LegalPlay &play: plays) {
+        moves.push_back(CardCombination(CardSet(play.cards).to_vector()).played_on(top));
+    }
+    return moves;
+}
@@ -0,0 +1,97 @@
+/*! \class MoveGenerator
+    \brief Lists all combinations a player may legally play.
+
+ Given the cards of a hand, the top combination of the ActivePile and the active wish, the MoveGenerator
+ enumerates every distinct set of cards that forms a valid combination and can be played on the top combination.
+ Candidates are built per combination type from the rank histogram of the hand and precomputed rank-run tables
+ instead of classifying every subset of the hand. Only the combination types that could beat the top combination
+ (plus bombs) are enumerated.
+
+ If there is an active wish and the hand can play a combination containing the wished rank, only those
+ combinations are returned, as the player is obliged to fulfill the wish.
+
+ get_legal_plays works on card masks and combination keys only. The candidates are kept in buffers of the calling
+ thread, so once they have grown it lists the plays without allocating, which is what searches playing millions
+ of moves use. get_legal_moves builds a CardCombination of every play found by get_legal_plays.
+*/
+
+#ifndef TICHU_MOVE_GENERATOR_H
+#define TICHU_MOVE_GENERATOR_H
+
+#include <optional>
+#include <vector>
+#include "card.h"
+#include "card_set.h"
+#include "card_combination.h"
+#include "../player/hand.h"
+
+/**
+ * \struct LegalPlay
+ * \brief A legal combination as plain data, its cards and CardCombination::get_key() as it lies on the trick.
+ */
+struct LegalPlay {
+    uint64_t cards;
+    uint32_t key;
+};
+
+class MoveGenerator {
+
+private:
+    // the subsets of the cards of one rank a candidate can take, at most the 6 pairs out of 4 cards
+    struct Options {
+        int count = 0;
+        uint64_t masks[6]{};
+    };
+
+    uint64_t _hand{};
+    std::vector<uint64_t> _candidates;
+    std::vector<uint8_t> _types;
+    std::vector<int8_t> _ranks;
+    std::vector<uint8_t> _lengths;
+
+    static Options subsets(uint64_t cards, int k);
+
+    // candidate generation per combination type, the candidates are stored as card masks
+    void add_singles();
+    void add_same_rank(int size);
+    void add_bombs();
+    void add_fullhouses();
+    void add_streets(bool bombs_only);
+    void add_stairs();
+
+    void add_products(const Options *options, int nof_options, uint64_t base);
+
+    void collect(uint32_t top_key, int wish, std::vector<LegalPlay> &plays);
+
+public:
+
+    /**
+     * \brief Fills plays with every combination the hand can legally play on the top combination.
+     *
+     * \param hand The card mask of the player.
+     * \param top_key CardCombination::get_key() of the top combination as it lies on the trick, 0 if the player
+     * leads the trick.
+     * \param wish The wished for rank, 0 if there is no wish.
+     * \param plays Cleared and filled with the same plays as get_legal_moves, in the same order. A PASS has no cards.
+     */
+    static void get_legal_plays(uint64_t hand, uint32_t top_key, int wish, std::vector<LegalPlay> &plays);
+
+    /**
+     * \brief Returns every combination the hand can legally play on the top combination.
+     *
+     * \param hand The cards of the player.
+     * \param top The top combination of the ActivePile, empty if the player leads the trick.
+     * \param wish The active wish, if any.
+     * \return All legal combinations without duplicates. A PASS is included if the player is allowed to pass.
+     */
+    static std::vector<CardCombination> get_legal_moves(const CardSet &hand, const std::optional<CardCombination> &top,
+                                                        const std::optional<Card> &wish = {});
+
+    static std::vector<CardCombination> get_legal_moves(const hand &hand, const std::optional<CardCombination> &top,
+                                                        const std::optional<Card> &wish = {}) {
+        return get_legal_moves(hand.get_card_set(), top, wish);
+    }
+};
+
+
+#endif //TICHU_MOVE_GENERATOR_H
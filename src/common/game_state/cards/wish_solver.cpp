@@ -0,0 +1,88 @@
+#include "wish_solver.h"
+
+#include <algorithm>
+
+bool WishSolver::can_bomb(const CardSet &hand, const std::optional<CardCombination> &top, int wish) {
+    const bool top_is_bomb = top && top->get_combination_type() == BOMB;
+    const int top_size = top_is_bomb ? (int)top->get_cards().size() : 0;
+    const int top_rank = top_is_bomb ? top->get_combination_rank() : 0;
+
+    // four of a kind
+    if (hand.count_rank(wish) == card_table::nof_suits) {
+        if (!top_is_bomb || (top_size == card_table::nof_suits && wish > top_rank)) { return true; }
+    }
+
+    // street bombs through the wished card of each suit
+    for (int suit = GREEN; suit <= SCHWARZ; ++suit) {
+        if (!hand.contains(Card(wish, suit))) { continue; }
+        int low = wish;
+        int high = wish;
+        while (low > TWO && hand.contains(Card(low - 1, suit))) { --low; }
+        while (high < ACE && hand.contains(Card(high + 1, suit))) { ++high; }
+
+        int longest = high - low + 1;
+        if (longest < 5) { continue; }
+        // any street bomb beats a four of a kind, longer street bombs beat shorter ones
+        if (top_size < 5 || longest > top_size) { return true; }
+        // a street bomb of the same length has to be higher, start it as high as possible
+        if (longest == top_size && std::min(wish, high - top_size + 1) > top_rank) { return true; }
+    }
+    return false;
+}
+
+bool WishSolver::can_fulfill(const CardSet &hand, const std::optional<CardCombination> &top, int wish) {
+    if (wish <= SPECIAL || wish > ACE || hand.count_rank(wish) == 0) { return false; }
+    if (can_bomb(hand, top, wish)) { return true; }
+
+    // leading a trick or playing after the Dog, a single card is enough
+    if (!top || top->get_combination_type() == SWITCH || top->get_combination_type() == MAJONG) { return true; }
+
+    const auto counts = hand.rank_histogram();
+    const int phoenix = hand.contains(PHONIX) ? 1 : 0;
+    const int rank = top->get_combination_rank();
+    const int size = (int)top->get_cards().size();
+
+    switch (top->get_combination_type()) {
+        case SINGLE:
+            return wish > rank;
+
+        case DOUBLE:
+            return wish > rank && counts[wish] + phoenix >= 2;
+
+        case TRIPLE:
+            return wish > rank && counts[wish] + phoenix >= 3;
+
+        case FULLHOUSE:
+            // the wished rank is either the tripple or the double, the Phoenix completes at most one of them
+            for (int triple = std::max(rank + 1, (int)TWO); triple <= ACE; ++triple) {
+                for (int pair = TWO; pair <= ACE; ++pair) {
+                    if (pair == triple || (triple != wish && pair != wish)) { continue; }
+                    int missing = std::max(0, 3 - counts[triple]) + std::max(0, 2 - counts[pair]);
+                    if (missing <= phoenix) { return true; }
+                }
+            }
+            return false;
+
+        case STRASS:
+            // streets of the same length that start higher and contain the wished rank
+            for (int start = std::max(rank + 1, wish - size + 1); start <= std::min(wish, ACE - size + 1); ++start) {
+                int missing = 0;
+                for (int r = start; r < start + size; ++r) { missing += counts[r] == 0; }
+                if (missing <= phoenix) { return true; }
+            }
+            return false;
+
+        case TREPPE: {
+            const int nof_pairs = size / 2;
+            for (int start = std::max(rank + 1, wish - nof_pairs + 1); start <= std::min(wish, ACE - nof_pairs + 1); ++start) {
+                int missing = 0;
+                for (int r = start; r < start + nof_pairs; ++r) { missing += counts[r] == 0 ? 2 : std::max(0, 2 - counts[r]); }
+                if (missing <= phoenix) { return true; }
+            }
+            return false;
+        }
+
+        default:
+            return false;
+    }
+}
@@ -0,0 +1,38 @@
+/*! \class WishSolver
+    \brief Decides whether a hand is obliged to fulfill the Majong wish.
+
+ A player holding the wished for rank has to play it if any legal combination containing it can be played on the
+ current trick. The WishSolver answers this question directly from the rank histogram and the suit masks of the
+ hand, by checking the few combinations of the type of the top combination (and bombs) that could contain the
+ wished rank, instead of enumerating the subsets of the hand.
+
+ The result agrees with filtering the output of the MoveGenerator for the wished rank.
+*/
+
+#ifndef TICHU_WISH_SOLVER_H
+#define TICHU_WISH_SOLVER_H
+
+#include <optional>
+#include "card.h"
+#include "card_set.h"
+#include "card_combination.h"
+
+class WishSolver {
+
+private:
+    static bool can_bomb(const CardSet &hand, const std::optional<CardCombination> &top, int wish);
+
+public:
+
+    /**
+     * \brief Returns true if the hand can legally play a combination containing a card of the wished rank.
+     *
+     * \param hand The cards of the player.
+     * \param top The top combination of the ActivePile, empty if the player leads the trick.
+     * \param wish The wished for rank.
+     */
+    static bool can_fulfill(const CardSet &hand, const std::optional<CardCombination> &top, int wish);
+};
+
+
+#endif //TICHU_WISH_SOLVER_H
@@ -2,15 +2,7 @@
 
 #include <utility>
 
-WonCardsPile::WonCardsPile(std::vector<Card> cards) : _cards(std::move(cards)) {}
-
-int WonCardsPile::get_score() const {
-    int res = 0;
-    for (Card card: _cards) {
-        res += card.get_value();
-    }
-    return res;
-}
+WonCardsPile::WonCardsPile(std::vector<Card> cards) : _cards(cards) {}
 
 #ifdef TICHU_SERVER
 
@@ -19,20 +11,19 @@ void WonCardsPile::wrap_up_round() {
 }
 
 void WonCardsPile::add_card(const Card &new_card) {
-    _cards.push_back(new_card);
+    _cards.insert(new_card);
 }
 
 void WonCardsPile::add_cards(const CardCombination &combi){
-    std::vector<Card> cards = combi.get_cards();
-    for(Card card : cards) {
-        add_card(card);
-    }
+    _cards |= CardSet(combi.get_cards());
 }
 
 void WonCardsPile::add_cards(const std::vector<CardCombination> &combis) {
+    CardSet added;
     for(const CardCombination& combi : combis) {
-        add_cards(combi);
+        added |= CardSet(combi.get_cards());
     }
+    _cards |= added;
 }
 
 
@@ -1,6 +1,8 @@
 /*! \class WonCardsPile
     \brief Represents the pile of cards a player accumulates throughout a round.
-    
+
+ The cards are kept as a CardSet, so the number of cards and the score are popcounts of the mask and adding a
+ trick is a single union.
 */
 
 #ifndef TICHU_WON_CARDS_PILE_H
@@ -8,21 +10,26 @@
 
 #include <vector>
 #include "card.h"
+#include "card_set.h"
 #include "card_combination.h"
 
 class WonCardsPile {
 
 private:
-    std::vector<Card> _cards;
+    CardSet _cards;
 
 public:
     WonCardsPile() = default;
 
     explicit WonCardsPile(std::vector<Card> cards);
 
+    explicit WonCardsPile(const CardSet &cards) : _cards(cards) {}
+
+    [[nodiscard]] const CardSet &get_card_set() const { return _cards; }
+
 // accessors
-    [[nodiscard]] int get_score() const;
-    [[nodiscard]] int get_nof_cards() const { return (int)_cards.size(); }
+    [[nodiscard]] int get_score() const { return _cards.score(); }
+    [[nodiscard]] int get_nof_cards() const { return _cards.size(); }
 
 #ifdef TICHU_SERVER
     // state update functions
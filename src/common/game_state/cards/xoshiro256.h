@@ -0,0 +1,100 @@
+/*! \class Xoshiro256
+    \brief The xoshiro256** pseudo random number generator.
+
+ A small and fast generator with 256 bits of state (by Blackman and Vigna). It is seeded from a single 64-bit seed
+ through splitmix64, so a game whose seed was recorded replays the same team draw and deals. It meets the
+ requirements of a UniformRandomBitGenerator and can be used with std::shuffle and the std distributions, below
+ draws uniform integers without a division in the common case. for_index and shuffle_missing are the seeding and
+ the deal of the samples of the advisor, the simulator and the statistics.
+*/
+
+#ifndef TICHU_XOSHIRO256_H
+#define TICHU_XOSHIRO256_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <random>
+#include "card.h"
+
+class Xoshiro256 {
+
+private:
+    std::array<uint64_t, 4> _state{};
+
+public:
+    using result_type = uint64_t;
+
+    explicit Xoshiro256(uint64_t seed = 0) { this->seed(seed); }
+
+    void seed(uint64_t seed) noexcept {
+        for (uint64_t &word: _state) {
+            uint64_t z = (seed += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    /**
+     * \brief The generator of item index (a sample, game or deal) of a run seeded with seed. Every index has its own
+     * stream, so the results of a run do not depend on the thread that took the index.
+     */
+    static Xoshiro256 for_index(uint64_t seed, uint64_t index) noexcept {
+        return Xoshiro256(seed + index * 0x9E3779B97F4A7C15ull);
+    }
+
+    static constexpr result_type min() { return 0; }
+
+    static constexpr result_type max() { return ~0ull; }
+
+    result_type operator()() noexcept {
+        const uint64_t res = std::rotl(_state[1] * 5, 7) * 9;
+        const uint64_t t = _state[1] << 17;
+        _state[2] ^= _state[0];
+        _state[3] ^= _state[1];
+        _state[1] ^= _state[2];
+        _state[0] ^= _state[3];
+        _state[2] ^= t;
+        _state[3] = std::rotl(_state[3], 45);
+        return res;
+    }
+
+    /**
+     * \brief A uniformly distributed integer in [0, bound), bound has to be positive (Lemire's method).
+     */
+    uint32_t below(uint32_t bound) noexcept {
+        uint64_t product = (uint64_t)(uint32_t)((*this)() >> 32) * bound;
+        if ((uint32_t)product < bound) {
+            const uint32_t threshold = (0u - bound) % bound;
+            while ((uint32_t)product < threshold) {
+                product = (uint64_t)(uint32_t)((*this)() >> 32) * bound;
+            }
+        }
+        return (uint32_t)(product >> 32);
+    }
+
+    /**
+     * \brief Writes the ids of the cards not in mask to deck in random order, returns their number.
+     */
+    int shuffle_missing(uint64_t mask, std::array<uint8_t, card_table::nof_cards> &deck) {
+        int res = 0;
+        for (uint64_t rest = ~mask & ((1ull << card_table::nof_cards) - 1); rest; rest &= rest - 1) {
+            deck[res++] = (uint8_t)std::countr_zero(rest);
+        }
+        std::shuffle(deck.begin(), deck.begin() + res, *this);
+        return res;
+    }
+
+    /**
+     * \brief A fresh seed. The std::random_device is only queried once per thread.
+     */
+    static uint64_t random_seed() {
+        thread_local Xoshiro256 seeds(((uint64_t)std::random_device{}() << 32) ^ std::random_device{}());
+        return seeds();
+    }
+};
+
+
+#endif //TICHU_XOSHIRO256_H
@@ -0,0 +1,285 @@
+#include "endgame_solver.h"
+
+#include <algorithm>
+#include <bit>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace {
+    constexpr int infinity = 30000;
+
+    // the data word of a table entry: the value, the kind of bound and the index of the best move in move order
+    enum Bound : uint64_t { NO_BOUND = 0, EXACT = 1, LOWER = 2, UPPER = 3 };
+    constexpr int no_move = 0xFF;
+
+    constexpr uint64_t pack(int value, Bound bound, int move) {
+        return (uint64_t)(uint16_t)(int16_t)value | ((uint64_t)bound << 16) | ((uint64_t)std::min(move, no_move) << 24);
+    }
+
+    constexpr int unpack_value(uint64_t data) { return (int16_t)(uint16_t)(data & 0xFFFF); }
+
+    constexpr Bound unpack_bound(uint64_t data) { return (Bound)((data >> 16) & 3); }
+
+    constexpr int unpack_move(uint64_t data) { return (int)((data >> 24) & 0xFF); }
+
+    int order_score(const Move &move, uint64_t hand) {
+        if (move.type == MoveType::PASS) { return -infinity; }
+        if (move.type != MoveType::PLAY) { return 0; }
+        const int type = (int)(move.key >> 16);
+        const int length = (int)((move.key >> 8) & 0xFF);
+        const int rank = (int)(move.key & 0xFF);
+        int res = length * 32 - rank;
+        if (move.cards == hand) { res += 10000; }
+        if (type == BOMB) { res -= 1000; }
+        return res;
+    }
+
+    bool is_team_a(int player) { return player % 2 == 0; }
+
+    int score_difference(const GameSnapshot &state) { return state.score_a - state.score_b; }
+}
+
+// the search of one thread, on its own engine and move buffers
+class EndgameSearch {
+
+private:
+    using clock = std::chrono::steady_clock;
+
+    EndgameSolver &_solver;
+    GameEngine _engine;
+    const int _root_difference;
+    std::atomic<bool> &_stop;
+    const clock::time_point _deadline;
+    // one move list per ply, a deque keeps the lists of the lower plies in place while it grows
+    std::deque<std::vector<Move>> _moves;
+    // scratch lists of the move ordering
+    std::vector<std::pair<int, int>> _order;
+    std::vector<Move> _sorted;
+    bool _aborted = false;
+    uint64_t _nodes = 0;
+
+    bool probe(uint64_t key, uint64_t &data) const {
+        const EndgameSolver::Entry &entry = _solver._table[key & _solver._table_mask];
+        data = entry.data.load(std::memory_order_relaxed);
+        const uint64_t check = entry.check.load(std::memory_order_relaxed);
+        return (check ^ data) == key && unpack_bound(data) != NO_BOUND;
+    }
+
+    void store(uint64_t key, uint64_t data) {
+        EndgameSolver::Entry &entry = _solver._table[key & _solver._table_mask];
+        entry.check.store(key ^ data, std::memory_order_relaxed);
+        entry.data.store(data, std::memory_order_relaxed);
+    }
+
+public:
+    EndgameSearch(EndgameSolver &solver, const GameSnapshot &state, std::atomic<bool> &stop,
+                  clock::time_point deadline)
+            : _solver(solver), _engine(state), _root_difference(score_difference(state)), _stop(stop),
+              _deadline(deadline) {}
+
+    [[nodiscard]] GameEngine &get_engine() { return _engine; }
+
+    [[nodiscard]] bool is_aborted() const { return _aborted; }
+
+    [[nodiscard]] uint64_t get_nodes() const { return _nodes; }
+
+    /**
+     * \brief Fills the move list of the ply with the legal moves of the current player in search order, the move
+     * the table holds for the position first.
+     */
+    std::vector<Move> &ordered_moves(int ply, int table_move) {
+        while ((int)_moves.size() <= ply) { _moves.emplace_back(); }
+        std::vector<Move> &moves = _moves[ply];
+        const int player = _engine.get_current_player();
+        _engine.get_legal_moves(player, moves);
+
+        const uint64_t hand = _engine.get_state().hands[player];
+        _order.clear();
+        for (int i = 0; i < (int)moves.size(); ++i) { _order.emplace_back(-order_score(moves[i], hand), i); }
+        std::sort(_order.begin(), _order.end());
+        _sorted.clear();
+        for (const auto &[score, i]: _order) { _sorted.push_back(moves[i]); }
+        moves.swap(_sorted);
+        if (table_move != no_move && table_move < (int)moves.size()) {
+            std::rotate(moves.begin(), moves.begin() + table_move, moves.begin() + table_move + 1);
+        }
+        return moves;
+    }
+
+    // the index in sorted order of the k-th move searched, the move of the table comes first
+    static int sorted_index(int k, int table_move) {
+        if (table_move == no_move) { return k; }
+        if (k == 0) { return table_move; }
+        return k <= table_move ? k - 1 : k;
+    }
+
+    int search(int alpha, int beta, int ply) {
+        if ((++_nodes & 1023) == 0 && clock::now() > _deadline) { _stop.store(true, std::memory_order_relaxed); }
+        if (_stop.load(std::memory_order_relaxed)) {
+            _aborted = true;
+            return 0;
+        }
+
+        const GameSnapshot &state = _engine.get_state();
+        if (state.flags & GameSnapshot::round_finished) { return score_difference(state) - _root_difference; }
+
+        const uint64_t key = state.hash;
+        uint64_t data = 0;
+        int table_move = no_move;
+        if (probe(key, data)) {
+            const int value = unpack_value(data);
+            table_move = unpack_move(data);
+            switch (unpack_bound(data)) {
+                case EXACT: return value;
+                case LOWER: alpha = std::max(alpha, value); break;
+                case UPPER: beta = std::min(beta, value); break;
+                default: break;
+            }
+            if (alpha >= beta) { return value; }
+        }
+
+        const bool maximizing = is_team_a(_engine.get_current_player());
+        std::vector<Move> &moves = ordered_moves(ply, table_move);
+        const int alpha_before = alpha;
+        const int beta_before = beta;
+        int best = maximizing ? -infinity : infinity;
+        int best_move = no_move;
+        for (int k = 0; k < (int)moves.size(); ++k) {
+            const UndoRecord record = _engine.apply(moves[k]);
+            const int value = search(alpha, beta, ply + 1);
+            _engine.undo(record);
+            if (_aborted) { return 0; }
+
+            if (maximizing ? value > best : value < best) {
+                best = value;
+                best_move = sorted_index(k, table_move);
+            }
+            if (maximizing) {
+                alpha = std::max(alpha, value);
+            } else {
+                beta = std::min(beta, value);
+            }
+            if (alpha >= beta) { break; }
+        }
+
+        const Bound bound = best <= alpha_before ? UPPER : best >= beta_before ? LOWER : EXACT;
+        store(key, pack(best, bound, best_move));
+        return best;
+    }
+};
+
+EndgameSolver::EndgameSolver(const Settings &settings) : _settings(settings) {
+    const size_t size = std::bit_ceil(std::max<size_t>(settings.table_size, 1));
+    _table = std::make_unique<Entry[]>(size);
+    _table_mask = size - 1;
+}
+
+void EndgameSolver::clear() {
+    for (uint64_t i = 0; i <= _table_mask; ++i) {
+        _table[i].check.store(0, std::memory_order_relaxed);
+        _table[i].data.store(0, std::memory_order_relaxed);
+    }
+}
+
+EndgameResult EndgameSolver::solve(const GameSnapshot &state) {
+    const auto start = std::chrono::steady_clock::now();
+    const auto deadline = start + _settings.budget;
+    EndgameResult res;
+    std::atomic<bool> stop{false};
+
+    EndgameSearch root(*this, state, stop, deadline);
+    if (state.flags & GameSnapshot::round_finished) {
+        res.complete = true;
+        return res;
+    }
+    const bool maximizing = is_team_a(root.get_engine().get_current_player());
+    const std::vector<Move> moves = root.ordered_moves(0, no_move);
+
+    // the root moves are handed out one by one, each is searched against the best value found so far
+    std::atomic<size_t> next_move{0};
+    std::atomic<int> bound{maximizing ? -infinity : infinity};
+    std::mutex result_mutex;
+    size_t nof_searched = 0;
+    int best_value = maximizing ? -infinity : infinity;
+    size_t best_index = moves.size();
+
+    auto work = [&]() {
+        EndgameSearch search(*this, state, stop, deadline);
+        GameEngine &engine = search.get_engine();
+        for (size_t i = next_move++; i < moves.size(); i = next_move++) {
+            const int current = bound.load();
+            const UndoRecord record = engine.apply(moves[i]);
+            int value = maximizing ? search.search(current, infinity, 1) : search.search(-infinity, current, 1);
+            // the search is fail-soft, a value equal to the bound only bounds the true value of a move that fails
+            // low, a move coming first in move order is searched again with a window just below the bound
+            bool exact = value != current;
+            if (!exact && !search.is_aborted()) {
+                bool earlier;
+                {
+                    std::lock_guard<std::mutex> lock(result_mutex);
+                    earlier = i < best_index;
+                }
+                if (earlier) {
+                    value = maximizing ? search.search(current - 1, infinity, 1)
+                                       : search.search(-infinity, current + 1, 1);
+                    exact = true;
+                }
+            }
+            engine.undo(record);
+            if (search.is_aborted()) { break; }
+
+            std::lock_guard<std::mutex> lock(result_mutex);
+            ++nof_searched;
+            // equal values keep the move that comes first in move order
+            const bool better = maximizing ? value > best_value : value < best_value;
+            if (better || (exact && value == best_value && i < best_index)) {
+                best_value = value;
+                best_index = i;
+                bound.store(best_value);
+            }
+        }
+        std::lock_guard<std::mutex> lock(result_mutex);
+        res.nodes += search.get_nodes();
+    };
+
+    std::vector<std::thread> workers;
+    for (int i = 1; i < _settings.nof_threads; ++i) { workers.emplace_back(work); }
+    work();
+    for (std::thread &worker: workers) { worker.join(); }
+
+    res.complete = nof_searched == moves.size();
+    if (best_index < moves.size()) {
+        res.value = best_value;
+        res.line.push_back(moves[best_index]);
+    }
+
+    // the rest of the line: the best reply in every position, the values come from the table
+    if (res.complete) {
+        GameEngine &engine = root.get_engine();
+        engine.apply(res.line.front());
+        while (!(engine.get_state().flags & GameSnapshot::round_finished)) {
+            const bool max_node = is_team_a(engine.get_current_player());
+            const std::vector<Move> replies = root.ordered_moves(0, no_move);
+            int best = max_node ? -infinity : infinity;
+            const Move *best_reply = nullptr;
+            for (const Move &reply: replies) {
+                const UndoRecord record = engine.apply(reply);
+                const int value = root.search(-infinity, infinity, 1);
+                engine.undo(record);
+                if (root.is_aborted()) { break; }
+                if (max_node ? value > best : value < best) {
+                    best = value;
+                    best_reply = &reply;
+                }
+            }
+            if (root.is_aborted() || !best_reply) { break; }
+            res.line.push_back(*best_reply);
+            engine.apply(*best_reply);
+        }
+    }
+
+    res.nodes += root.get_nodes();
+    res.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return res;
+}
@@ -0,0 +1,88 @@
+/*! \class EndgameSolver
+    \brief Finds the best play of a round with all hands open.
+
+ The solver plays the round to its end on a GameEngine with alpha-beta minimax: team A (seats 0 and 2) maximizes
+ the points it gains on team B in the round, team B minimizes them. The value counts everything the GameEngine
+ scores at the end of the round: the card points, the double victory and the Tichu calls. The gift of a Dragon trick
+ is a move of the player who won it. Bombs are searched when it is the turn of the player holding them, bombs out of
+ turn are not considered.
+
+ Positions are stored in a transposition table under their Zobrist key (GameSnapshot::hash). The table is shared by
+ all threads without locks: an entry is two 64-bit words, the key is stored xor-ed with the data, so an entry torn by
+ two threads writing at once does not verify and is ignored. Moves are ordered by the move stored in the table,
+ then by the combination: plays that go out first, longer combinations before shorter ones, lower ranks before
+ higher ones, bombs and passes last.
+
+ The root moves are spread over the threads, each thread searches one root move at a time against the best value
+ found so far. The search stops at the time budget, the result then only covers the root moves searched to the end.
+ The search is exhaustive, so it is meant for positions with a few cards left in each hand.
+*/
+
+#ifndef TICHU_ENDGAME_SOLVER_H
+#define TICHU_ENDGAME_SOLVER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "game_engine.h"
+
+/**
+ * \struct EndgameResult
+ * \brief The outcome of EndgameSolver::solve.
+ */
+struct EndgameResult {
+    // true if every root move was searched within the time budget, the value is exact then
+    bool complete = false;
+    // points team A gains on team B until the end of the round with best play of both teams
+    int value = 0;
+    // the best moves from the position to the end of the round, only the first one if the search is incomplete
+    std::vector<Move> line;
+    uint64_t nodes = 0;
+    double seconds = 0;
+};
+
+class EndgameSolver {
+
+public:
+    /**
+     * \struct Settings
+     * \brief The resources of a search.
+     */
+    struct Settings {
+        int nof_threads = 1;
+        std::chrono::milliseconds budget{1000};
+        // number of entries of the transposition table, rounded up to a power of two (16 bytes each)
+        size_t table_size = 1 << 20;
+    };
+
+private:
+    struct Entry {
+        std::atomic<uint64_t> check{0};
+        std::atomic<uint64_t> data{0};
+    };
+
+    Settings _settings;
+    std::unique_ptr<Entry[]> _table;
+    uint64_t _table_mask = 0;
+
+    friend class EndgameSearch;
+
+public:
+    explicit EndgameSolver(const Settings &settings);
+
+    /**
+     * \brief Searches the position (INROUND or SELECTING) to the end of the round. The transposition table is kept
+     * between calls, so later positions of the same round are solved faster.
+     */
+    EndgameResult solve(const GameSnapshot &state);
+
+    /**
+     * \brief Empties the transposition table.
+     */
+    void clear();
+};
+
+
+#endif //TICHU_ENDGAME_SOLVER_H
@@ -0,0 +1,399 @@
+#include "game_engine.h"
+
+#include <bit>
+#include <cstring>
+#include "game_state.h"
+#include "zobrist.h"
+#include "cards/card_set.h"
+#include "cards/move_generator.h"
+
+namespace {
+    constexpr uint64_t phoenix_mask = CardSet(PHONIX).get_mask();
+    constexpr uint64_t dragon_mask = CardSet(DRAGON).get_mask();
+    constexpr uint64_t dog_mask = CardSet(HUND).get_mask();
+    constexpr uint64_t one_mask = CardSet(ONE).get_mask();
+    constexpr uint8_t all_players = (1u << GameSnapshot::nof_players) - 1;
+}
+
+//
+//   [MOVES]
+//
+Move Move::play(int player, const CardCombination &combi, int wish) {
+    Move res;
+    res.type = MoveType::PLAY;
+    res.player = (uint8_t)player;
+    res.cards = CardSet(combi.get_cards()).get_mask();
+    res.key = combi.get_key();
+    res.wish = (uint8_t)wish;
+    return res;
+}
+
+Move Move::play(int player, uint64_t cards, uint32_t key, int wish) {
+    Move res;
+    res.type = MoveType::PLAY;
+    res.player = (uint8_t)player;
+    res.cards = cards;
+    res.key = key;
+    res.wish = (uint8_t)wish;
+    return res;
+}
+
+Move Move::pass(int player) {
+    Move res;
+    res.type = MoveType::PASS;
+    res.player = (uint8_t)player;
+    return res;
+}
+
+Move Move::gift(int player, int target) {
+    Move res;
+    res.type = MoveType::GIFT;
+    res.player = (uint8_t)player;
+    res.target = (uint8_t)target;
+    return res;
+}
+
+Move Move::swap_cards(int player, Card to_next, Card to_partner, Card to_previous) {
+    Move res;
+    res.type = MoveType::SWAP;
+    res.player = (uint8_t)player;
+    res.swap[0] = to_next.get_id();
+    res.swap[1] = to_partner.get_id();
+    res.swap[2] = to_previous.get_id();
+    res.cards = CardSet(to_next).get_mask() | CardSet(to_partner).get_mask() | CardSet(to_previous).get_mask();
+    return res;
+}
+
+GameEngine::GameEngine(const GameSnapshot &state) : _state(state) {
+    _state.hash = Zobrist::hash(_state);
+}
+
+//
+//   [ACCESSORS]
+//
+int GameEngine::get_current_player() const noexcept {
+    switch (_state.phase) {
+        case GamePhase::INROUND:
+            return _state.next;
+        case GamePhase::SELECTING:
+            return _state.last;
+        case GamePhase::SWAPPING:
+            for (int i = 0; i < GameSnapshot::nof_players; ++i) {
+                if (!(_state.responded & (1u << i))) { return i; }
+            }
+            return GameSnapshot::no_player;
+        default:
+            return GameSnapshot::no_player;
+    }
+}
+
+// only the rank of a single Phoenix is not given by its cards
+CardCombination GameEngine::to_combination(uint64_t cards, uint32_t key) {
+    CardCombination res(CardSet(cards).to_vector());
+    const int rank = (int)(key & 0xFF) - 1;
+    if (res.get_key() != key && rank >= TWO) {
+        res = res.played_on(CardCombination(Card(rank, GREEN)));
+    }
+    return res;
+}
+
+std::optional<CardCombination> GameEngine::get_top_combination() const {
+    if (!_state.top) { return {}; }
+    return to_combination(_state.top, _state.top_key);
+}
+
+int GameEngine::next_active(int player) const noexcept {
+    for (int i = 1; i <= GameSnapshot::nof_players; ++i) {
+        const int res = (player + i) % GameSnapshot::nof_players;
+        if (!_state.is_finished(res)) { return res; }
+    }
+    return player;
+}
+
+bool GameEngine::is_round_over() const noexcept {
+    return _state.nof_finished >= 3
+           || (_state.is_finished(0) && _state.is_finished(2))
+           || (_state.is_finished(1) && _state.is_finished(3));
+}
+
+void GameEngine::get_legal_moves(int player, std::vector<Move> &moves) const {
+    moves.clear();
+    switch (_state.phase) {
+        case GamePhase::INROUND: {
+            const bool in_turn = player == _state.next;
+            // out of turn only bombs on a combination can be played
+            if (_state.is_finished(player) || (!in_turn && !_state.top)) { return; }
+            // the plays come as masks and keys, no CardCombination is built
+            thread_local std::vector<LegalPlay> plays;
+            MoveGenerator::get_legal_plays(_state.hands[player], _state.top_key, _state.wish, plays);
+            for (const LegalPlay &play: plays) {
+                const int type = (int)(play.key >> 16);
+                if (type == PASS) {
+                    if (in_turn) { moves.push_back(Move::pass(player)); }
+                } else if (in_turn || type == BOMB) {
+                    moves.push_back(Move::play(player, play.cards, play.key));
+                    if (play.cards & one_mask) {
+                        for (int rank = TWO; rank <= ACE; ++rank) {
+                            moves.push_back(Move::play(player, play.cards, play.key, rank));
+                        }
+                    }
+                }
+            }
+            return;
+        }
+        case GamePhase::SELECTING:
+            if (player == _state.last) {
+                moves.push_back(Move::gift(player, (player + 1) % GameSnapshot::nof_players));
+                moves.push_back(Move::gift(player, (player + 3) % GameSnapshot::nof_players));
+            }
+            return;
+        case GamePhase::SWAPPING: {
+            if (_state.responded & (1u << player)) { return; }
+            Card cards[card_table::nof_cards];
+            int nof_cards = 0;
+            for (uint64_t hand = _state.hands[player]; hand; hand &= hand - 1) {
+                cards[nof_cards++] = Card::from_id((uint8_t)std::countr_zero(hand));
+            }
+            for (int first = 0; first < nof_cards; ++first) {
+                for (int second = 0; second < nof_cards; ++second) {
+                    for (int third = 0; third < nof_cards; ++third) {
+                        if (first == second || first == third || second == third) { continue; }
+                        moves.push_back(Move::swap_cards(player, cards[first], cards[second], cards[third]));
+                    }
+                }
+            }
+            return;
+        }
+        default:
+            return;
+    }
+}
+
+//
+//   [APPLY / UNDO]
+//
+UndoRecord GameEngine::apply(const Move &move) noexcept {
+    UndoRecord record;
+    record.move = move;
+    record.hash = _state.hash;
+    record.trick = _state.trick;
+    record.top = _state.top;
+    record.gifted = 0;
+    record.top_key = _state.top_key;
+    record.score_a = _state.score_a;
+    record.score_b = _state.score_b;
+    record.receiver = GameSnapshot::no_player;
+    record.phase = _state.phase;
+    record.next = _state.next;
+    record.last = _state.last;
+    record.start = _state.start;
+    record.wish = _state.wish;
+    record.finish_order = _state.finish_order;
+    record.nof_finished = _state.nof_finished;
+    record.skipped = _state.skipped;
+    record.responded = _state.responded;
+    record.flags = _state.flags;
+    std::memcpy(record.swaps, _state.swaps, sizeof(record.swaps));
+    const uint64_t fields = Zobrist::fields(_state);
+    uint64_t hands[GameSnapshot::nof_players];
+    std::memcpy(hands, _state.hands, sizeof(hands));
+
+    _state.flags = 0;
+    switch (move.type) {
+        case MoveType::PLAY:
+            play(move, record);
+            break;
+        case MoveType::PASS:
+            pass(move, record);
+            break;
+        case MoveType::GIFT:
+            give_trick(move.target, record);
+            _state.phase = GamePhase::INROUND;
+            _state.flags = GameSnapshot::trick_finished;
+            break;
+        case MoveType::SWAP:
+            swap(move);
+            break;
+    }
+
+    // only the changed features are updated, cards moved to or from a location toggle their keys
+    uint64_t hash = record.hash ^ fields ^ Zobrist::fields(_state);
+    for (int i = 0; i < GameSnapshot::nof_players; ++i) {
+        if (hands[i] != _state.hands[i]) { hash ^= Zobrist::cards(Zobrist::HAND + i, hands[i] ^ _state.hands[i]); }
+    }
+    if (record.receiver != GameSnapshot::no_player) {
+        hash ^= Zobrist::cards(Zobrist::WON + record.receiver, record.gifted);
+    }
+    hash ^= Zobrist::cards(Zobrist::TRICK, record.trick ^ _state.trick);
+    hash ^= Zobrist::cards(Zobrist::TOP, record.top ^ _state.top);
+    _state.hash = hash;
+    return record;
+}
+
+void GameEngine::undo(const UndoRecord &record) noexcept {
+    const Move &move = record.move;
+    if (move.type == MoveType::PLAY) {
+        _state.hands[move.player] |= move.cards;
+    }
+    if (record.receiver != GameSnapshot::no_player) {
+        _state.won[record.receiver] &= ~record.gifted;
+    }
+    if (move.type == MoveType::SWAP && (record.responded | (1u << move.player)) == all_players) {
+        uint8_t swaps[GameSnapshot::nof_players][GameSnapshot::nof_players - 1];
+        std::memcpy(swaps, record.swaps, sizeof(swaps));
+        std::memcpy(swaps[move.player], move.swap, sizeof(move.swap));
+        exchange_swapped_cards(swaps, true);
+    }
+
+    _state.trick = record.trick;
+    _state.top = record.top;
+    _state.top_key = record.top_key;
+    _state.score_a = record.score_a;
+    _state.score_b = record.score_b;
+    _state.phase = record.phase;
+    _state.next = record.next;
+    _state.last = record.last;
+    _state.start = record.start;
+    _state.wish = record.wish;
+    _state.finish_order = record.finish_order;
+    _state.nof_finished = record.nof_finished;
+    _state.skipped = record.skipped;
+    _state.responded = record.responded;
+    _state.flags = record.flags;
+    std::memcpy(_state.swaps, record.swaps, sizeof(_state.swaps));
+    _state.hash = record.hash;
+}
+
+void GameEngine::play(const Move &move, UndoRecord &record) noexcept {
+    const int player = move.player;
+    _state.hands[player] &= ~move.cards;
+    _state.trick |= move.cards;
+    // a single Phoenix takes the rank of the single it is played on, -1 if it leads the trick
+    if (move.cards == phoenix_mask) {
+        _state.top_key = (_state.top_key >> 8) == (move.key >> 8) ? _state.top_key : (move.key & ~0xFFu);
+    } else {
+        _state.top_key = move.key;
+    }
+    _state.top = move.cards;
+    _state.skipped = 0;
+
+    if (move.wish) {
+        _state.wish = move.wish;
+    } else if (_state.wish && ((move.cards >> ((_state.wish - 1) * card_table::nof_suits)) & 0xF)) {
+        _state.wish = 0;
+    }
+
+    if (!_state.hands[player]) { _state.add_finisher(player); }
+    _state.last = (uint8_t)player;
+    // the Dog hands the turn to the partner, after a bomb the player after the bomber continues
+    _state.next = (uint8_t)next_active(move.cards == dog_mask ? (player + 1) % GameSnapshot::nof_players : player);
+
+    if (is_round_over()) {
+        wrap_up_trick(record);
+        wrap_up_round();
+    }
+}
+
+void GameEngine::pass(const Move &move, UndoRecord &record) noexcept {
+    _state.skipped |= (uint8_t)(1u << move.player);
+    _state.next = (uint8_t)next_active(move.player);
+
+    // the trick is finished if everyone but the player of the top combination passed or is finished
+    for (int i = 0; i < GameSnapshot::nof_players; ++i) {
+        if (i != _state.last && !(_state.skipped & (1u << i)) && !_state.is_finished(i)) { return; }
+    }
+    wrap_up_trick(record);
+}
+
+void GameEngine::swap(const Move &move) noexcept {
+    std::memcpy(_state.swaps[move.player], move.swap, sizeof(move.swap));
+    _state.responded |= (uint8_t)(1u << move.player);
+    if (_state.responded != all_players) { return; }
+
+    exchange_swapped_cards(_state.swaps, false);
+    _state.responded = 0;
+    _state.phase = GamePhase::INROUND;
+    std::memset(_state.swaps, 0, sizeof(_state.swaps));
+    // the holder of the Mah Jong starts
+    for (int i = 0; i < GameSnapshot::nof_players; ++i) {
+        if (_state.hands[i] & one_mask) {
+            _state.next = (uint8_t)i;
+            break;
+        }
+    }
+}
+
+void GameEngine::exchange_swapped_cards(const uint8_t (&swaps)[GameSnapshot::nof_players][GameSnapshot::nof_players - 1],
+                                        bool back) noexcept {
+    for (int from = 0; from < GameSnapshot::nof_players; ++from) {
+        for (int k = 0; k < GameSnapshot::nof_players - 1; ++k) {
+            const int to = (from + k + 1) % GameSnapshot::nof_players;
+            const uint64_t card = 1ull << swaps[from][k];
+            _state.hands[back ? to : from] &= ~card;
+            _state.hands[back ? from : to] |= card;
+        }
+    }
+}
+
+void GameEngine::wrap_up_trick(UndoRecord &record) noexcept {
+    _state.flags |= GameSnapshot::trick_finished;
+    const int winner = _state.last;
+    // a Dragon trick is given to an opponent, the winner chooses unless one of them is finished
+    if (_state.top == dragon_mask) {
+        const int left = (winner + 1) % GameSnapshot::nof_players;
+        const int right = (winner + 3) % GameSnapshot::nof_players;
+        if (_state.is_finished(left)) {
+            give_trick(right, record);
+        } else if (_state.is_finished(right)) {
+            give_trick(left, record);
+        } else {
+            _state.phase = GamePhase::SELECTING;
+        }
+        return;
+    }
+    give_trick(winner, record);
+}
+
+void GameEngine::give_trick(int player, UndoRecord &record) noexcept {
+    record.receiver = (uint8_t)player;
+    record.gifted = _state.trick;
+    _state.won[player] |= _state.trick;
+    _state.trick = 0;
+    _state.top = 0;
+    _state.top_key = 0;
+}
+
+void GameEngine::wrap_up_round() noexcept {
+    const int first = _state.get_finisher(0);
+    int added[2] = {};
+
+    if (_state.nof_finished < 3) {
+        // double victory, the cards are not counted
+        added[first % 2] += 200;
+    } else {
+        int remaining = 0;
+        while (_state.is_finished(remaining)) { ++remaining; }
+        int points[GameSnapshot::nof_players];
+        for (int i = 0; i < GameSnapshot::nof_players; ++i) { points[i] = _state.get_won(i).score(); }
+        // the last player's tricks go to the first player, the hand to the opponents
+        points[first] += points[remaining];
+        points[remaining] = 0;
+        points[(remaining + 1) % GameSnapshot::nof_players] += _state.get_hand(remaining).score();
+        for (int i = 0; i < GameSnapshot::nof_players; ++i) { added[i % 2] += points[i]; }
+    }
+
+    for (int i = 0; i < GameSnapshot::nof_players; ++i) {
+        const int call = _state.get_tichu(i);
+        const int bonus = call == (int)Tichu::GRAND_TICHU ? 200 : call == (int)Tichu::TICHU ? 100 : 0;
+        added[i % 2] += first == i ? bonus : -bonus;
+    }
+
+    _state.score_a = (int16_t)(_state.score_a + added[0]);
+    _state.score_b = (int16_t)(_state.score_b + added[1]);
+    _state.wish = 0;
+    _state.start = (uint8_t)first;
+    _state.next = (uint8_t)first;
+    _state.last = GameSnapshot::no_player;
+    _state.flags |= GameSnapshot::round_finished;
+    _state.phase = _state.score_a >= 1000 || _state.score_b >= 1000 ? GamePhase::POSTGAME : GamePhase::PREROUND;
+}
@@ -0,0 +1,151 @@
+/*! \class GameEngine
+    \brief Plays moves on a GameSnapshot and takes them back again.
+
+ The GameEngine implements the rules of a round on a GameSnapshot: plays (including bombs out of turn and the
+ wish of the Mah Jong), passes, the gift of a Dragon trick and the card swap. apply returns an UndoRecord holding
+ everything the move changed, undo restores the previous state from it. Neither allocates memory, builds strings
+ or emits events, so a tree search walks forward and back through positions without copying the game state. The
+ Zobrist key of the position (GameSnapshot::hash) is updated along with the move.
+
+ Moves are not validated by apply, they have to be taken from get_legal_moves (or be known to be legal). The
+ rules follow GameState::play_combi, GameState::dragon_selection and GameState::swap_cards. When a round ends the
+ engine adds the round score and moves to PREROUND (or POSTGAME), the cards of the round stay where they are until
+ the next deal, which is left to the owner of the deck. The Grand Tichu and Tichu calls are not moves of the
+ engine, they are made on the GameState.
+*/
+
+#ifndef TICHU_GAME_ENGINE_H
+#define TICHU_GAME_ENGINE_H
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include "game_snapshot.h"
+#include "cards/card.h"
+#include "cards/card_combination.h"
+
+/**
+ * \enum MoveType
+ * \brief The kinds of moves the GameEngine plays.
+ */
+enum class MoveType : uint8_t {
+    PLAY, PASS, GIFT, SWAP
+};
+
+/**
+ * \struct Move
+ * \brief A move of one player, as plain data.
+ */
+struct Move {
+    uint64_t cards{};       // PLAY: the cards played, SWAP: the three cards handed in
+    uint32_t key{};         // PLAY: CardCombination::get_key() of the played combination
+    MoveType type{};
+    uint8_t player{};
+    uint8_t wish{};         // PLAY with the Mah Jong: the wished for rank, 0 for no wish
+    uint8_t target{};       // GIFT: the player receiving the Dragon trick
+    uint8_t swap[GameSnapshot::nof_players - 1]{};  // SWAP: card ids passed to players player + 1, + 2 and + 3
+
+    static Move play(int player, const CardCombination &combi, int wish = 0);
+
+    static Move play(int player, uint64_t cards, uint32_t key, int wish = 0);
+
+    static Move pass(int player);
+
+    static Move gift(int player, int target);
+
+    static Move swap_cards(int player, Card to_next, Card to_partner, Card to_previous);
+
+    bool operator==(const Move &other) const = default;
+};
+
+/**
+ * \struct UndoRecord
+ * \brief The part of a GameSnapshot a move changed, returned by GameEngine::apply.
+ */
+struct UndoRecord {
+    Move move;
+    uint64_t hash;
+    uint64_t trick;
+    uint64_t top;
+    uint64_t gifted;        // cards the move added to the won pile of receiver
+    uint32_t top_key;
+    int16_t score_a;
+    int16_t score_b;
+    uint8_t receiver;       // GameSnapshot::no_player if no cards were won
+    uint8_t phase;
+    uint8_t next;
+    uint8_t last;
+    uint8_t start;
+    uint8_t wish;
+    uint8_t finish_order;
+    uint8_t nof_finished;
+    uint8_t skipped;
+    uint8_t responded;
+    uint8_t flags;
+    uint8_t swaps[GameSnapshot::nof_players][GameSnapshot::nof_players - 1];
+};
+
+static_assert(std::is_trivially_copyable_v<UndoRecord>, "UndoRecord has to be plain data");
+
+class GameEngine {
+
+private:
+    GameSnapshot _state;
+
+    [[nodiscard]] int next_active(int player) const noexcept;
+    [[nodiscard]] bool is_round_over() const noexcept;
+
+    void play(const Move &move, UndoRecord &record) noexcept;
+    void pass(const Move &move, UndoRecord &record) noexcept;
+    void swap(const Move &move) noexcept;
+    void exchange_swapped_cards(const uint8_t (&swaps)[GameSnapshot::nof_players][GameSnapshot::nof_players - 1],
+                                bool back) noexcept;
+
+    void wrap_up_trick(UndoRecord &record) noexcept;
+    void give_trick(int player, UndoRecord &record) noexcept;
+    void wrap_up_round() noexcept;
+
+public:
+    /**
+     * \brief Starts from the state, its hash is computed from scratch.
+     */
+    explicit GameEngine(const GameSnapshot &state = {});
+
+// accessors
+    [[nodiscard]] const GameSnapshot &get_state() const noexcept { return _state; }
+
+    /**
+     * \brief The player whose move is expected: the next player during the round, the player choosing who gets a
+     * Dragon trick and the first player who did not hand in cards during the swap. GameSnapshot::no_player otherwise.
+     * Bombs may be played out of turn by every other player holding one.
+     */
+    [[nodiscard]] int get_current_player() const noexcept;
+
+    /**
+     * \brief The top combination of the current trick, as the GameState holds it on the ActivePile.
+     */
+    [[nodiscard]] std::optional<CardCombination> get_top_combination() const;
+
+    static CardCombination to_combination(uint64_t cards, uint32_t key);
+
+// engine functions
+    /**
+     * \brief Fills moves with every legal move of the player: all combinations (a play with the Mah Jong once per
+     * wish) and a pass for the current player, the bombs on the current trick for the other players, the gifts of
+     * a Dragon trick and every ordered choice of three cards during the swap.
+     */
+    void get_legal_moves(int player, std::vector<Move> &moves) const;
+
+    /**
+     * \brief Plays the move and returns the record that takes it back. The move has to be legal.
+     */
+    UndoRecord apply(const Move &move) noexcept;
+
+    /**
+     * \brief Takes back the last applied move, records have to be undone in the reverse order of apply.
+     */
+    void undo(const UndoRecord &record) noexcept;
+};
+
+
+#endif //TICHU_GAME_ENGINE_H
@@ -0,0 +1,97 @@
+/*! \struct GameSnapshot
+    \brief A plain data copy of the state of a Tichu game.
+
+ The GameSnapshot holds the same game state as a GameState, with the cards of every pile stored as a CardSet mask
+ and the players identified by their index (seat) in GameState::get_players(). It contains no pointers and no heap
+ memory, so it is cloned with a plain copy (or memcpy) and fits in two cache lines. Search, simulation and history
+ features work on snapshots and convert from and to a GameState only at the boundary, see GameState::to_snapshot
+ and GameState::restore.
+
+ Players 0 and 2 form team A, players 1 and 3 team B (see GameState::make_teams).
+*/
+
+#ifndef TICHU_GAME_SNAPSHOT_H
+#define TICHU_GAME_SNAPSHOT_H
+
+#include <cstdint>
+#include <type_traits>
+#include "cards/card.h"
+#include "cards/card_set.h"
+
+struct GameSnapshot {
+    static constexpr int nof_players = 4;
+    static constexpr uint8_t no_player = 4;
+
+    // card masks (see CardSet) of the hand and the won cards of every player
+    uint64_t hands[nof_players]{};
+    uint64_t won[nof_players]{};
+    // all cards played in the current trick and the cards of the top combination among them
+    uint64_t trick{};
+    uint64_t top{};
+    // Zobrist key of the position, see Zobrist
+    uint64_t hash{};
+    // CardCombination::get_key() of the top combination, 0 if the trick is empty
+    uint32_t top_key{};
+
+    int16_t score_a{};
+    int16_t score_b{};
+
+    uint8_t phase{};            // GamePhase
+    uint8_t next{};             // player to play
+    uint8_t last{no_player};    // player who played the top combination
+    uint8_t start{};            // player who started the round
+    uint8_t wish{};             // wished for rank, 0 if there is no wish
+    uint8_t finish_order{};     // 2 bits per place, the first player to finish in the lowest bits
+    uint8_t nof_finished{};
+    uint8_t skipped{};          // bit i is set if player i passed since the last combination
+    uint8_t responded{};        // bit i is set if player i answered the Grand Tichu call or handed in the swap
+    uint8_t tichu{};            // 2 bits per player holding the Tichu call
+    uint8_t flags{};            // round_finished and trick_finished
+    // card ids passed by player i to players i + 1, i + 2 and i + 3 during the swap
+    uint8_t swaps[nof_players][nof_players - 1]{};
+
+    static constexpr uint8_t round_finished = 1;
+    static constexpr uint8_t trick_finished = 2;
+
+    bool operator==(const GameSnapshot &other) const = default;
+
+// accessors
+    [[nodiscard]] CardSet get_hand(int player) const noexcept { return CardSet(hands[player]); }
+
+    [[nodiscard]] CardSet get_won(int player) const noexcept { return CardSet(won[player]); }
+
+    /**
+     * \brief The cards that are neither in a hand, a won pile nor the current trick.
+     */
+    [[nodiscard]] CardSet get_draw_pile() const noexcept {
+        uint64_t placed = trick;
+        for (int i = 0; i < nof_players; ++i) { placed |= hands[i] | won[i]; }
+        return CardSet::full_deck() - CardSet(placed);
+    }
+
+    [[nodiscard]] bool is_finished(int player) const noexcept {
+        for (int place = 0; place < nof_finished; ++place) {
+            if (get_finisher(place) == player) { return true; }
+        }
+        return false;
+    }
+
+    [[nodiscard]] int get_finisher(int place) const noexcept { return (finish_order >> (2 * place)) & 3; }
+
+    [[nodiscard]] int get_tichu(int player) const noexcept { return (tichu >> (2 * player)) & 3; }
+
+    void set_tichu(int player, int call) noexcept {
+        tichu = (uint8_t)((tichu & ~(3u << (2 * player))) | ((unsigned)call << (2 * player)));
+    }
+
+    void add_finisher(int player) noexcept {
+        finish_order |= (uint8_t)(player << (2 * nof_finished));
+        ++nof_finished;
+    }
+};
+
+static_assert(std::is_trivially_copyable_v<GameSnapshot>, "GameSnapshot has to be copyable with memcpy");
+static_assert(sizeof(GameSnapshot) < 128, "GameSnapshot should fit in two cache lines");
+
+
+#endif //TICHU_GAME_SNAPSHOT_H
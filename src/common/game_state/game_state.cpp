@@ -1,4 +1,7 @@
 #include "game_state.h"
+#include "game_engine.h"
+#include "zobrist.h"
+#include "cards/wish_solver.h"
 
 #include <iostream>
 #include <utility>
@@ -7,10 +10,10 @@
 #include <random>
 
 GameState::GameState() :
-        _id(UUID::create()) {}
+        _id(UUID::create()), _seed(Xoshiro256::random_seed()), _rng(_seed) {}
 
 GameState::GameState(UUID id) :
-        _id(std::move(id)) {}
+        _id(std::move(id)), _seed(Xoshiro256::random_seed()), _rng(_seed) {}
 
 // accessors
 std::optional<Player> GameState::get_current_player() const {
@@ -49,10 +52,66 @@ bool GameState::is_allowed_to_play_now(const Player &player) const {
     return player == current.value();
 }
 
+GameState GameState::clone() const {
+    GameState res = *this;
+    for (player_ptr &player: res._players) { player = std::make_shared<Player>(*player); }
+    return res;
+}
+
+GameSnapshot GameState::to_snapshot() const {
+    GameSnapshot res;
+    for (int i = 0; i < (int)_players.size() && i < GameSnapshot::nof_players; ++i) {
+        const Player &player = *_players.at(i);
+        res.hands[i] = player.get_hand().get_card_set().get_mask();
+        res.won[i] = player.get_won_cards().get_card_set().get_mask();
+        if (player.get_has_skipped()) { res.skipped |= (uint8_t)(1u << i); }
+        res.set_tichu(i, (int)player.get_tichu());
+    }
+    for (const Player &player : _round_finish_order) {
+        int player_idx = get_player_index(player);
+        if (player_idx < 0) { throw TichuException("GameState::to_snapshot: a finisher is not seated at the table"); }
+        res.add_finisher(player_idx);
+    }
+
+    for (const CardCombination &combi : _active_pile.get_pile()) {
+        res.trick |= CardSet(combi.get_cards()).get_mask();
+    }
+    if (auto top = _active_pile.get_top_combi()) {
+        res.top = CardSet(top->get_cards()).get_mask();
+        res.top_key = top->get_key();
+    }
+
+    res.score_a = (int16_t)_score_team_A;
+    res.score_b = (int16_t)_score_team_B;
+    res.phase = (uint8_t)_game_phase;
+    res.next = (uint8_t)_next_player_idx;
+    res.last = (uint8_t)_last_player_idx;
+    res.start = (uint8_t)_starting_player_idx;
+    res.wish = _wish ? (uint8_t)_wish->get_rank() : 0;
+    res.responded = _responded_players;
+    // the flag of the GameState stays set until the first play of the next round, a dealt round is not finished
+    const bool round_finished = _is_round_finished && _game_phase != GamePhase::SWAPPING
+                                && _game_phase != GamePhase::INROUND;
+    res.flags = (uint8_t)((round_finished ? GameSnapshot::round_finished : 0)
+                          | (_is_trick_finished ? GameSnapshot::trick_finished : 0));
+    for (int from = 0; from < GameSnapshot::nof_players; ++from) {
+        for (int k = 1; k < GameSnapshot::nof_players; ++k) {
+            res.swaps[from][k - 1] = _swap_matrix[from][(from + k) % 4].get_id();
+        }
+    }
+    res.hash = Zobrist::hash(res);
+    return res;
+}
+
 #ifdef TICHU_SERVER
 // 
 //   [ FUNCTIONS] 
 // 
+void GameState::set_seed(uint64_t seed) {
+    _seed = seed;
+    _rng.seed(seed);
+}
+
 bool GameState::start_game(std::string &err) {
     if (_players.size() < _min_nof_players) {
         err = "You need at least " + std::to_string(_min_nof_players) + " players to start the game.";
@@ -102,7 +161,7 @@ void GameState::make_teams(){
         }
     }
     else {
-        std::shuffle(_players.begin(), _players.end(), std::mt19937(std::random_device()()));
+        std::shuffle(_players.begin(), _players.end(), _rng);
     }
 
     // change team variable of all players 
@@ -118,25 +177,26 @@ bool GameState::call_grand_tichu(const Player &player, Tichu tichu, std::string
         return false;
     }
 
-    static int call_count = 0;
-    ++call_count;
-
     int player_idx = get_player_index(player);
+    if(player_idx < 0) {
+        err = "couldn't find Player index";
+        return false;
+    }
+    if(_responded_players & (1u << player_idx)) {
+        err = "You already decided on a Grand Tichu";
+        return false;
+    }
+    _responded_players |= (uint8_t)(1u << player_idx);
     _players.at(player_idx)->set_tichu(tichu);
 
-    if(call_count < 4){
+    if(_responded_players != 0b1111){
         return true;
     } else {
-        call_count = 0;
+        _responded_players = 0;
         _game_phase = GamePhase::SWAPPING;
         // Draw the rest of the cards
-        for (int i = 0; i < _players.size(); i++) {
-            for (int j = 0; j < 6; j++) {
-                auto drawn_card = _draw_pile.draw(*(_players[i]), err);
-                if (!drawn_card) {
-                    std::cerr << err << std::endl;
-                }
-            }
+        if (!_draw_pile.deal(_players, 6, _rng, err)) {
+            std::cerr << err << std::endl;
         }
 
         return true;
@@ -174,59 +234,57 @@ bool GameState::swap_cards(const Player &player, const std::vector<Card> &cards,
         err = "You can't swap the same card to two different players";
         return false;
     }
-    
-    
-    static std::vector<std::vector<Card>> swap_tracker = {  {{},{},{},{}},
-                                                            {{},{},{},{}},
-                                                            {{},{},{},{}},
-                                                            {{},{},{},{}}  };
-    static int call_count = 0;
-    ++call_count;
-
-    // add cards into swap_tracker
+
     int player_idx = get_player_index(player);
+    if(player_idx < 0) {
+        err = "couldn't find Player index";
+        return false;
+    }
+    if(_responded_players & (1u << player_idx)) {
+        err = "You already chose the cards to swap";
+        return false;
+    }
+    _responded_players |= (uint8_t)(1u << player_idx);
+
+    // add cards into the swap matrix
     int card_idx = 0;
     for(int i = (player_idx + 1) % 4; i != player_idx; (i = (i + 1)%4) ) {
-        swap_tracker.at(player_idx).at(i) = cards.at(card_idx);
+        _swap_matrix[player_idx][i] = cards.at(card_idx);
         ++card_idx;
     }
 
     //add SWAP_OUT events
     for(int i = 0; i < 4; ++i) {
         if(i == player_idx) { continue; }
-        events_vec.at(player_idx).push_back({EventType::SWAP_OUT, _players.at(i)->get_id(), swap_tracker.at(player_idx).at(i), {}, {}});
+        events_vec.at(player_idx).push_back({EventType::SWAP_OUT, _players.at(i)->get_id(), _swap_matrix[player_idx][i], {}, {}});
     }
 
 
-    if(call_count < 4){
+    if(_responded_players != 0b1111){
         return true;
     } else {
-        call_count = 0;
+        _responded_players = 0;
         _game_phase = GamePhase::INROUND;
 
         // moving all the cards and adding SWAP_IN EVENTS
         for(int i = 0; i < 4; ++i) {
             for(int j = 0; j < 4; ++j) {
                 if(i == j) { continue; }
-                _players.at(i)->remove_cards_from_hand(CardCombination{swap_tracker.at(i).at(j)}, err);
-                _players.at(j)->add_card_to_hand(swap_tracker.at(i).at(j), err);
-                events_vec.at(j).push_back({EventType::SWAP_IN, _players.at(i)->get_id(), swap_tracker.at(i).at(j), {}, {}});
+                _players.at(i)->remove_cards_from_hand(CardCombination{_swap_matrix[i][j]}, err);
+                _players.at(j)->add_card_to_hand(_swap_matrix[i][j], err);
+                events_vec.at(j).push_back({EventType::SWAP_IN, _players.at(i)->get_id(), _swap_matrix[i][j], {}, {}});
             }
         }
         // figure our whos going first
         for(int i = 0; i < 4; ++i) {
-            auto cards = _players.at(i)->get_hand().get_cards();
-            if(count(cards.begin(), cards.end(), ONE)) {
+            if(_players.at(i)->get_hand().get_card_set().contains(ONE)) {
                 _next_player_idx = i;
                 break;
             }
         }
 
-        // resetting the swap_tracker
-        swap_tracker = {  {{},{},{},{}},
-                          {{},{},{},{}},
-                          {{},{},{},{}},
-                          {{},{},{},{}}  };
+        // resetting the swap matrix
+        _swap_matrix = {};
 
         return true;
     }
@@ -249,20 +307,18 @@ bool GameState::check_wish(const CardCombination &combi, const Player &player, c
     } 
     // there is a current active wish
     else {
-        if(player.get_hand().count_occurances(_wish.value())) {
-            if(combi.count_occurances(_wish.value())) {
-                // the player has the wished for card and is playing it
-                _wish = {};
-                return true;
-            } else {
-                err = "You must play the wished for card: " + _wish.value().to_string(false);
-                return false;
-            }
-        } 
-        // The player doesn't have the wished for card in his hand
-        else {
+        if(combi.count_occurances(_wish.value())) {
+            // the player has the wished for card and is playing it
+            _wish = {};
             return true;
         }
+        // the player could legally play a combination containing the wished for card
+        if(WishSolver::can_fulfill(player.get_hand().get_card_set(), _active_pile.get_top_combi(), _wish.value().get_rank())) {
+            err = "You must play the wished for card: " + _wish.value().to_string(false);
+            return false;
+        }
+        // The player doesn't have the wished for card or can't play it on the current trick
+        return true;
     }
 }
 
@@ -271,6 +327,8 @@ bool GameState::check_wish(const CardCombination &combi, const Player &player, c
 // 
 void GameState::setup_round(std::string &err) {
     _game_phase = GamePhase::PREROUND;
+    _responded_players = 0;
+    _swap_matrix = {};
 
     // setup DrawPile
     _draw_pile.setup_game(err);
@@ -278,14 +336,10 @@ void GameState::setup_round(std::string &err) {
     // setup players
     for (int i = 0; i < _players.size(); i++) {
         _players[i]->setup_round(err);
-        // draw 8 cards
-        //card* drawn_card = nullptr;
-        for (int j = 0; j < 8; j++) {
-            auto drawn_card = _draw_pile.draw(*(_players[i]), err);
-            if (!drawn_card) {
-                std::cerr << err << std::endl;
-            }
-        }
+    }
+    // draw 8 cards
+    if (!_draw_pile.deal(_players, 8, _rng, err)) {
+        std::cerr << err << std::endl;
     }
 
     
@@ -530,7 +584,7 @@ void GameState::wrap_up_player(Player &Player,  std::vector<Event> &events, std:
 }
 
 //   [Game Logic]
-bool GameState::play_combi(Player &Player, CardCombination& combi, std::vector<Event> &events, std::string &err, std::optional<Card> wish) {
+bool GameState::play_combi(Player &Player, const CardCombination& combi, std::vector<Event> &events, std::string &err, std::optional<Card> wish) {
     int player_idx = get_player_index(Player);
     if(player_idx < 0 || player_idx > 3){
         err = "couldn't find Player index";
@@ -540,7 +594,6 @@ bool GameState::play_combi(Player &Player, CardCombination& combi, std::vector<E
         err = "Server refused to perform draw_card. Player is not part of the game.";
         return false;
     }
-    combi.update_combination_type_and_rank();
     if (!is_allowed_to_play_now(Player) && combi.get_combination_type() != BOMB) {
         err = "It's not this players turn yet.";
         return false;
@@ -605,7 +658,7 @@ bool GameState::play_combi(Player &Player, CardCombination& combi, std::vector<E
 
         // move cards
         if(combi.get_combination_type() != PASS){
-            _active_pile.push_active_pile(combi);
+            _active_pile.push_active_pile(combi.played_on(last_combi));
             Player.remove_cards_from_hand(combi, err);
             for(auto player : _players) {
                 (*player).set_skipped(false);
@@ -648,4 +701,48 @@ bool GameState::play_combi(Player &Player, CardCombination& combi, std::vector<E
 
 }
 
-#endif
\ No newline at end of file
+//
+//   [SNAPSHOT]
+//
+bool GameState::restore(const GameSnapshot &snapshot, std::string &err) {
+    if (_players.size() != GameSnapshot::nof_players) {
+        err = "A snapshot can only be loaded into a game with four players.";
+        return false;
+    }
+
+    for (int i = 0; i < GameSnapshot::nof_players; ++i) {
+        _players.at(i)->restore(snapshot.get_hand(i), snapshot.get_won(i), snapshot.is_finished(i),
+                                (snapshot.skipped >> i) & 1, (Tichu)snapshot.get_tichu(i));
+    }
+    _round_finish_order.clear();
+    for (int place = 0; place < snapshot.nof_finished; ++place) {
+        _round_finish_order.push_back(*_players.at(snapshot.get_finisher(place)));
+    }
+
+    std::vector<CardCombination> trick;
+    const uint64_t below_top = snapshot.trick & ~snapshot.top;
+    if (below_top) { trick.emplace_back(CardSet(below_top).to_vector()); }
+    if (snapshot.top) { trick.push_back(GameEngine::to_combination(snapshot.top, snapshot.top_key)); }
+    _active_pile = ActivePile(trick);
+    _draw_pile = DrawPile(snapshot.get_draw_pile().to_vector());
+
+    _score_team_A = snapshot.score_a;
+    _score_team_B = snapshot.score_b;
+    _game_phase = (GamePhase)snapshot.phase;
+    _next_player_idx = snapshot.next;
+    _last_player_idx = snapshot.last;
+    _starting_player_idx = snapshot.start;
+    _wish = snapshot.wish ? std::optional<Card>(Card(snapshot.wish, GREEN)) : std::nullopt;
+    _responded_players = snapshot.responded;
+    _is_round_finished = snapshot.flags & GameSnapshot::round_finished;
+    _is_trick_finished = snapshot.flags & GameSnapshot::trick_finished;
+    _swap_matrix = {};
+    for (int from = 0; from < GameSnapshot::nof_players; ++from) {
+        for (int k = 1; k < GameSnapshot::nof_players; ++k) {
+            _swap_matrix[from][(from + k) % 4] = Card::from_id(snapshot.swaps[from][k - 1]);
+        }
+    }
+    return true;
+}
+
+#endif
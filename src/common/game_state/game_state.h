@@ -9,11 +9,14 @@
 #ifndef TICHU_GAME_STATE_H
 #define TICHU_GAME_STATE_H
 
+#include <array>
+#include <cstdint>
 #include <vector>
 #include <string>
 #include "player/player.h"
 #include "cards/draw_pile.h"
 #include "cards/active_pile.h"
+#include "game_snapshot.h"
 #include "../event.h"
 #include "../utils.h"
 
@@ -48,6 +51,10 @@ private:
 
     DrawPile _draw_pile{};
     ActivePile _active_pile{};
+    // the team draw and the deals of a game only depend on its seed, it is not serialized as it would reveal the
+    // cards of all players
+    uint64_t _seed;
+    Xoshiro256 _rng;
     std::optional<Card> _wish{};
 
     int _score_team_A{0};
@@ -61,6 +68,12 @@ private:
     bool _is_round_finished{false};
     bool _is_trick_finished{false};
 
+    // bit i is set once the player at index i answered the Grand Tichu call (PREROUND) or handed in
+    // the cards to swap (SWAPPING), the phase ends when all four bits are set
+    uint8_t _responded_players{0};
+    // _swap_matrix[from][to] is the card the player at index 'from' passes to the player at index 'to'
+    std::array<std::array<Card, 4>, 4> _swap_matrix{};
+
 
     // from_diff constructor
     explicit GameState(UUID id);
@@ -86,6 +99,9 @@ public:
 
     [[nodiscard]] bool is_trick_finished() const { return _is_trick_finished; }
 
+    // the seed of the random generator used for the team draw and the deals
+    [[nodiscard]] uint64_t get_seed() const { return _seed; }
+
     [[nodiscard]] bool is_player_in_game(const Player &player) const;
 
     [[nodiscard]] bool is_allowed_to_play_now(const Player &player) const;
@@ -98,13 +114,32 @@ public:
 
     [[nodiscard]] const ActivePile &get_active_pile() const { return _active_pile; }
 
+    [[nodiscard]] const std::optional<Card> &get_wish() const { return _wish; }
+
     [[nodiscard]] int get_last_player_idx() const { return _last_player_idx; }
     [[nodiscard]] int get_next_player_idx() const { return _next_player_idx; }
 
     [[nodiscard]] std::optional<Player> get_current_player() const;
 
+    /**
+     * \brief Returns a plain data copy of the game, the players are identified by their index in get_players().
+     * \throws TichuException if a player in the finish order is not seated at the table.
+     */
+    [[nodiscard]] GameSnapshot to_snapshot() const;
+
+    /**
+     * \brief Returns a copy of the game with copies of its players. A plain copy shares the players, so it changes
+     * along with the game.
+     */
+    [[nodiscard]] GameState clone() const;
+
 #ifdef TICHU_SERVER
     // server-side state update functions
+        /**
+         * \brief Reseeds the random generator of the game, set before start_game to replay the deals of a game.
+         */
+        void set_seed(uint64_t seed);
+
         bool start_game(std::string& err);
         bool check_is_game_over(std::string& err);
         void wrap_up_game(std::string& err);
@@ -135,12 +170,20 @@ public:
         void wrap_up_player(Player &Player, std::vector<Event> &events, std::string &err);
 
 
-        bool play_combi(Player &Player, CardCombination& combi, std::vector<Event> &events, std::string& err, std::optional<Card> wish = {});
+        bool play_combi(Player &Player, const CardCombination& combi, std::vector<Event> &events, std::string& err, std::optional<Card> wish = {});
+
+        /**
+         * \brief Loads a snapshot into the game. The game keeps its id and its four players, everything else is
+         * overwritten. The cards of the current trick below the top combination are restored as a single entry of
+         * the ActivePile.
+         */
+        bool restore(const GameSnapshot &snapshot, std::string &err);
 #endif
 
     NLOHMANN_DEFINE_TYPE_INTRUSIVE(GameState, _id, _players, _round_finish_order, _draw_pile, _active_pile,
                                     _wish, _score_team_A, _score_team_B, _next_player_idx, _starting_player_idx,
-                                    _game_phase, _is_round_finished, _is_trick_finished, _last_player_idx)
+                                    _game_phase, _is_round_finished, _is_trick_finished, _last_player_idx,
+                                    _responded_players, _swap_matrix)
 };
 
 NLOHMANN_JSON_SERIALIZE_ENUM(GamePhase, {
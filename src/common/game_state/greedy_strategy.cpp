@@ -0,0 +1,42 @@
+#include "greedy_strategy.h"
+
+#include "game_state.h"
+#include "player/hand.h"
+
+bool GreedyStrategy::call_tichu(const CardSet &cards) {
+    return cards.contains(DRAGON) && cards.contains(PHONIX) && hand(cards).has_bomb();
+}
+
+Move GreedyStrategy::swap(int seat, const CardSet &cards) {
+    // the cards in ascending order, the lowest two go to the opponents and the highest to the partner
+    return Move::swap_cards(seat, cards.nth(0), cards.nth(cards.size() - 1), cards.nth(1));
+}
+
+Move GreedyStrategy::choose(const GameSnapshot &state, int seat, const std::vector<Move> &moves) {
+    if (state.phase == GamePhase::SWAPPING) { return swap(seat, state.get_hand(seat)); }
+
+    if (state.phase == GamePhase::SELECTING) {
+        const int left = (seat + 1) % GameSnapshot::nof_players;
+        const int right = (seat + 3) % GameSnapshot::nof_players;
+        return Move::gift(seat, state.get_hand(left).size() >= state.get_hand(right).size() ? left : right);
+    }
+
+    const Move *pass = nullptr;
+    const Move *best = nullptr;
+    for (const Move &move: moves) {
+        if (move.type == MoveType::PASS) {
+            pass = &move;
+            continue;
+        }
+        if ((move.key >> 16) == BOMB || move.wish) { continue; }
+        const int length = (int)((move.key >> 8) & 0xFF);
+        const int best_length = best ? (int)((best->key >> 8) & 0xFF) : 0;
+        const bool longer = !state.top && length > best_length;
+        const bool lower = (state.top || length == best_length) && best && (move.key & 0xFF) < (best->key & 0xFF);
+        if (!best || longer || lower) { best = &move; }
+    }
+
+    // the partner's tricks are not taken
+    if (pass && (!best || state.last == (seat + 2) % GameSnapshot::nof_players)) { return *pass; }
+    return best ? *best : moves.front();
+}
@@ -0,0 +1,42 @@
+/*! \class GreedyStrategy
+    \brief The calls and moves of a player getting rid of its cards as cheaply as possible.
+
+ Leads the combination with the most cards (the lowest one on ties), beats a trick with the lowest combination
+ possible and keeps its bombs, lets its partner's tricks pass. Passes its lowest cards to the opponents and its
+ highest card to the partner, gives Dragon tricks to the opponent holding more cards and calls a Tichu on a hand
+ with the Dragon, the Phoenix and a bomb.
+
+ The strategy holds no state and needs no randomness. It plays the "greedy" seats of Tichu-sim and the playouts of
+ the TichuAdvisor, so both play the same way.
+*/
+
+#ifndef TICHU_GREEDY_STRATEGY_H
+#define TICHU_GREEDY_STRATEGY_H
+
+#include <vector>
+#include "game_engine.h"
+#include "game_snapshot.h"
+#include "cards/card_set.h"
+
+class GreedyStrategy {
+
+public:
+    /**
+     * \brief Whether to call a Tichu, seeing the 14 cards after the swap.
+     */
+    static bool call_tichu(const CardSet &cards);
+
+    /**
+     * \brief The swap of the seat: the lowest card to the next seat, the highest to the partner and the second
+     * lowest to the previous seat.
+     */
+    static Move swap(int seat, const CardSet &cards);
+
+    /**
+     * \brief Chooses one of the moves the GameEngine lists for the seat whose move is expected, moves is never empty.
+     */
+    static Move choose(const GameSnapshot &state, int seat, const std::vector<Move> &moves);
+};
+
+
+#endif //TICHU_GREEDY_STRATEGY_H
@@ -0,0 +1,259 @@
+#include "ismcts.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <mutex>
+#include <thread>
+#include "../utils.h"
+
+namespace {
+    constexpr uint32_t no_node = UINT32_MAX;
+    // a round won by 200 points more than the other team counts as a full win
+    constexpr double result_scale = 400;
+    // tries to deal the cards within the ruled out ranks before they are ignored
+    constexpr int max_deal_attempts = 8;
+
+    struct Node {
+        Move move;              // the move leading to the node
+        std::vector<uint32_t> children;
+        double reward = 0;      // sum of the results for the team of move.player
+        uint32_t visits = 0;
+        uint32_t availability = 0;
+    };
+
+    bool is_team_a(int player) { return player % 2 == 0; }
+
+    double result_for_team_a(const GameSnapshot &state, int root_difference) {
+        const double difference = state.score_a - state.score_b - root_difference;
+        return std::clamp(0.5 + difference / result_scale, 0.0, 1.0);
+    }
+}
+
+// the tree and the buffers of one thread
+class IsmctsWorker {
+
+private:
+    const IsmctsSearch::Settings &_settings;
+    const GameSnapshot &_view;
+    const int _observer;
+    const CardTracker &_tracker;
+    const int _root_difference;
+    Xoshiro256 _rng;
+
+    std::vector<Node> _nodes;
+    GameSnapshot _deal;
+    GameEngine _engine;
+    std::vector<Move> _moves;
+    std::vector<uint32_t> _path;
+    std::vector<int> _untried;
+
+    uint32_t find_child(uint32_t node, const Move &move) const {
+        for (uint32_t child: _nodes[node].children) {
+            if (_nodes[child].move == move) { return child; }
+        }
+        return no_node;
+    }
+
+    uint32_t add_child(uint32_t node, const Move &move) {
+        const auto child = (uint32_t)_nodes.size();
+        _nodes.push_back({move, {}, 0, 0, 1});
+        _nodes[node].children.push_back(child);
+        return child;
+    }
+
+    // the node the tree policy continues with, no_node after a new node was added
+    uint32_t select(uint32_t node) {
+        _engine.get_legal_moves(_engine.get_current_player(), _moves);
+        _untried.clear();
+        uint32_t best = no_node;
+        double best_score = -1;
+        for (int i = 0; i < (int)_moves.size(); ++i) {
+            const uint32_t child = find_child(node, _moves[i]);
+            if (child == no_node) {
+                _untried.push_back(i);
+                continue;
+            }
+            Node &data = _nodes[child];
+            ++data.availability;
+            const double score = data.reward / data.visits
+                                 + _settings.exploration * std::sqrt(std::log((double)data.availability) / data.visits);
+            if (score > best_score) {
+                best_score = score;
+                best = child;
+            }
+        }
+        if (!_untried.empty()) {
+            const Move &move = _moves[_untried[_rng.below((uint32_t)_untried.size())]];
+            _path.push_back(add_child(node, move));
+            _engine.apply(move);
+            return no_node;
+        }
+        _path.push_back(best);
+        _engine.apply(_nodes[best].move);
+        return best;
+    }
+
+public:
+    IsmctsWorker(const IsmctsSearch::Settings &settings, const GameSnapshot &view, int observer,
+                 const CardTracker &tracker, uint64_t seed)
+            : _settings(settings), _view(view), _observer(observer), _tracker(tracker),
+              _root_difference(view.score_a - view.score_b), _rng(seed) {
+        _nodes.emplace_back();
+    }
+
+    [[nodiscard]] const Node &get_root() const { return _nodes.front(); }
+
+    [[nodiscard]] const Node &get_node(uint32_t node) const { return _nodes[node]; }
+
+    void iterate() {
+        IsmctsSearch::determinize(_view, _observer, _tracker, _rng, _deal);
+        _engine = GameEngine(_deal);
+        _path.clear();
+        _path.push_back(0);
+
+        // down the tree with the moves legal in this deal, then one new node
+        uint32_t node = 0;
+        while (node != no_node && !(_engine.get_state().flags & GameSnapshot::round_finished)) {
+            node = select(node);
+        }
+        // random moves to the end of the round
+        while (!(_engine.get_state().flags & GameSnapshot::round_finished)) {
+            _engine.get_legal_moves(_engine.get_current_player(), _moves);
+            _engine.apply(_moves[_rng.below((uint32_t)_moves.size())]);
+        }
+
+        const double result = result_for_team_a(_engine.get_state(), _root_difference);
+        for (uint32_t on_path: _path) {
+            Node &data = _nodes[on_path];
+            ++data.visits;
+            if (on_path) { data.reward += is_team_a(data.move.player) ? result : 1 - result; }
+        }
+    }
+};
+
+IsmctsSearch::IsmctsSearch(const Settings &settings) : _settings(settings) {
+    if (settings.budget.count() <= 0 && settings.max_iterations == 0) {
+        throw TichuException("IsmctsSearch needs a time or an iteration budget");
+    }
+}
+
+void IsmctsSearch::determinize(const GameSnapshot &view, int observer, const CardTracker &tracker, Xoshiro256 &rng,
+                               GameSnapshot &res) {
+    constexpr int nof_players = GameSnapshot::nof_players;
+    res = view;
+
+    // the cards out are the ones in no won pile, not in the trick and not in the hand of the observer
+    uint64_t out = CardSet::full_mask & ~view.hands[observer] & ~view.trick;
+    for (uint64_t won: view.won) { out &= ~won; }
+
+    std::array<uint64_t, nof_players> excluded{};
+    std::array<int, nof_players> needed{};
+    uint64_t free = out;
+    for (int seat = 0; seat < nof_players; ++seat) {
+        if (seat == observer) { continue; }
+        const uint64_t known = tracker.get_known(observer, seat).get_mask() & free;
+        const int size = std::popcount(view.hands[seat]);
+        if (std::popcount(known) <= size) {
+            res.hands[seat] = known;
+            free &= ~known;
+        } else {
+            res.hands[seat] = 0;
+        }
+        needed[seat] = size - std::popcount(res.hands[seat]);
+        excluded[seat] = tracker.get_excluded(seat).get_mask();
+    }
+
+    std::array<int, card_table::nof_cards> cards{};
+    int nof_cards = 0;
+    for (uint64_t rest = free; rest; rest &= rest - 1) { cards[nof_cards++] = std::countr_zero(rest); }
+
+    std::array<uint64_t, nof_players> hands{};
+    for (int attempt = 0; attempt < max_deal_attempts; ++attempt) {
+        // the last attempt ignores the ruled out ranks, they may come from a misplayed wish
+        const bool ignore_excluded = attempt == max_deal_attempts - 1;
+        std::shuffle(cards.begin(), cards.begin() + nof_cards, rng);
+        std::array<int, nof_players> left = needed;
+        hands = {};
+        bool dealt = true;
+        for (int i = 0; i < nof_cards && dealt; ++i) {
+            const uint64_t card = 1ull << cards[i];
+            // a seat is drawn with a probability proportional to the cards it still takes, that is a uniform deal
+            int total = 0;
+            for (int seat = 0; seat < nof_players; ++seat) {
+                if (ignore_excluded || !(excluded[seat] & card)) { total += left[seat]; }
+            }
+            if (total == 0) {
+                dealt = ignore_excluded;
+                continue;
+            }
+            int pick = (int)rng.below((uint32_t)total);
+            for (int seat = 0; seat < nof_players; ++seat) {
+                if (!ignore_excluded && (excluded[seat] & card)) { continue; }
+                if (pick < left[seat]) {
+                    hands[seat] |= card;
+                    --left[seat];
+                    break;
+                }
+                pick -= left[seat];
+            }
+        }
+        if (dealt) { break; }
+    }
+    for (int seat = 0; seat < nof_players; ++seat) {
+        if (seat != observer) { res.hands[seat] |= hands[seat]; }
+    }
+}
+
+IsmctsResult IsmctsSearch::search(const GameSnapshot &view, int observer, const CardTracker &tracker) const {
+    const auto start = std::chrono::steady_clock::now();
+    const auto deadline = start + _settings.budget;
+    IsmctsResult res;
+
+    std::vector<Move> moves;
+    GameEngine(view).get_legal_moves(observer, moves);
+    if (moves.empty()) { throw TichuException("IsmctsSearch: the observer has no move in the position"); }
+    res.move = moves.front();
+    if (moves.size() == 1) {
+        res.visits.emplace_back(moves.front(), 0);
+        return res;
+    }
+
+    std::atomic<uint64_t> iterations{0};
+    std::mutex result_mutex;
+    auto work = [&](int index) {
+        IsmctsWorker worker(_settings, view, observer, tracker, _settings.seed ^ (0x9E3779B97F4A7C15ull * (index + 1)));
+        while (true) {
+            if (_settings.max_iterations && iterations.fetch_add(1) >= _settings.max_iterations) { break; }
+            if (_settings.budget.count() > 0 && std::chrono::steady_clock::now() >= deadline) { break; }
+            worker.iterate();
+        }
+
+        // the visits of the root moves, added to the ones of the other threads
+        std::lock_guard<std::mutex> lock(result_mutex);
+        for (uint32_t child: worker.get_root().children) {
+            const Node &node = worker.get_node(child);
+            auto it = std::find_if(res.visits.begin(), res.visits.end(),
+                                   [&](const auto &entry) { return entry.first == node.move; });
+            if (it == res.visits.end()) {
+                res.visits.emplace_back(node.move, node.visits);
+            } else {
+                it->second += node.visits;
+            }
+        }
+        res.iterations += worker.get_root().visits;
+    };
+
+    std::vector<std::thread> workers;
+    for (int i = 1; i < _settings.nof_threads; ++i) { workers.emplace_back(work, i); }
+    work(0);
+    for (std::thread &worker: workers) { worker.join(); }
+
+    std::stable_sort(res.visits.begin(), res.visits.end(),
+                     [](const auto &a, const auto &b) { return a.second > b.second; });
+    if (!res.visits.empty()) { res.move = res.visits.front().first; }
+    res.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return res;
+}
@@ -0,0 +1,81 @@
+/*! \class IsmctsSearch
+    \brief Chooses the move of one seat with Information-Set Monte Carlo Tree Search.
+
+ The seat only knows its own hand, the cards played and what a CardTracker has learned about the other hands (the
+ cards it passed in the swap, the ranks ruled out by unfulfilled wishes). Every iteration deals the cards still out
+ to the other seats at random within these constraints (a determinization), walks down the tree with the moves
+ that are legal in that deal, adds one new move and plays the round to its end with random moves on a GameEngine.
+ A node counts how often it was available besides how often it was chosen, and is selected by UCB1 on these counts
+ (SO-ISMCTS, Cowling et al. 2012). Every seat maximizes the result of its own team, the result of a round is the
+ point difference of the teams scaled to [0, 1].
+
+ Each thread grows its own tree from its own deals, the visit counts of the root moves are added up at the end and
+ the move visited most is chosen. The search ends at the time budget or once the iterations of all threads reach the
+ iteration budget, whichever comes first. Bombs out of turn are not searched.
+*/
+
+#ifndef TICHU_ISMCTS_H
+#define TICHU_ISMCTS_H
+
+#include <chrono>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "game_engine.h"
+#include "card_tracker.h"
+#include "cards/xoshiro256.h"
+
+/**
+ * \struct IsmctsResult
+ * \brief The outcome of IsmctsSearch::search.
+ */
+struct IsmctsResult {
+    Move move;
+    // the root moves with their visits summed over all threads, most visited first
+    std::vector<std::pair<Move, uint64_t>> visits;
+    uint64_t iterations = 0;
+    double seconds = 0;
+};
+
+class IsmctsSearch {
+
+public:
+    /**
+     * \struct Settings
+     * \brief The budget and the parameters of a search.
+     */
+    struct Settings {
+        int nof_threads = 1;
+        // 0 for no limit, one of the two budgets has to be set
+        std::chrono::milliseconds budget{1000};
+        uint64_t max_iterations = 0;
+        // the UCB1 exploration constant
+        double exploration = 0.7;
+        uint64_t seed = 0;
+    };
+
+private:
+    Settings _settings;
+
+public:
+    explicit IsmctsSearch(const Settings &settings);
+
+    [[nodiscard]] const Settings &get_settings() const { return _settings; }
+
+    /**
+     * \brief Searches the move of the observer, the position has to be INROUND or SELECTING with the observer to
+     * move. The hands of the other seats in view are not looked at, only their sizes.
+     */
+    [[nodiscard]] IsmctsResult search(const GameSnapshot &view, int observer, const CardTracker &tracker) const;
+
+    /**
+     * \brief Deals the cards out from the view of the observer to the other seats: the known cards to the seats
+     * holding them, the others at random, keeping the size of each hand and the ranks the tracker ruled out where
+     * possible. All other fields of res are copied from view.
+     */
+    static void determinize(const GameSnapshot &view, int observer, const CardTracker &tracker, Xoshiro256 &rng,
+                            GameSnapshot &res);
+};
+
+
+#endif //TICHU_ISMCTS_H
@@ -2,41 +2,68 @@
 
 #include <utility>
 #include <algorithm>
+#include <bit>
 
-hand::hand(std::vector<Card> cards) : _cards(std::move(cards)) {}
+hand::hand(const std::vector<Card> &cards) : _cards(cards) {
+    update_bombs(_cards);
+}
 
-int hand::get_score() const {
-    int res = 0;
-    for (Card card: _cards) {
-        res += card.get_value();
-    }
-    return res;
+hand::hand(const CardSet &cards) : _cards(cards) {
+    update_bombs(_cards);
 }
 
-std::optional<Card> hand::try_get_card(const Card &card) const {
-    auto it = std::find_if(_cards.begin(), _cards.end(),
-                           [&card](const class Card &x) { return x == card; });
-    if (it < _cards.end()) {
-        return *it;
+void hand::get_cards(std::vector<Card> &cards) const {
+    cards.clear();
+    for (Card card: _cards) { cards.push_back(card); }
+}
+
+void hand::update_bombs(const CardSet &changed) {
+    // the Majong (rank 1) can not be part of a bomb
+    for (uint16_t ranks = changed.rank_mask() & ~1u; ranks; ranks &= ranks - 1) {
+        const int rank = std::countr_zero(ranks) + 1;
+        const uint16_t bit = (uint16_t)(1u << (rank - 1));
+        _four_of_a_kind = _cards.count_rank(rank) == card_table::nof_suits ? _four_of_a_kind | bit
+                                                                             : _four_of_a_kind & ~bit;
+    }
+    for (int suit = GREEN; suit <= SCHWARZ; ++suit) {
+        if (changed.suit_mask(suit).empty()) { continue; }
+        const uint16_t ranks = _cards.suit_rank_mask(suit);
+        // starts of runs of 5, spread over the 5 cards of each run
+        const uint16_t starts = ranks & (ranks >> 1) & (ranks >> 2) & (ranks >> 3) & (ranks >> 4);
+        _street_bombs[suit - 1] = starts | (starts << 1) | (starts << 2) | (starts << 3) | (starts << 4);
     }
-    return {};
 }
 
+bool hand::is_bomb(const CardSet &cards) const {
+    if (!has_bomb() || !_cards.contains(cards) || cards.size() < card_table::nof_suits) { return false; }
+    const Card first = *cards.begin();
+
+    // four of a kind
+    if (cards.size() == card_table::nof_suits) {
+        return ((_four_of_a_kind >> (first.get_rank() - 1)) & 1) && cards.count_rank(first.get_rank()) == cards.size();
+    }
+
+    // consecutive cards of a single suit
+    const uint16_t ranks = cards.suit_rank_mask(first.get_suit());
+    if (std::popcount(ranks) != cards.size()) { return false; }
+    const uint16_t run = ranks >> std::countr_zero(ranks);
+    return (run & (run + 1)) == 0 && (ranks & ~_street_bombs[first.get_suit() - 1]) == 0;
+}
 
-std::optional<Card> hand::remove_card(int idx) {
-    return remove_card(_cards.begin() + idx);
+void to_json(nlohmann::json &j, const hand &h) {
+    j = nlohmann::json{{"_cards", h._cards}};
 }
 
-std::optional<Card> hand::remove_card(const Card &card) {
-    auto pos = std::find(_cards.begin(), _cards.end(), card);
-    return remove_card(pos);
+void from_json(const nlohmann::json &j, hand &h) {
+    h._cards = j.at("_cards").get<CardSet>();
+    h._four_of_a_kind = 0;
+    h._street_bombs = {};
+    h.update_bombs(h._cards);
 }
 
-std::optional<Card> hand::remove_card(std::vector<Card>::iterator pos) {
-    if (pos >= _cards.begin() && pos < _cards.end()) {
-        Card res = *pos;
-        _cards.erase(pos);
-        return res;
+std::optional<Card> hand::try_get_card(const Card &card) const {
+    if (_cards.contains(card)) {
+        return card;
     }
     return {};
 }
@@ -47,40 +74,45 @@ std::optional<Card> hand::remove_card(std::vector<Card>::iterator pos) {
 int hand::wrap_up_round() {
     int score = get_score();
     _cards.clear();
+    _four_of_a_kind = 0;
+    _street_bombs = {};
     return score;
 }
 
 int hand::count_occurances(Card card) const {
-    int count = 0;
     if (card.get_rank() == SPECIAL) {
-        for (Card c: _cards) {
-            if (c.get_rank() == card.get_rank() && c.get_suit() == card.get_suit()) { ++count; }
-        }
-    } else {
-        for (Card c: _cards) {
-            if (c.get_rank() == card.get_rank()) { ++count; }
-        }
+        return _cards.contains(card);
     }
-    return count;
+    return _cards.count_rank(card.get_rank());
 }
 
 bool hand::add_card(const Card &new_card, std::string &err) {
-    _cards.push_back(new_card);
-    std::sort(_cards.begin(),_cards.end());
+    if (_cards.contains(new_card)) {
+        err = "Could not add card, as the card is already in the player's hand.";
+        return false;
+    }
+    _cards.insert(new_card);
+    update_bombs(CardSet(new_card));
     return true;
 }
 
 void hand::add_cards(const std::vector<Card> &cards, std::string &err) {
-    for(Card card : cards) {
-        add_card(card, err);
+    add_cards(CardSet(cards), err);
+}
+
+void hand::add_cards(const CardSet &added, std::string &err) {
+    if (!(added & _cards).empty()) {
+        err = "Could not add card, as the card is already in the player's hand.";
     }
+    _cards |= added;
+    update_bombs(added);
 }
 
 std::optional<Card> hand::remove_card(const Card &card, std::string &err) {
-    auto it = std::find_if(_cards.begin(), _cards.end(),
-                           [&card](const class Card &x) { return x == card;});
-    if (it < _cards.end()) {
-        return remove_card(it);
+    if (_cards.contains(card)) {
+        _cards.erase(card);
+        update_bombs(CardSet(card));
+        return card;
     } else {
         err = "Could not play card, as the requested card was not on the player's hand.";
         return {};
@@ -88,15 +120,14 @@ std::optional<Card> hand::remove_card(const Card &card, std::string &err) {
 }
 
 bool hand::remove_cards(const std::vector<Card> &cards, std::string& err) {
-        for(Card card : cards) {
-            if(!(remove_card(card, err))){
-                return false;
-            }
+        CardSet to_remove(cards);
+        if(!_cards.contains(to_remove)) {
+            err = "Could not play card, as the requested card was not on the player's hand.";
+            return false;
         }
+        _cards -= to_remove;
+        update_bombs(to_remove);
         return true;
 }
 
 #endif
-
-
-
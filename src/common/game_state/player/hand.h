@@ -3,52 +3,83 @@
     
  This class manages the cards in a player's hand, providing functions for adding, removing, and
  updating the state of the hand during a Tichu game.
+
+ The hand keeps track of the bombs it holds: the ranks it has all four cards of and, per suit, the ranks that
+ are part of a run of at least 5 cards of that suit. Both are updated on every add and remove for the affected
+ ranks and suits only, so asking whether a player can bomb is O(1).
 */
 
 #ifndef TICHU_HAND_H
 #define TICHU_HAND_H
 
+#include <array>
+#include <cstdint>
 #include <vector>
 #include "../cards/card.h"
+#include "../cards/card_set.h"
 #include "../cards/card_combination.h"
 
 class hand {
 
 private:
-    std::vector<Card> _cards;
+    CardSet _cards;
+    // bit (rank - 1) is set for every rank with all four cards in the hand
+    uint16_t _four_of_a_kind{};
+    // per suit, bit (rank - 1) is set for every card that is part of a street bomb of that suit
+    std::array<uint16_t, card_table::nof_suits> _street_bombs{};
 
     /**
-     * \brief Removes a card from the hand.
-     *
-     * \param pos Iterator pointing to the position of the card to be removed.
-     * \return An optional representing the removed card.
+     * \brief Updates the bomb tracking after the given cards were added or removed.
      */
-    std::optional<Card> remove_card(std::vector<Card>::iterator pos);
-
-    std::optional<Card> remove_card(int idx);
-
-    std::optional<Card> remove_card(const Card &card);
-
+    void update_bombs(const CardSet &changed);
 
 public:
     hand() = default;
 
-    explicit hand(std::vector<Card> cards);
+    explicit hand(const std::vector<Card> &cards);
+
+    explicit hand(const CardSet &cards);
 
     bool operator==(const hand &other) const {
-        for (int i = 0; i < _cards.size(); i++) {
-            if (_cards[i] != other._cards[i]) return false;
-        }
-        return true;
+        return _cards == other._cards;
     }
 
 
 // accessors
     [[nodiscard]] int get_nof_cards() const { return _cards.size(); }
 
-    [[nodiscard]] int get_score() const;
+    [[nodiscard]] int get_score() const { return _cards.score(); }
+
+    /**
+     * \brief Returns the cards of the hand in sorted order.
+     */
+    [[nodiscard]] std::vector<Card> get_cards() const { return _cards.to_vector(); }
+
+    /**
+     * \brief Writes the cards of the hand in sorted order to cards, which keeps its capacity.
+     */
+    void get_cards(std::vector<Card> &cards) const;
 
-    [[nodiscard]] const std::vector<Card> &get_cards() const { return _cards; }
+    [[nodiscard]] const CardSet &get_card_set() const { return _cards; }
+
+    [[nodiscard]] bool has_bomb() const noexcept {
+        return (_four_of_a_kind | _street_bombs[0] | _street_bombs[1] | _street_bombs[2] | _street_bombs[3]) != 0;
+    }
+
+    /**
+     * \brief Bit (rank - 1) is set for every rank the hand holds all four cards of.
+     */
+    [[nodiscard]] uint16_t get_four_of_a_kind_ranks() const noexcept { return _four_of_a_kind; }
+
+    /**
+     * \brief Bit (rank - 1) is set for every card of the suit that is part of a run of at least 5 cards of that suit.
+     */
+    [[nodiscard]] uint16_t get_street_bomb_ranks(int suit) const noexcept { return _street_bombs[suit - 1]; }
+
+    /**
+     * \brief Returns true if the cards are a bomb and all of them are in the hand.
+     */
+    [[nodiscard]] bool is_bomb(const CardSet &cards) const;
 
     /**
      * \brief Attempts to retrieve a card with a specific ID from the hand.
@@ -64,11 +95,14 @@ public:
         int count_occurances(Card card) const;
         bool add_card(const Card &card, std::string &err);
         void add_cards(const std::vector<Card> &cards, std::string &err);
+        void add_cards(const CardSet &cards, std::string &err);
         std::optional<Card> remove_card(const Card &card, std::string& err);
         bool remove_cards(const std::vector<Card> &cards, std::string& err);
 #endif
 
-    NLOHMANN_DEFINE_TYPE_INTRUSIVE(hand, _cards)
+    // only the cards are serialized, the bomb tracking is rebuilt from them
+    friend void to_json(nlohmann::json &j, const hand &h);
+    friend void from_json(const nlohmann::json &j, hand &h);
 };
 
 
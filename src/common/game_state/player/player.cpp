@@ -18,6 +18,12 @@ bool Player::add_card_to_hand(const Card &card, std::string &err) {
     return _hand.add_card(card, err);
 }
 
+bool Player::add_cards_to_hand(const CardSet &cards, std::string &err) {
+    const int nof_cards = _hand.get_nof_cards();
+    _hand.add_cards(cards, err);
+    return _hand.get_nof_cards() == nof_cards + cards.size();
+}
+
 void Player::remove_cards_from_hand(const CardCombination &combi, std::string& err) {
     _hand.remove_cards(combi.get_cards(), err);
 }
@@ -27,6 +33,15 @@ bool Player::add_cards_to_won_pile(const std::vector<CardCombination> &combis, s
     return true;
 }
 
+void Player::restore(const CardSet &hand_cards, const CardSet &won_cards, bool is_finished, bool has_skipped,
+                     Tichu tichu) {
+    _hand = hand(hand_cards);
+    _won_cards = WonCardsPile(won_cards);
+    _is_finished = is_finished;
+    _has_skipped = has_skipped;
+    _tichu = tichu;
+}
+
 void Player::wrap_up_round(std::string &err) {
     _hand.wrap_up_round();
     _won_cards.wrap_up_round();
@@ -101,9 +101,12 @@ public:
 
     [[nodiscard]] int get_nof_won_cards() { return _won_cards.get_nof_cards(); };
 
+    [[nodiscard]] const WonCardsPile &get_won_cards() const noexcept { return _won_cards; }
+
 #ifdef TICHU_SERVER
     // state update functions
     bool add_card_to_hand(const Card &card, std::string& err);
+    bool add_cards_to_hand(const CardSet &cards, std::string& err);
     void remove_cards_from_hand(const CardCombination &cards, std::string& err);
 
     void finish() { _is_finished = true; }
@@ -112,9 +115,14 @@ public:
     
     void wrap_up_round(std::string& err);
     void setup_round(std::string& err) { }
+
+    /**
+     * \brief Overwrites the cards and the round state of the player, used to load a GameSnapshot.
+     */
+    void restore(const CardSet &hand_cards, const CardSet &won_cards, bool is_finished, bool has_skipped, Tichu tichu);
 #endif
 
-    NLOHMANN_DEFINE_TYPE_INTRUSIVE(Player, _id, _player_name, _team, _is_finished, _hand, _won_cards, _tichu)
+    NLOHMANN_DEFINE_TYPE_INTRUSIVE(Player, _id, _player_name, _team, _is_finished, _has_skipped, _hand, _won_cards, _tichu)
 };
 
 using player_ptr = std::shared_ptr<Player>;
@@ -0,0 +1,105 @@
+#include "swap_optimizer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <vector>
+#include "cards/hand_partition.h"
+#include "cards/xoshiro256.h"
+#include "../utils.h"
+
+namespace {
+    constexpr int hand_size = card_table::nof_cards / 4;
+    // a combination more to play costs about two high singles of control, a bomb is worth most of a combination
+    constexpr int combination_weight = 24;
+    constexpr int bomb_weight = 16;
+
+    struct Subset {
+        uint64_t cards;
+        int strength;
+    };
+
+    // calls work(i) for every i in [0, n), the indices are taken in turn by the threads
+    void parallel_for(int n, int nof_threads, const std::function<void(int)> &work) {
+        std::atomic<int> next{0};
+        auto run = [&]() {
+            for (int i = next++; i < n; i = next++) { work(i); }
+        };
+        std::vector<std::thread> workers;
+        for (int i = 1; i < std::min(nof_threads, n); ++i) { workers.emplace_back(run); }
+        run();
+        for (std::thread &worker: workers) { worker.join(); }
+    }
+
+    // the three cards the other seats pass to the seat holding hand, with the swap of GreedyStrategy
+    uint64_t sample_received(uint64_t hand, Xoshiro256 &rng) {
+        std::array<uint8_t, card_table::nof_cards> deck;
+        const int nof_out = rng.shuffle_missing(hand, deck);
+
+        std::array<CardSet, 3> others;
+        for (int i = 0; i < nof_out; ++i) { others[i / hand_size] |= CardSet(Card::from_id(deck[i])); }
+        // the next seat passes its second lowest card to its previous seat, the partner its highest card and the
+        // previous seat its lowest card to its next seat
+        return CardSet(others[0].nth(1)).get_mask() | CardSet(others[1].nth(hand_size - 1)).get_mask()
+               | CardSet(others[2].nth(0)).get_mask();
+    }
+}
+
+SwapOptimizer::SwapOptimizer(const Settings &settings) : _settings(settings) {
+    if (settings.nof_candidates < 1 || settings.nof_samples < 1) {
+        throw TichuException("SwapOptimizer needs at least one candidate and one sample");
+    }
+}
+
+int SwapOptimizer::strength(const CardSet &cards) {
+    const HandPartition partition = HandPartition::solve(cards);
+    return partition.get_control() - combination_weight * partition.size() + bomb_weight * partition.get_nof_bombs();
+}
+
+SwapChoice SwapOptimizer::choose(const CardSet &hand) const {
+    if (hand.size() != hand_size) { throw TichuException("SwapOptimizer: a hand of 14 cards is needed"); }
+    const auto start = std::chrono::steady_clock::now();
+    const std::vector<Card> cards = hand.to_vector();
+
+    // the strength of the cards kept for every set of three cards given
+    std::vector<Subset> subsets;
+    for (int a = 0; a < hand_size; ++a) {
+        for (int b = a + 1; b < hand_size; ++b) {
+            for (int c = b + 1; c < hand_size; ++c) {
+                subsets.push_back({CardSet(std::vector<Card>{cards[a], cards[b], cards[c]}).get_mask(), 0});
+            }
+        }
+    }
+    parallel_for((int)subsets.size(), _settings.nof_threads, [&](int i) {
+        subsets[i].strength = strength(hand - CardSet(subsets[i].cards));
+    });
+    std::stable_sort(subsets.begin(), subsets.end(),
+                     [](const Subset &x, const Subset &y) { return x.strength > y.strength; });
+    subsets.resize(std::min<size_t>(subsets.size(), _settings.nof_candidates));
+
+    // the cards received, the same samples for every candidate
+    std::vector<uint64_t> received(_settings.nof_samples);
+    for (int s = 0; s < _settings.nof_samples; ++s) {
+        Xoshiro256 rng = Xoshiro256::for_index(_settings.seed, s);
+        received[s] = sample_received(hand.get_mask(), rng);
+    }
+    std::vector<int64_t> totals(subsets.size());
+    parallel_for((int)subsets.size(), _settings.nof_threads, [&](int i) {
+        const uint64_t kept = hand.get_mask() & ~subsets[i].cards;
+        int64_t total = 0;
+        for (uint64_t cards_in: received) { total += strength(CardSet(kept | cards_in)); }
+        totals[i] = total;
+    });
+
+    const auto best = (size_t)(std::max_element(totals.begin(), totals.end()) - totals.begin());
+    // the set in ascending order: the lowest card to the next seat, the highest to the partner
+    const std::vector<Card> given = CardSet(subsets[best].cards).to_vector();
+    SwapChoice res;
+    res.cards = {given[0], given[2], given[1]};
+    res.strength = (double)totals[best] / _settings.nof_samples;
+    res.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return res;
+}
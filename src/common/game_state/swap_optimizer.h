@@ -0,0 +1,73 @@
+/*! \class SwapOptimizer
+    \brief Chooses the three cards a hand of 14 passes on in the swap.
+
+ The strength of a hand is read from its HandPartition: fewer combinations are better, a bomb is worth most of a
+ combination and the control of the hand (the highest rank of each combination) breaks the ties, so high cards
+ that lead a combination of their own are kept.
+
+ The choice is made in two steps. The strength of the 11 cards kept is tabulated for all 364 sets of three cards
+ to give; the best of them are the candidates. The cards received in return are then sampled: the other 42 cards
+ are dealt at random and every other seat passes its lowest two cards to its opponents and its highest card to its
+ partner. The candidate whose kept cards with the received cards have the highest mean strength is chosen. Of its
+ three cards the highest goes to the partner, the lowest to the next seat and the third to the previous seat.
+
+ Both steps are spread over the threads. The samples only depend on the seed, so the choice does not depend on the
+ number of threads. A choice takes a few milliseconds on one thread.
+*/
+
+#ifndef TICHU_SWAP_OPTIMIZER_H
+#define TICHU_SWAP_OPTIMIZER_H
+
+#include <array>
+#include <cstdint>
+#include "cards/card.h"
+#include "cards/card_set.h"
+
+/**
+ * \struct SwapChoice
+ * \brief The outcome of SwapOptimizer::choose.
+ */
+struct SwapChoice {
+    // the cards to the next seat, the partner and the previous seat, the order of swap_req
+    std::array<Card, 3> cards{};
+    // mean strength of the hand after the swap over the samples
+    double strength = 0;
+    double seconds = 0;
+};
+
+class SwapOptimizer {
+
+public:
+    /**
+     * \struct Settings
+     * \brief The effort of a choice.
+     */
+    struct Settings {
+        int nof_threads = 1;
+        // the sets of three cards whose responses are sampled
+        int nof_candidates = 24;
+        int nof_samples = 32;
+        uint64_t seed = 0;
+    };
+
+private:
+    Settings _settings;
+
+public:
+    explicit SwapOptimizer(const Settings &settings);
+
+    [[nodiscard]] const Settings &get_settings() const { return _settings; }
+
+    /**
+     * \brief The cards to swap out of a hand of 14 cards.
+     */
+    [[nodiscard]] SwapChoice choose(const CardSet &hand) const;
+
+    /**
+     * \brief The strength of a hand, higher is better. Only hands of the same size compare.
+     */
+    static int strength(const CardSet &cards);
+};
+
+
+#endif //TICHU_SWAP_OPTIMIZER_H
@@ -0,0 +1,112 @@
+#include "tichu_advisor.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <thread>
+#include <vector>
+#include "game_state.h"
+#include "greedy_strategy.h"
+#include "cards/xoshiro256.h"
+#include "../utils.h"
+
+namespace {
+    constexpr int nof_players = GameSnapshot::nof_players;
+    constexpr int hand_size = card_table::nof_cards / nof_players;
+    // the advised seat, the others are counted from it
+    constexpr int seat = 0;
+
+    // deals the cards missing from the advised hand and the other hands, returns true if the seat went out first
+    bool play_sample(uint64_t cards, bool swapped, Xoshiro256 &rng, GameEngine &engine, std::vector<Move> &moves) {
+        std::array<uint8_t, card_table::nof_cards> deck;
+        rng.shuffle_missing(cards, deck);
+
+        GameSnapshot state;
+        state.hands[seat] = cards;
+        int next_card = 0;
+        for (int player = 0; player < nof_players; ++player) {
+            while (std::popcount(state.hands[player]) < hand_size) { state.hands[player] |= 1ull << deck[next_card++]; }
+        }
+
+        if (swapped) {
+            state.phase = GamePhase::INROUND;
+            for (int player = 0; player < nof_players; ++player) {
+                if (state.get_hand(player).contains(ONE)) { state.next = (uint8_t)player; }
+            }
+            engine = GameEngine(state);
+        } else {
+            state.phase = GamePhase::SWAPPING;
+            engine = GameEngine(state);
+            for (int player = 0; player < nof_players; ++player) {
+                engine.apply(GreedyStrategy::swap(player, state.get_hand(player)));
+            }
+        }
+
+        while (!(engine.get_state().flags & GameSnapshot::round_finished)) {
+            const int player = engine.get_current_player();
+            engine.get_legal_moves(player, moves);
+            engine.apply(GreedyStrategy::choose(engine.get_state(), player, moves));
+        }
+        return engine.get_state().get_finisher(0) == seat;
+    }
+}
+
+TichuAdvisor::TichuAdvisor(const Settings &settings) : _settings(settings) {
+    if (settings.budget.count() <= 0 && settings.max_samples == 0) {
+        throw TichuException("TichuAdvisor needs a time or a sample budget");
+    }
+}
+
+TichuAdvice TichuAdvisor::advise(const CardSet &cards, Tichu call, bool swapped) const {
+    if (cards.size() < 8 || cards.size() > hand_size) {
+        throw TichuException("TichuAdvisor: a hand of 8 to 14 cards is needed");
+    }
+    if (swapped && cards.size() != hand_size) {
+        throw TichuException("TichuAdvisor: a swapped hand has 14 cards");
+    }
+    if (call != Tichu::GRAND_TICHU && call != Tichu::TICHU) {
+        throw TichuException("TichuAdvisor: the call has to be a Grand Tichu or a Tichu");
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto deadline = start + _settings.budget;
+    std::atomic<uint64_t> next_sample{0};
+    std::atomic<uint64_t> samples{0};
+    std::atomic<uint64_t> firsts{0};
+
+    auto work = [&]() {
+        GameEngine engine;
+        std::vector<Move> moves;
+        uint64_t done = 0;
+        uint64_t won = 0;
+        while (true) {
+            if (_settings.budget.count() > 0 && std::chrono::steady_clock::now() >= deadline) { break; }
+            const uint64_t index = next_sample++;
+            if (_settings.max_samples && index >= _settings.max_samples) { break; }
+            Xoshiro256 rng = Xoshiro256::for_index(_settings.seed, index);
+            won += play_sample(cards.get_mask(), swapped, rng, engine, moves);
+            ++done;
+        }
+        samples += done;
+        firsts += won;
+    };
+
+    std::vector<std::thread> workers;
+    for (int i = 1; i < _settings.nof_threads; ++i) { workers.emplace_back(work); }
+    work();
+    for (std::thread &worker: workers) { worker.join(); }
+
+    TichuAdvice res;
+    res.samples = samples;
+    if (res.samples) {
+        const double p = (double)firsts / (double)res.samples;
+        const int bonus = call == Tichu::GRAND_TICHU ? 200 : 100;
+        res.probability = p;
+        res.std_error = std::sqrt(p * (1 - p) / (double)res.samples);
+        res.expected_delta = (2 * p - 1) * bonus;
+    }
+    res.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return res;
+}
@@ -0,0 +1,80 @@
+/*! \class TichuAdvisor
+    \brief Estimates the chance of a hand to go out first, to decide on a Grand Tichu or a Tichu call.
+
+ The advisor sees the cards of one seat, the first 8 cards of a deal for a Grand Tichu or the 14 cards before or
+ after the swap for a Tichu. Every sample completes the deal at random: the missing cards of the hand and the hands
+ of the other seats. Unless the hand was swapped already, all seats pass their lowest two cards to the opponents and
+ their highest card to the partner. The round is then played out on a GameEngine by every seat with the moves of
+ the GreedyStrategy: lead the longest combination, beat a trick as low as possible, keep the bombs and let the
+ partner's tricks pass.
+
+ The probability is the share of samples in which the seat finished first, given with its standard error. It holds
+ for the playout policy, a hand played with more care against opponents who defend goes out first somewhat less
+ often than the greedy playouts let it. The expected score delta is what the call adds to the score of the team on
+ average: the bonus when the seat goes out first, minus the bonus otherwise.
+
+ Samples are spread over the threads, sample i is drawn from a generator seeded with the seed and i, so a search
+ bounded by the number of samples gives the same result with any number of threads. A sample takes a few hundred
+ microseconds, the default budget of 20 ms gives some hundred samples per thread.
+*/
+
+#ifndef TICHU_TICHU_ADVISOR_H
+#define TICHU_TICHU_ADVISOR_H
+
+#include <chrono>
+#include <cstdint>
+#include "game_engine.h"
+#include "cards/card_set.h"
+#include "player/player.h"
+
+/**
+ * \struct TichuAdvice
+ * \brief The outcome of TichuAdvisor::advise.
+ */
+struct TichuAdvice {
+    // share of the samples in which the seat finished first
+    double probability = 0;
+    double std_error = 0;
+    // points the call adds to the score of the team on average, positive if the call is worth making
+    double expected_delta = 0;
+    uint64_t samples = 0;
+    double seconds = 0;
+};
+
+class TichuAdvisor {
+
+public:
+    /**
+     * \struct Settings
+     * \brief The budget of an advice.
+     */
+    struct Settings {
+        int nof_threads = 1;
+        // 0 for no limit, one of the two budgets has to be set
+        std::chrono::milliseconds budget{20};
+        uint64_t max_samples = 0;
+        uint64_t seed = 0;
+    };
+
+private:
+    Settings _settings;
+
+public:
+    explicit TichuAdvisor(const Settings &settings);
+
+    [[nodiscard]] const Settings &get_settings() const { return _settings; }
+
+    /**
+     * \brief Estimates the chance of the cards to go out first and the value of the call (Tichu::GRAND_TICHU or
+     * Tichu::TICHU). cards holds 8 to 14 cards, a hand of 14 cards is swapped in the samples unless swapped is set.
+     */
+    [[nodiscard]] TichuAdvice advise(const CardSet &cards, Tichu call, bool swapped = false) const;
+
+    /**
+     * \brief Whether the advice is to make the call.
+     */
+    static bool should_call(const TichuAdvice &advice) { return advice.expected_delta > 0; }
+};
+
+
+#endif //TICHU_TICHU_ADVISOR_H
@@ -0,0 +1,81 @@
+#include "zobrist.h"
+
+#include <array>
+#include <bit>
+#include "cards/card.h"
+
+namespace {
+    constexpr int nof_bytes = (card_table::nof_cards + 7) / 8;
+    // phase, next, last, start, wish, finish_order, nof_finished, skipped, responded, tichu
+    constexpr int nof_scalar_fields = 10;
+    // followed by the card ids handed in during the swap, one field per entry of GameSnapshot::swaps
+    constexpr int nof_swap_fields = GameSnapshot::nof_players * (GameSnapshot::nof_players - 1);
+    constexpr int nof_fields = nof_scalar_fields + nof_swap_fields;
+
+    constexpr uint64_t splitmix64(uint64_t &state) {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    struct Keys {
+        // cards[location][byte][value]: the XOR of the keys of the cards set in value at that byte of the mask
+        std::array<std::array<std::array<uint64_t, 256>, nof_bytes>, Zobrist::nof_locations> cards{};
+        std::array<std::array<uint64_t, 256>, nof_fields> fields{};
+        uint64_t top_key_seed{};
+
+        constexpr Keys() {
+            uint64_t state = 0x7C3A1F5E2B94D068ull;
+            for (auto &location: cards) {
+                for (auto &byte: location) {
+                    uint64_t card_keys[8];
+                    for (uint64_t &key: card_keys) { key = splitmix64(state); }
+                    for (int value = 1; value < 256; ++value) {
+                        // value without its lowest bit was filled before
+                        byte[value] = byte[value & (value - 1)] ^ card_keys[std::countr_zero((unsigned)value)];
+                    }
+                }
+            }
+            for (auto &field: fields) {
+                for (uint64_t &key: field) { key = splitmix64(state); }
+            }
+            top_key_seed = splitmix64(state);
+        }
+    };
+
+    constexpr Keys keys;
+}
+
+uint64_t Zobrist::cards(int location, uint64_t mask) noexcept {
+    const auto &tables = keys.cards[location];
+    uint64_t res = 0;
+    for (int byte = 0; mask; ++byte, mask >>= 8) {
+        res ^= tables[byte][mask & 0xFF];
+    }
+    return res;
+}
+
+uint64_t Zobrist::fields(const GameSnapshot &snapshot) noexcept {
+    const uint8_t values[nof_scalar_fields] = {snapshot.phase, snapshot.next, snapshot.last, snapshot.start,
+                                               snapshot.wish, snapshot.finish_order, snapshot.nof_finished,
+                                               snapshot.skipped, snapshot.responded, snapshot.tichu};
+    uint64_t res = 0;
+    for (int field = 0; field < nof_scalar_fields; ++field) { res ^= keys.fields[field][values[field]]; }
+    // the hands only change once all four players swapped, until then the cards handed in tell positions apart
+    const uint8_t *swaps = &snapshot.swaps[0][0];
+    for (int field = 0; field < nof_swap_fields; ++field) {
+        res ^= keys.fields[nof_scalar_fields + field][swaps[field]];
+    }
+    // the key of the top combination only matters for the rank of a single Phoenix, it is mixed instead of looked up
+    uint64_t top_key = keys.top_key_seed ^ snapshot.top_key;
+    return res ^ splitmix64(top_key);
+}
+
+uint64_t Zobrist::hash(const GameSnapshot &snapshot) noexcept {
+    uint64_t res = fields(snapshot);
+    for (int i = 0; i < GameSnapshot::nof_players; ++i) {
+        res ^= cards(HAND + i, snapshot.hands[i]) ^ cards(WON + i, snapshot.won[i]);
+    }
+    return res ^ cards(TRICK, snapshot.trick) ^ cards(TOP, snapshot.top);
+}
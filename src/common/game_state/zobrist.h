@@ -0,0 +1,53 @@
+/*! \class Zobrist
+    \brief 64-bit Zobrist keys of game positions.
+
+ Every card has a random key per location (the hand and the won pile of each player, the trick and the top
+ combination), every value of the small fields of a GameSnapshot (phase, next, last and starting player, wish,
+ finish order, passes, Tichu calls, swap answers and the cards handed in during the swap) has one as well. The key of a position is the XOR of the keys of all its
+ features, the scores are not part of it. As XOR is linear, the key of a set of cards in a location is looked up
+ one byte of the card mask at a time from tables combining the keys of 8 cards, so moving any number of cards
+ costs at most 7 lookups per location.
+
+ The GameEngine keeps GameSnapshot::hash up to date while it applies moves, GameState::to_snapshot computes it
+ from scratch. Equal positions have equal keys, so they serve transposition tables and quick equality checks.
+*/
+
+#ifndef TICHU_ZOBRIST_H
+#define TICHU_ZOBRIST_H
+
+#include <cstdint>
+#include "game_snapshot.h"
+
+class Zobrist {
+
+public:
+    /**
+     * \enum Location
+     * \brief The places a card can be in, the hands and won piles are followed by the ones of players 1 to 3.
+     */
+    enum Location {
+        HAND = 0,
+        WON = HAND + GameSnapshot::nof_players,
+        TRICK = WON + GameSnapshot::nof_players,
+        TOP,
+        nof_locations
+    };
+
+    /**
+     * \brief The key of the cards of mask in the location, the XOR of the keys of the single cards.
+     */
+    static uint64_t cards(int location, uint64_t mask) noexcept;
+
+    /**
+     * \brief The key of every feature of the snapshot besides the card locations.
+     */
+    static uint64_t fields(const GameSnapshot &snapshot) noexcept;
+
+    /**
+     * \brief The key of the snapshot, computed from scratch. GameSnapshot::hash itself is ignored.
+     */
+    static uint64_t hash(const GameSnapshot &snapshot) noexcept;
+};
+
+
+#endif //TICHU_ZOBRIST_H
@@ -18,7 +18,8 @@ void tcp_listener(sockpp::stream_socket socket,
 
         int msg_size;
         try {
-            msg_size = (int) std::stoul(msg_size_buff, nullptr, 16); // 16 for hexadecimal
+            // the buffer is not null terminated, only its MSG_LEN_SIZE characters are parsed
+            msg_size = (int) std::stoul(std::string(msg_size_buff, MSG_LEN_SIZE), nullptr, 16); // 16 for hexadecimal
         } catch (std::exception &e) {
             // maybe delimiter so we can try to recover, but since its tcp not sure if necessary
             ERROR("while trying to parse message size from string: {}", msg_size_buff);
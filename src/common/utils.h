@@ -265,7 +265,7 @@ public:
         if (_queue.empty()) {
             return {};
         } else {
-            T res = _queue.back();
+            T res = _queue.front();
             _queue.pop();
             return res;
         }
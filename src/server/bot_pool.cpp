@@ -0,0 +1,71 @@
+// The bot_pool only exists on the server side. It runs the work of all bot seats on a fixed number of threads.
+
+#include "bot_pool.h"
+
+#include <iostream>
+
+bot_pool::State &bot_pool::state() {
+    static State *state = []() {
+        auto *res = new State();
+        res->settings.budget = std::chrono::milliseconds(500);
+        return res;
+    }();
+    return *state;
+}
+
+void bot_pool::worker_loop() {
+    while (true) {
+        std::function<void()> job;
+        {
+            State &pool = state();
+            std::unique_lock<std::mutex> lock(pool.lock);
+            pool.job_added.wait(lock, [&]() { return !pool.jobs.empty(); });
+            job = std::move(pool.jobs.front());
+            pool.jobs.pop_front();
+        }
+        try {
+            job();
+        } catch (std::exception &e) {
+            std::cerr << "A bot failed to answer: " << e.what() << std::endl;
+        }
+    }
+}
+
+void bot_pool::set_nof_threads(int nof_threads) {
+    State &pool = state();
+    std::lock_guard<std::mutex> lock(pool.lock);
+    if (!pool.started) { pool.nof_threads = std::max(nof_threads, 1); }
+}
+
+int bot_pool::get_nof_threads() {
+    State &pool = state();
+    std::lock_guard<std::mutex> lock(pool.lock);
+    return pool.nof_threads;
+}
+
+void bot_pool::set_settings(const IsmctsSearch::Settings &settings) {
+    State &pool = state();
+    std::lock_guard<std::mutex> lock(pool.lock);
+    pool.settings = settings;
+    pool.settings.nof_threads = 1;
+}
+
+IsmctsSearch::Settings bot_pool::get_settings() {
+    State &pool = state();
+    std::lock_guard<std::mutex> lock(pool.lock);
+    return pool.settings;
+}
+
+void bot_pool::submit(std::function<void()> job) {
+    State &pool = state();
+    {
+        std::lock_guard<std::mutex> lock(pool.lock);
+        pool.jobs.push_back(std::move(job));
+        if (!pool.started) {
+            pool.started = true;
+            // the workers wait for jobs as long as the server runs
+            for (int i = 0; i < pool.nof_threads; ++i) { std::thread(worker_loop).detach(); }
+        }
+    }
+    pool.job_added.notify_one();
+}
@@ -0,0 +1,61 @@
+/*! \class bot_pool
+    \brief The threads all bot seats of the server compute their moves on.
+
+ The bot_pool only exists on the server side. Bot seats of every GameInstance queue their work here, a fixed number
+ of worker threads runs it, so the CPU time the bots take is bounded however many tables they play at. Each search
+ of a bot runs on a single thread of the pool. The number of threads and the settings of the bots are set before
+ the first bot is seated, the threads start with the first job.
+*/
+
+#ifndef TICHU_BOT_POOL_H
+#define TICHU_BOT_POOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../common/game_state/ismcts.h"
+
+class bot_pool {
+
+private:
+    struct State {
+        std::mutex lock;
+        std::condition_variable job_added;
+        std::deque<std::function<void()>> jobs;
+        int nof_threads = (int)std::max(std::thread::hardware_concurrency(), 1u);
+        bool started = false;
+        IsmctsSearch::Settings settings;
+    };
+
+    // never destroyed, the detached workers wait on it until the process ends
+    static State &state();
+
+    static void worker_loop();
+
+public:
+    /**
+     * \brief Sets the number of worker threads, only before the first job.
+     */
+    static void set_nof_threads(int nof_threads);
+
+    static int get_nof_threads();
+
+    /**
+     * \brief Sets the search settings of the bots seated from now on, the number of threads is always 1.
+     */
+    static void set_settings(const IsmctsSearch::Settings &settings);
+
+    static IsmctsSearch::Settings get_settings();
+
+    /**
+     * \brief Queues a job, the jobs are started in the order they were queued.
+     */
+    static void submit(std::function<void()> job);
+};
+
+
+#endif //TICHU_BOT_POOL_H
@@ -0,0 +1,61 @@
+#include "bot_seat.h"
+
+#include <iostream>
+
+#include "bot_pool.h"
+#include "game_instance.h"
+
+BotSeat::BotSeat(player_ptr player, std::weak_ptr<GameInstance> game, const IsmctsSearch::Settings &settings)
+        : _player(player), _bot(player->get_id(), player->get_player_name(), 0, settings), _game(std::move(game)) {}
+
+void BotSeat::deliver(full_state_response state) {
+    std::lock_guard<std::mutex> lock(_lock);
+    _inbox.push_back(std::move(state));
+    if (!_scheduled) {
+        _scheduled = true;
+        bot_pool::submit([seat = shared_from_this()]() { seat->run(); });
+    }
+}
+
+void BotSeat::run() {
+    std::deque<full_state_response> states;
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        states.swap(_inbox);
+        if (states.empty()) {
+            _scheduled = false;
+            return;
+        }
+    }
+
+    // a state the bot fails on is skipped. Nothing may leave the job before it is queued again, the seat would
+    // never be scheduled again and its table would stall
+    for (size_t i = 0; i < states.size(); ++i) {
+        try {
+            if (i + 1 < states.size()) {
+                _bot.observe(states[i]);
+            } else {
+                answer(states[i]);
+            }
+        } catch (std::exception &e) {
+            std::cerr << "Bot " << _player->get_player_name() << " failed on a state: " << e.what() << std::endl;
+        }
+    }
+
+    // the states that arrived meanwhile are answered in a new job, so the bots of all tables take turns
+    bot_pool::submit([seat = shared_from_this()]() { seat->run(); });
+}
+
+void BotSeat::answer(const full_state_response &state) {
+    std::optional<ClientMsg> request = _bot.process(state);
+    std::shared_ptr<GameInstance> game = _game.lock();
+    if (request && game) {
+        std::string err;
+        if (!game->handle_bot_request(_player, *request, err)) {
+            request = _bot.process(ServerMsg(server_message{MessageType::Info, err}));
+            if (request && !game->handle_bot_request(_player, *request, err)) {
+                std::cerr << "Bot " << _player->get_player_name() << " could not act: " << err << std::endl;
+            }
+        }
+    }
+}
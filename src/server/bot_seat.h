@@ -0,0 +1,55 @@
+/*! \class BotSeat
+    \brief A seat of a GameInstance played by a BotPlayer inside the server.
+
+ The GameInstance hands the seat a copy of every state it would send to the player, with its events, instead of
+ writing it to a socket. The states are queued and answered on the bot_pool, one job per seat at a time, so the bot
+ sees its states in order. States followed by newer ones before the bot got to them only update what the bot knows,
+ the newest one is answered. The request of the bot is applied to the GameInstance directly, a request it rejects
+ is followed by the fallback of the bot. A state the bot throws on is logged and skipped.
+*/
+
+#ifndef TICHU_BOT_SEAT_H
+#define TICHU_BOT_SEAT_H
+
+#include <deque>
+#include <memory>
+#include <mutex>
+
+#include "../common/bot_player.h"
+
+class GameInstance;
+
+class BotSeat : public std::enable_shared_from_this<BotSeat> {
+
+private:
+    player_ptr _player;
+    BotPlayer _bot;
+    std::weak_ptr<GameInstance> _game;
+
+    std::mutex _lock;
+    std::deque<full_state_response> _inbox;
+    bool _scheduled = false;
+
+    void run();
+
+    /**
+     * \brief Answers the newest state, the request of the bot is applied to the game.
+     */
+    void answer(const full_state_response &state);
+
+public:
+    /**
+     * \brief A bot playing the player, which may be a new player or one taken over.
+     */
+    BotSeat(player_ptr player, std::weak_ptr<GameInstance> game, const IsmctsSearch::Settings &settings);
+
+    [[nodiscard]] const player_ptr &get_player() const { return _player; }
+
+    /**
+     * \brief Queues a state for the bot, the state must not share its players with the game (see GameState::clone).
+     */
+    void deliver(full_state_response state);
+};
+
+
+#endif //TICHU_BOT_SEAT_H
@@ -1,7 +1,10 @@
 #include "game_instance.h"
 
+#include <algorithm>
+#include <iostream>
 #include <utility>
 #include "server_network_manager.h"
+#include "bot_pool.h"
 
 
 GameInstance::GameInstance()
@@ -12,6 +15,22 @@ const GameState &GameInstance::get_game_state() {
     return _game_state;
 }
 
+GameState GameInstance::clone_game_state() {
+    std::lock_guard<std::mutex> lock(modification_lock);
+    return _game_state.clone();
+}
+
+std::optional<std::chrono::steady_clock::time_point> GameInstance::get_waiting_since() {
+    std::lock_guard<std::mutex> lock(modification_lock);
+    return _waiting_since;
+}
+
+bool GameInstance::is_bot(const UUID &player_id) {
+    std::lock_guard<std::mutex> lock(modification_lock);
+    return std::any_of(_bot_seats.begin(), _bot_seats.end(),
+                       [&](const std::shared_ptr<BotSeat> &seat) { return seat->get_player()->get_id() == player_id; });
+}
+
 bool GameInstance::is_player_allowed_to_play(const Player &player) {
     return _game_state.is_allowed_to_play_now(player);
 }
@@ -22,7 +41,8 @@ bool GameInstance::is_full() {
 
 bool GameInstance::is_started() {
     GamePhase game_phase = _game_state.get_game_phase();
-    return (game_phase == GamePhase::INROUND) || (game_phase == GamePhase::PREROUND) || (game_phase == GamePhase::SWAPPING);
+    return (game_phase == GamePhase::INROUND) || (game_phase == GamePhase::PREROUND) || (game_phase == GamePhase::SWAPPING)
+           || (game_phase == GamePhase::SELECTING);
     
 }
 
@@ -31,21 +51,28 @@ bool GameInstance::is_finished() {
 }
 
 
-void send_full_state_response(const Player &recipient, const GameState &state, const std::vector<Event> events) {
-    auto update_msg = full_state_response{ state, events };
+void GameInstance::send_state(const Player &recipient, const std::vector<Event> &events) {
+    for (const std::shared_ptr<BotSeat> &seat: _bot_seats) {
+        if (seat->get_player()->get_id() == recipient.get_id()) {
+            // the bot reads the state later on, the players of the game change meanwhile
+            seat->deliver(full_state_response{_game_state.clone(), events});
+            return;
+        }
+    }
+    auto update_msg = full_state_response{ _game_state, events };
     auto resp = ServerMsg(update_msg);
-    server_network_manager::broadcast_single_message(resp, state.get_players(), recipient);
+    server_network_manager::broadcast_single_message(resp, _game_state.get_players(), recipient);
 }
 
 
-bool GameInstance::play_combi(const player_ptr& player, CardCombination &combi, std::string &err, std::optional<Card> wish) {
+bool GameInstance::play_combi(const player_ptr& player, const CardCombination &combi, std::string &err, std::optional<Card> wish) {
     modification_lock.lock();
     std::vector<Event> events;
     if (_game_state.play_combi(*player, combi, events, err, wish)) {
 
         // Send Full_state_respnse
         for(auto recipient : _game_state.get_players()){
-            send_full_state_response(*recipient, _game_state, {events});
+            send_state(*recipient, {events});
         }
 
         modification_lock.unlock();
@@ -64,7 +91,7 @@ bool GameInstance::call_grand_tichu(const player_ptr &player, Tichu tichu, std::
                     if(player->get_tichu() == Tichu::GRAND_TICHU) {
                         events.push_back({EventType::GRAND_TICHU, player->get_id(), {}, {}, {}});
                     }
-                    send_full_state_response(*recipient, _game_state, events);
+                    send_state(*recipient, events);
             }
             
         modification_lock.unlock();
@@ -80,7 +107,7 @@ bool GameInstance::call_small_tichu(const player_ptr &player, Tichu tichu, std::
         // send state update to all players
         for(auto recipient : _game_state.get_players()){
                 Event event{EventType::SMALL_TICHU, player->get_id(), {}, {}, {}};
-                send_full_state_response(*recipient, _game_state, {event});
+                send_state(*recipient, {event});
         }
         modification_lock.unlock();
         return true;
@@ -99,7 +126,7 @@ bool GameInstance::swap_cards(const player_ptr &player, const std::vector<Card>
         auto players = _game_state.get_players();
         for(int i = 0 ; i < 4 ; ++i) {
             if( !(events_vec.at(i).empty()) ){
-                send_full_state_response(*(_game_state.get_players().at(i)), _game_state, events_vec.at(i));
+                send_state(*(_game_state.get_players().at(i)), events_vec.at(i));
             }
         }      
         
@@ -116,7 +143,7 @@ bool GameInstance::dragon_selection(const player_ptr &player, UUID selected_play
         // send state update to all players
         for(auto recipient : _game_state.get_players()){
             Event event{EventType::SELECTION_END, selected_player, {}, {}, {}};
-            send_full_state_response(*recipient, _game_state, {event});
+            send_state(*recipient, {event});
         }
 
         modification_lock.unlock();
@@ -129,10 +156,14 @@ bool GameInstance::dragon_selection(const player_ptr &player, UUID selected_play
 bool GameInstance::start_game(player_ptr player, std::string &err) {
     modification_lock.lock();
     if (_game_state.start_game(err)) {
+        // the seed replays the team draw and the deals of this game
+        std::cout << "Started game " << _game_state.get_id().string() << " with seed " << _game_state.get_seed()
+                  << std::endl;
+        _waiting_since.reset();
         // send state update to all players
         for(auto recipient : _game_state.get_players()){
             Event event{EventType::GAME_START, {}, {}, {}, {}};
-            send_full_state_response(*recipient, _game_state, {event});
+            send_state(*recipient, {event});
         }
 
         modification_lock.unlock();
@@ -149,9 +180,13 @@ bool GameInstance::try_remove_player(player_ptr player, std::string &err) {
         for(auto recipient : _game_state.get_players()){
             if(*recipient != *player) {
                 Event event{EventType::PLAYER_LEFT, player->get_id(), {}, {}, {}};
-                send_full_state_response(*recipient, _game_state, {event});
+                send_state(*recipient, {event});
             }
         }
+        if (_game_state.get_players().empty()) {
+            _waiting_since.reset();
+        }
+        modification_lock.unlock();
         return true;
     }
     modification_lock.unlock();
@@ -161,9 +196,12 @@ bool GameInstance::try_remove_player(player_ptr player, std::string &err) {
 bool GameInstance::try_add_player(player_ptr new_player, std::string &err) {
     modification_lock.lock();
     if (_game_state.add_player(new_player, err)) {
+        if (!_waiting_since) {
+            _waiting_since = std::chrono::steady_clock::now();
+        }
         // send state update to all players
         for(auto recipient : _game_state.get_players()){
-                send_full_state_response(*recipient, _game_state, {});
+                send_state(*recipient, {});
         }
 
         modification_lock.unlock();
@@ -173,3 +211,81 @@ bool GameInstance::try_add_player(player_ptr new_player, std::string &err) {
     return false;
 }
 
+bool GameInstance::fill_with_bots(std::string &err) {
+    // the seat of a bot may throw on invalid settings, the lock is released on every path
+    std::lock_guard<std::mutex> lock(modification_lock);
+    if (is_started() || is_finished()) {
+        err = "Could not seat bots, because the game is already started.";
+        return false;
+    }
+    const IsmctsSearch::Settings settings = bot_pool::get_settings();
+    for (int i = 1; !_game_state.is_full(); ++i) {
+        auto bot = std::make_shared<Player>(UUID::create(), "bot " + std::to_string(i), Team::RANDOM);
+        // the seat is created before the bot joins, no bot is left without a seat
+        auto seat = std::make_shared<BotSeat>(bot, weak_from_this(), settings);
+        if (!_game_state.add_player(bot, err)) {
+            return false;
+        }
+        bot->set_game_id(_game_state.get_id());
+        _bot_seats.push_back(seat);
+    }
+    if (!_game_state.start_game(err)) {
+        return false;
+    }
+    _waiting_since.reset();
+    std::cout << "Started game " << _game_state.get_id().string() << " with " << _bot_seats.size()
+              << " bots and seed " << _game_state.get_seed() << std::endl;
+    for(auto recipient : _game_state.get_players()){
+        Event event{EventType::GAME_START, {}, {}, {}, {}};
+        send_state(*recipient, {event});
+    }
+    return true;
+}
+
+bool GameInstance::replace_with_bot(const player_ptr &player, std::string &err) {
+    std::lock_guard<std::mutex> lock(modification_lock);
+    if (!is_started()) {
+        err = "Only a player of a running game can be replaced by a bot.";
+        return false;
+    }
+    const auto &players = _game_state.get_players();
+    if (std::none_of(players.begin(), players.end(), [&](const player_ptr &p) { return *p == *player; })) {
+        err = "The player " + player->get_player_name() + " does not play in this game.";
+        return false;
+    }
+    for (const std::shared_ptr<BotSeat> &seat: _bot_seats) {
+        if (seat->get_player()->get_id() == player->get_id()) {
+            err = "The player " + player->get_player_name() + " is already played by a bot.";
+            return false;
+        }
+    }
+
+    std::cout << "A bot takes over " << player->get_player_name() << " in game " << _game_state.get_id().string()
+              << std::endl;
+    _bot_seats.push_back(std::make_shared<BotSeat>(player, weak_from_this(), bot_pool::get_settings()));
+    for(auto recipient : _game_state.get_players()){
+        Event event{EventType::PLAYER_LEFT, player->get_id(), {}, {}, {}};
+        send_state(*recipient, {event});
+    }
+    return true;
+}
+
+bool GameInstance::handle_bot_request(const player_ptr &player, const ClientMsg &msg, std::string &err) {
+    switch (msg.get_type()) {
+        case ClientMsgType::call_grand_tichu:
+            return call_grand_tichu(player, msg.get_msg_data<grand_tichu_req>().grand_tichu_call, err);
+        case ClientMsgType::call_small_tichu:
+            return call_small_tichu(player, msg.get_msg_data<small_tichu_req>().small_tichu_call, err);
+        case ClientMsgType::swap:
+            return swap_cards(player, msg.get_msg_data<swap_req>().cards, err);
+        case ClientMsgType::dragon:
+            return dragon_selection(player, msg.get_msg_data<dragon_req>().selected_player, err);
+        case ClientMsgType::play_combi: {
+            const auto data = msg.get_msg_data<play_combi_req>();
+            return play_combi(player, data.played_combi, err, data.wish);
+        }
+        default:
+            err = "A bot can not send a request of type " + std::to_string((int)msg.get_type());
+            return false;
+    }
+}
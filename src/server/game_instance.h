@@ -4,25 +4,37 @@
 
  The GameInstance class is a wrapper around the GameState of an active instance of the game.
  This class contains functions to modify the contained GameState.
+ Seats can be played by bots of the server (see BotSeat), which get the updates of the game without a connection
+ and make their requests through handle_bot_request.
 */
 
 #ifndef TICHU_GAME_H
 #define TICHU_GAME_H
 
+#include <chrono>
+#include <memory>
 #include <vector>
 #include <string>
 #include <mutex>
 
 #include "../common/game_state/player/player.h"
 #include "../common/game_state/game_state.h"
+#include "../common/messages.h"
+#include "bot_seat.h"
 
-class GameInstance {
+class GameInstance : public std::enable_shared_from_this<GameInstance> {
 
 private:
     GameState _game_state;
+    std::vector<std::shared_ptr<BotSeat>> _bot_seats;
+    // when the first player joined, while the game is not started
+    std::optional<std::chrono::steady_clock::time_point> _waiting_since;
 
     bool is_player_allowed_to_play(const Player &player);
 
+    // sends the state to the recipient, over the network or to its bot seat
+    void send_state(const Player &recipient, const std::vector<Event> &events);
+
     inline static std::mutex modification_lock;
 
 public:
@@ -32,12 +44,24 @@ public:
 
     const GameState &get_game_state();
 
+    /**
+     * \brief A copy of the game that does not change with it, taken under the lock of the game.
+     */
+    [[nodiscard]] GameState clone_game_state();
+
     bool is_full();
 
     bool is_started();
 
     bool is_finished();
 
+    /**
+     * \brief Since when the first player waits for the game to start, empty if nobody waits.
+     */
+    std::optional<std::chrono::steady_clock::time_point> get_waiting_since();
+
+    [[nodiscard]] bool is_bot(const UUID &player_id);
+
     /** 
      * game update functions
     */ 
@@ -47,7 +71,7 @@ public:
 
     bool try_remove_player(player_ptr player, std::string &err);
 
-    bool play_combi(const player_ptr& player, CardCombination &combi, std::string &err, std::optional<Card> wish = {});
+    bool play_combi(const player_ptr& player, const CardCombination &combi, std::string &err, std::optional<Card> wish = {});
 
     bool call_grand_tichu(const player_ptr& player, Tichu tichu, std::string &err);
 
@@ -57,8 +81,22 @@ public:
 
     bool dragon_selection(const player_ptr& player, UUID selected_player, std::string &err);
 
+    /**
+     * \brief Seats bots on the empty seats of a game that is not started and starts it.
+     */
+    bool fill_with_bots(std::string &err);
+
+    /**
+     * \brief Lets a bot play the seat of the player for the rest of a started game.
+     */
+    bool replace_with_bot(const player_ptr &player, std::string &err);
+
+    /**
+     * \brief Applies the request of a bot seat to the game, like the request_handler does for a client.
+     */
+    bool handle_bot_request(const player_ptr &player, const ClientMsg &msg, std::string &err);
+
 };
 
 
 #endif //TICHU_GAME_H
-
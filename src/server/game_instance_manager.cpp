@@ -8,6 +8,9 @@
 #include "player_manager.h"
 #include "server_network_manager.h"
 
+#include <iostream>
+#include <thread>
+
 // Initialize static map
 std::unordered_map<UUID, std::shared_ptr<GameInstance>> game_instance_manager::games_lut = {};
 
@@ -42,7 +45,7 @@ game_instance_ptr game_instance_manager::find_joinable_game_instance() {
 }
 
 std::shared_ptr<GameInstance> game_instance_manager::create_new_game() {
-    std::shared_ptr<GameInstance> new_game = std::make_shared<GameInstance>(GameInstance());
+    std::shared_ptr<GameInstance> new_game = std::make_shared<GameInstance>();
     games_lut_lock.lock();  // exclusive
     game_instance_manager::games_lut.insert({new_game->get_id(), new_game});
     games_lut_lock.unlock();
@@ -132,3 +135,56 @@ bool game_instance_manager::try_remove_player(player_ptr player, GameInstance &g
     return game_instance_ptr.try_remove_player(player, err);
 }
 
+void game_instance_manager::start_matchmaking(std::chrono::seconds bot_timeout) {
+    std::thread matchmaker([bot_timeout]() {
+        // intentional endless loop, the waiting games are checked every second. An exception would end the detached
+        // thread and with it the server, it is logged and the games are checked again
+        while (true) {
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+            try {
+                fill_waiting_games(bot_timeout);
+            } catch (std::exception &e) {
+                std::cerr << "Could not fill the waiting games with bots: " << e.what() << std::endl;
+            }
+        }
+    });
+    matchmaker.detach();
+}
+
+void game_instance_manager::fill_waiting_games(std::chrono::steady_clock::duration timeout) {
+    const auto now = std::chrono::steady_clock::now();
+    std::vector<game_instance_ptr> waiting;
+    games_lut_lock.lock_shared();
+    for (auto &[game_id, game]: games_lut) {
+        auto since = game->get_waiting_since();
+        if (since && now - since.value() >= timeout) {
+            waiting.push_back(game);
+        }
+    }
+    games_lut_lock.unlock_shared();
+
+    for (auto &game: waiting) {
+        std::string err;
+        if (!game->fill_with_bots(err)) {
+            std::cerr << "Could not fill game " << game->get_id().string() << " with bots: " << err << std::endl;
+        }
+    }
+}
+
+void game_instance_manager::on_player_disconnected(const UUID &player_id) {
+    std::string err;
+    auto game_and_player = try_get_player_and_game_instance(player_id, err);
+    if (!game_and_player) {
+        return;     // the player was not in a game
+    }
+    auto [player, game_instance] = game_and_player.value();
+    if (game_instance->is_finished()) {
+        return;
+    }
+    bool success = game_instance->is_started() ? game_instance->replace_with_bot(player, err)
+                                               : game_instance->try_remove_player(player, err);
+    if (!success) {
+        std::cerr << "Could not handle the lost connection of " << player->get_player_name() << ": " << err
+                  << std::endl;
+    }
+}
@@ -5,6 +5,8 @@
  functionality to retrieve game instances by id and adding players to games.
  If a new Player requests to join a game but no valid GameInstance is available, then this class
  will generate a new GameInstance and add it to the unordered_map of (active) game instances.
+ Games that wait too long for players are filled with bots, and a player whose connection is lost is played by a
+ bot for the rest of the game.
 */
 
 #ifndef TICHU_GAME_INSTANCE_MANAGER_H
@@ -14,6 +16,7 @@
 #include <shared_mutex>
 #include <unordered_map>
 #include <memory>
+#include <chrono>
 
 #include "game_instance.h"
 
@@ -58,6 +61,22 @@ public:
 
     static bool try_remove_player(player_ptr player, GameInstance &game_instance_ptr, std::string &err);
 
+    /**
+     * Starts a thread that fills every game whose first player waits longer than 'bot_timeout' with bots.
+    */
+    static void start_matchmaking(std::chrono::seconds bot_timeout);
+
+    /**
+     * Fills the games not started whose first player waits longer than 'timeout' with bots and starts them.
+    */
+    static void fill_waiting_games(std::chrono::steady_clock::duration timeout);
+
+    /**
+     * Called when the connection of a player is lost. A bot takes over the player in a started game,
+     * a player waiting for the game to start leaves it.
+    */
+    static void on_player_disconnected(const UUID &player_id);
+
 };
 
 
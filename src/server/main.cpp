@@ -1,7 +1,48 @@
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
 #include "server_network_manager.h"
+#include "game_instance_manager.h"
+#include "bot_pool.h"
 //#include "Server.h"
 
-int main() {
+static void print_usage() {
+    std::cerr << "usage: Tichu-server [--bot-timeout S] [--bot-threads N] [--bot-budget MS]" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    // a game waiting this long for players is filled with bots, 0 to never seat bots on waiting games
+    long long bot_timeout = 60;
+    IsmctsSearch::Settings settings = bot_pool::get_settings();
+
+    for (int i = 1; i < argc; ++i) {
+        const bool has_value = i + 1 < argc;
+        try {
+            if (!std::strcmp(argv[i], "--bot-timeout") && has_value) {
+                bot_timeout = std::stoll(argv[++i]);
+            } else if (!std::strcmp(argv[i], "--bot-threads") && has_value) {
+                const int nof_threads = std::stoi(argv[++i]);
+                if (nof_threads <= 0) { throw std::invalid_argument("--bot-threads"); }
+                bot_pool::set_nof_threads(nof_threads);
+            } else if (!std::strcmp(argv[i], "--bot-budget") && has_value) {
+                // the bots search without an iteration limit, they need a time budget
+                settings.budget = std::chrono::milliseconds(std::stoll(argv[++i]));
+                if (settings.budget.count() <= 0) { throw std::invalid_argument("--bot-budget"); }
+            } else {
+                print_usage();
+                return 1;
+            }
+        } catch (std::logic_error &) {
+            // std::stoll and std::stoi throw std::invalid_argument or std::out_of_range
+            print_usage();
+            return 1;
+        }
+    }
+    bot_pool::set_settings(settings);
+    if (bot_timeout > 0) {
+        game_instance_manager::start_matchmaking(std::chrono::seconds(bot_timeout));
+    }
+
     // create server_network_manager, which listens endlessly for new connections
     server_network_manager server;
     //Server server(50505);
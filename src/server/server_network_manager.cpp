@@ -4,6 +4,7 @@
 #include <sstream>
 #include "server_network_manager.h"
 #include "request_handler.h"
+#include "game_instance_manager.h"
 
 const std::string default_server_host = "127.0.0.1";
 const unsigned int default_port = 50505;
@@ -78,7 +79,8 @@ void server_network_manager::read_message(sockpp::tcp_socket socket, const std::
 
             int size;
             try {
-                size = (int) std::stoul(msg_size_str, nullptr, 16); // 16 for hexadecimal
+                // the buffer is not null terminated, only its characters are parsed
+                size = (int) std::stoul(std::string(msg_size_str, sizeof(msg_size_str)), nullptr, 16); // 16 for hexadecimal
             } catch (std::exception &e) {
                 // maybe delimiter so we can try to recover, but since its tcp not sure if necessary
                 ERROR("while trying to parse message size from string: {}", msg_size_str);
@@ -109,6 +111,23 @@ void server_network_manager::read_message(sockpp::tcp_socket socket, const std::
 
     std::cout << "Closing connection to " << socket.peer_address() << std::endl;
     socket.shutdown();
+    on_connection_closed(socket.peer_address().to_string());
+}
+
+void server_network_manager::on_connection_closed(const std::string &address) {
+    std::vector<UUID> player_ids;
+    _rw_lock.lock_shared();
+    for (const auto &[player_id, player_address]: _player_id_to_address) {
+        if (player_address == address) {
+            player_ids.push_back(player_id);
+        }
+    }
+    _rw_lock.unlock_shared();
+
+    for (const UUID &player_id: player_ids) {
+        on_player_left(player_id);
+        game_instance_manager::on_player_disconnected(player_id);
+    }
 }
 
 
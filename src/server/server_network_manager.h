@@ -42,6 +42,9 @@ private:
 
     static void handle_incoming_message(const std::string &msg, const sockpp::tcp_socket::addr_t &peer_address);
 
+    // the players of the closed connection leave the network, their games go on without them
+    static void on_connection_closed(const std::string &address);
+
     static ssize_t send_message(const std::string &msg, const std::string &address);
 
 public:
@@ -0,0 +1,65 @@
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include "simulator.h"
+
+static void print_usage() {
+    std::cerr << "usage: Tichu-sim [--games N] [--threads N] [--seed N] [--seats POLICY,POLICY,POLICY,POLICY]\n"
+              << "policies:";
+    for (const std::string &name: SeatPolicy::get_names()) { std::cerr << " " << name; }
+    std::cerr << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    uint64_t nof_games = 1000;
+    int nof_threads = (int)std::max(std::thread::hardware_concurrency(), 1u);
+    uint64_t seed = 1;
+    std::string seats = "greedy,random,greedy,random";
+
+    for (int i = 1; i < argc; ++i) {
+        const bool has_value = i + 1 < argc;
+        if (!std::strcmp(argv[i], "--games") && has_value) {
+            nof_games = std::stoull(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--threads") && has_value) {
+            nof_threads = std::stoi(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--seed") && has_value) {
+            seed = std::stoull(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--seats") && has_value) {
+            seats = argv[++i];
+        } else {
+            print_usage();
+            return 1;
+        }
+    }
+
+    std::vector<std::unique_ptr<SeatPolicy>> owned;
+    std::array<const SeatPolicy *, GameSnapshot::nof_players> policies{};
+    std::stringstream names(seats);
+    std::string name;
+    for (int seat = 0; seat < GameSnapshot::nof_players; ++seat) {
+        if (!std::getline(names, name, ',') || !(owned.emplace_back(SeatPolicy::create(name)))) {
+            print_usage();
+            return 1;
+        }
+        policies[seat] = owned.back().get();
+    }
+
+    Simulator simulator(policies, seed);
+    const SimulationStats stats = simulator.run(nof_games, nof_threads);
+
+    std::printf("seats     %s (team A: seats 0 and 2)\n", seats.c_str());
+    std::printf("threads   %d\n", nof_threads);
+    std::printf("games     %llu (%llu rounds, %llu moves)\n", (unsigned long long)stats.games,
+                (unsigned long long)stats.rounds, (unsigned long long)stats.moves);
+    std::printf("wins      A %llu, B %llu\n", (unsigned long long)stats.wins_a, (unsigned long long)stats.wins_b);
+    if (stats.rounds) {
+        std::printf("points    A %.1f, B %.1f per round\n", (double)stats.points_a / (double)stats.rounds,
+                    (double)stats.points_b / (double)stats.rounds);
+    }
+    std::printf("time      %.3f s\n", stats.seconds);
+    std::printf("games/s   %.1f\n", (double)stats.games / stats.seconds);
+    std::printf("moves/s   %.0f\n", (double)stats.moves / stats.seconds);
+    return 0;
+}
@@ -0,0 +1,56 @@
+#include "seat_policy.h"
+
+#include "../common/game_state/game_state.h"
+#include "../common/game_state/greedy_strategy.h"
+
+std::unique_ptr<SeatPolicy> SeatPolicy::create(const std::string &name) {
+    if (name == "random") { return std::make_unique<RandomPolicy>(); }
+    if (name == "greedy") { return std::make_unique<GreedyPolicy>(); }
+    if (name == "ismcts") { return std::make_unique<IsmctsPolicy>(200); }
+    return nullptr;
+}
+
+std::vector<std::string> SeatPolicy::get_names() {
+    return {"random", "greedy", "ismcts"};
+}
+
+//
+//   [RANDOM]
+//
+Move RandomPolicy::choose(const GameEngine &engine, int seat, const std::vector<Move> &moves,
+                          Xoshiro256 &rng) const {
+    return moves[rng.below((uint32_t)moves.size())];
+}
+
+const Move *RandomPolicy::choose_bomb(const GameEngine &engine, int seat, const std::vector<Move> &bombs,
+                                      Xoshiro256 &rng) const {
+    if (rng.below(8) != 0) { return nullptr; }
+    return &bombs[rng.below((uint32_t)bombs.size())];
+}
+
+//
+//   [GREEDY]
+//
+bool GreedyPolicy::call_tichu(const CardSet &cards, Xoshiro256 &rng) const {
+    return GreedyStrategy::call_tichu(cards);
+}
+
+Move GreedyPolicy::choose(const GameEngine &engine, int seat, const std::vector<Move> &moves,
+                          Xoshiro256 &rng) const {
+    return GreedyStrategy::choose(engine.get_state(), seat, moves);
+}
+
+//
+//   [ISMCTS]
+//
+Move IsmctsPolicy::choose(const GameEngine &engine, int seat, const std::vector<Move> &moves,
+                          Xoshiro256 &rng) const {
+    const GameSnapshot &state = engine.get_state();
+    if (state.phase == GamePhase::SWAPPING || moves.size() == 1) { return GreedyPolicy::choose(engine, seat, moves, rng); }
+
+    IsmctsSearch::Settings settings;
+    settings.budget = std::chrono::milliseconds(0);
+    settings.max_iterations = _iterations;
+    settings.seed = rng();
+    return IsmctsSearch(settings).search(state, seat, CardTracker(state)).move;
+}
@@ -0,0 +1,107 @@
+/*! \class SeatPolicy
+    \brief Decides the calls and moves of one seat in a simulated game.
+
+ The Simulator asks the policy of a seat for its Grand Tichu and Tichu calls and picks its moves from the legal
+ moves the GameEngine lists, including the swap and the gift of a Dragon trick. Policies hold no state of a game
+ and their methods are const, a single instance serves all seats and threads. Randomness comes from the generator
+ of the game, so a simulation replays from its seed.
+
+ New policies are added by deriving from SeatPolicy and registering a name in SeatPolicy::create.
+*/
+
+#ifndef TICHU_SEAT_POLICY_H
+#define TICHU_SEAT_POLICY_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "../common/game_state/game_engine.h"
+#include "../common/game_state/cards/card_set.h"
+#include "../common/game_state/ismcts.h"
+#include "../common/game_state/cards/xoshiro256.h"
+
+class SeatPolicy {
+
+public:
+    virtual ~SeatPolicy() = default;
+
+    [[nodiscard]] virtual const char *get_name() const = 0;
+
+    /**
+     * \brief Whether to call a Grand Tichu, seeing the first 8 cards.
+     */
+    virtual bool call_grand_tichu(const CardSet &first_cards, Xoshiro256 &rng) const { return false; }
+
+    /**
+     * \brief Whether to call a Tichu, seeing the 14 cards after the swap.
+     */
+    virtual bool call_tichu(const CardSet &cards, Xoshiro256 &rng) const { return false; }
+
+    /**
+     * \brief Chooses one of the moves of the seat whose move is expected, moves is never empty.
+     */
+    virtual Move choose(const GameEngine &engine, int seat, const std::vector<Move> &moves,
+                        Xoshiro256 &rng) const = 0;
+
+    /**
+     * \brief Chooses a bomb to play out of turn on the current trick, nullptr to let the game continue.
+     */
+    virtual const Move *choose_bomb(const GameEngine &engine, int seat, const std::vector<Move> &bombs,
+                                    Xoshiro256 &rng) const { return nullptr; }
+
+    /**
+     * \brief The policy registered under the name, nullptr if there is none.
+     */
+    static std::unique_ptr<SeatPolicy> create(const std::string &name);
+
+    static std::vector<std::string> get_names();
+};
+
+/*! \class RandomPolicy
+    \brief Plays uniformly random legal moves, bombs out of turn now and then and never calls.
+*/
+class RandomPolicy : public SeatPolicy {
+
+public:
+    [[nodiscard]] const char *get_name() const override { return "random"; }
+
+    Move choose(const GameEngine &engine, int seat, const std::vector<Move> &moves, Xoshiro256 &rng) const override;
+
+    const Move *choose_bomb(const GameEngine &engine, int seat, const std::vector<Move> &bombs,
+                            Xoshiro256 &rng) const override;
+};
+
+/*! \class GreedyPolicy
+    \brief Gets rid of its cards as cheaply as possible, with the calls and moves of GreedyStrategy.
+*/
+class GreedyPolicy : public SeatPolicy {
+
+public:
+    [[nodiscard]] const char *get_name() const override { return "greedy"; }
+
+    bool call_tichu(const CardSet &cards, Xoshiro256 &rng) const override;
+
+    Move choose(const GameEngine &engine, int seat, const std::vector<Move> &moves, Xoshiro256 &rng) const override;
+};
+
+/*! \class IsmctsPolicy
+    \brief Plays the tricks and gifts with an IsmctsSearch of the seat's information, calls and swaps like GreedyPolicy.
+
+ The search runs on the thread of the game with a fixed number of iterations, so simulations stay reproducible.
+ It starts from the public cards of the position only, the swap and the passes of the round are not tracked.
+*/
+class IsmctsPolicy : public GreedyPolicy {
+
+private:
+    uint64_t _iterations;
+
+public:
+    explicit IsmctsPolicy(uint64_t iterations) : _iterations(iterations) {}
+
+    [[nodiscard]] const char *get_name() const override { return "ismcts"; }
+
+    Move choose(const GameEngine &engine, int seat, const std::vector<Move> &moves, Xoshiro256 &rng) const override;
+};
+
+
+#endif //TICHU_SEAT_POLICY_H
@@ -0,0 +1,129 @@
+#include "simulator.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include "../common/game_state/game_state.h"
+#include "../common/game_state/player/hand.h"
+
+void SimulationStats::merge(const SimulationStats &other) {
+    games += other.games;
+    rounds += other.rounds;
+    moves += other.moves;
+    wins_a += other.wins_a;
+    wins_b += other.wins_b;
+    points_a += other.points_a;
+    points_b += other.points_b;
+}
+
+Simulator::Simulator(const std::array<const SeatPolicy *, GameSnapshot::nof_players> &policies, uint64_t seed)
+        : _policies(policies), _seed(seed) {}
+
+void Simulator::play_round(GameSnapshot &state, GameEngine &engine, std::vector<Move> &moves, Xoshiro256 &rng,
+                           SimulationStats &stats) const {
+    // a single Fisher-Yates pass deals all cards, seat i gets cards 14 * i to 14 * i + 13 of the deck
+    std::array<uint8_t, card_table::nof_cards> deck;
+    for (int id = 0; id < card_table::nof_cards; ++id) { deck[id] = (uint8_t)id; }
+    for (int i = card_table::nof_cards - 1; i > 0; --i) { std::swap(deck[i], deck[rng.below(i + 1)]); }
+
+    constexpr int hand_size = card_table::nof_cards / GameSnapshot::nof_players;
+    for (int seat = 0; seat < GameSnapshot::nof_players; ++seat) {
+        uint64_t cards = 0;
+        for (int i = 0; i < hand_size; ++i) {
+            cards |= 1ull << deck[seat * hand_size + i];
+            if (i == 7 && _policies[seat]->call_grand_tichu(CardSet(cards), rng)) {
+                state.set_tichu(seat, (int)Tichu::GRAND_TICHU);
+            }
+        }
+        state.hands[seat] = cards;
+    }
+
+    state.phase = GamePhase::SWAPPING;
+    engine = GameEngine(state);
+    while (engine.get_state().phase == GamePhase::SWAPPING) {
+        const int seat = engine.get_current_player();
+        engine.get_legal_moves(seat, moves);
+        engine.apply(_policies[seat]->choose(engine, seat, moves, rng));
+        ++stats.moves;
+    }
+
+    state = engine.get_state();
+    for (int seat = 0; seat < GameSnapshot::nof_players; ++seat) {
+        if (!state.get_tichu(seat) && _policies[seat]->call_tichu(state.get_hand(seat), rng)) {
+            state.set_tichu(seat, (int)Tichu::TICHU);
+        }
+    }
+
+    engine = GameEngine(state);
+    while (!(engine.get_state().flags & GameSnapshot::round_finished)) {
+        const int seat = engine.get_current_player();
+        const GameSnapshot &current = engine.get_state();
+
+        // the other seats holding a bomb may play it on the trick first
+        const Move *bomb = nullptr;
+        if (current.phase == GamePhase::INROUND && current.top) {
+            for (int k = 1; k < GameSnapshot::nof_players && !bomb; ++k) {
+                const int other = (seat + k) % GameSnapshot::nof_players;
+                if (!hand(current.get_hand(other)).has_bomb()) { continue; }
+                engine.get_legal_moves(other, moves);
+                if (!moves.empty()) { bomb = _policies[other]->choose_bomb(engine, other, moves, rng); }
+            }
+        }
+        if (bomb) {
+            engine.apply(*bomb);
+        } else {
+            engine.get_legal_moves(seat, moves);
+            engine.apply(_policies[seat]->choose(engine, seat, moves, rng));
+        }
+        ++stats.moves;
+    }
+
+    const int16_t score_a = engine.get_state().score_a;
+    const int16_t score_b = engine.get_state().score_b;
+    stats.points_a += score_a - state.score_a;
+    stats.points_b += score_b - state.score_b;
+    ++stats.rounds;
+
+    // the next round starts from an empty table with the scores
+    state = GameSnapshot();
+    state.score_a = score_a;
+    state.score_b = score_b;
+}
+
+void Simulator::play_game(uint64_t index, GameEngine &engine, std::vector<Move> &moves,
+                          SimulationStats &stats) const {
+    Xoshiro256 rng = Xoshiro256::for_index(_seed, index);
+    GameSnapshot state;
+    for (int round = 0; round < max_rounds && state.score_a < 1000 && state.score_b < 1000; ++round) {
+        play_round(state, engine, moves, rng, stats);
+    }
+    ++stats.games;
+    if (state.score_a > state.score_b) { ++stats.wins_a; }
+    if (state.score_b > state.score_a) { ++stats.wins_b; }
+}
+
+SimulationStats Simulator::run(uint64_t nof_games, int nof_threads) const {
+    const auto start = std::chrono::steady_clock::now();
+    std::atomic<uint64_t> next_game{0};
+    std::mutex stats_mutex;
+    SimulationStats res;
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < std::max(nof_threads, 1); ++i) {
+        workers.emplace_back([&]() {
+            GameEngine engine;
+            std::vector<Move> moves;
+            SimulationStats stats;
+            for (uint64_t game = next_game++; game < nof_games; game = next_game++) {
+                play_game(game, engine, moves, stats);
+            }
+            std::lock_guard<std::mutex> lock(stats_mutex);
+            res.merge(stats);
+        });
+    }
+    for (std::thread &worker: workers) { worker.join(); }
+
+    res.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return res;
+}
@@ -0,0 +1,64 @@
+/*! \class Simulator
+    \brief Plays complete Tichu games without a server or clients.
+
+ Every game is played up to 1000 points: the deal with the Grand Tichu calls on the first 8 cards, the swap, the
+ Tichu calls, the tricks with bombs out of turn and the gifts of Dragon tricks, and the scoring of each round. The
+ rounds are played on a GameEngine, the calls and moves come from the SeatPolicy of each seat.
+
+ run spreads the games over worker threads, each with its own GameEngine and move buffer. Game i is seeded with
+ the seed of the simulator and i, so the results do not depend on the number of threads.
+*/
+
+#ifndef TICHU_SIMULATOR_H
+#define TICHU_SIMULATOR_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "seat_policy.h"
+
+/**
+ * \struct SimulationStats
+ * \brief Totals over the simulated games.
+ */
+struct SimulationStats {
+    uint64_t games = 0;
+    uint64_t rounds = 0;
+    uint64_t moves = 0;
+    uint64_t wins_a = 0;
+    uint64_t wins_b = 0;
+    int64_t points_a = 0;
+    int64_t points_b = 0;
+    double seconds = 0;
+
+    void merge(const SimulationStats &other);
+};
+
+class Simulator {
+
+private:
+    std::array<const SeatPolicy *, GameSnapshot::nof_players> _policies;
+    uint64_t _seed;
+
+    // rounds are cut off after this many, in case the policies never reach 1000 points
+    static constexpr int max_rounds = 200;
+
+    void play_round(GameSnapshot &state, GameEngine &engine, std::vector<Move> &moves, Xoshiro256 &rng,
+                    SimulationStats &stats) const;
+
+public:
+    Simulator(const std::array<const SeatPolicy *, GameSnapshot::nof_players> &policies, uint64_t seed);
+
+    /**
+     * \brief Plays game number index, engine and moves are reused buffers of the calling thread.
+     */
+    void play_game(uint64_t index, GameEngine &engine, std::vector<Move> &moves, SimulationStats &stats) const;
+
+    /**
+     * \brief Plays games 0 to nof_games - 1 on nof_threads threads and measures the time taken.
+     */
+    [[nodiscard]] SimulationStats run(uint64_t nof_games, int nof_threads) const;
+};
+
+
+#endif //TICHU_SIMULATOR_H
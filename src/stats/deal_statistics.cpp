@@ -0,0 +1,257 @@
+#include "deal_statistics.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+#include "../common/game_state/cards/draw_pile.h"
+#include "../common/game_state/cards/hand_partition.h"
+#include "../common/game_state/cards/move_generator.h"
+#include "../common/utils.h"
+
+namespace {
+    constexpr int nof_players = 4;
+    constexpr const char *special_names[HandCounts::nof_specials] = {"phoenix", "dragon", "dog", "mahjong"};
+
+    // writes one row, estimate is a share of total unless given
+    void write_row(std::ostream &out, const std::string &statistic, int cards, const std::string &value,
+                   std::optional<uint64_t> count, uint64_t total, double estimate, double std_error,
+                   std::optional<double> exact) {
+        out << statistic << ',' << cards << ',' << value << ',';
+        if (count) { out << *count; }
+        out << ',' << total << ',' << estimate << ',' << std_error << ',';
+        if (exact) { out << *exact; }
+        out << '\n';
+    }
+
+    // the standard error of the mean of a value per hand, from its sum and sum of squares per deal
+    double deal_std_error(uint64_t sum, uint64_t squares, uint64_t hands, uint64_t deals) {
+        if (!deals || !hands) { return 0; }
+        const double n = (double)deals;
+        const double mean = (double)sum / n;
+        const double variance = (double)squares / n - mean * mean;
+        return std::sqrt(std::max(variance, 0.0) / n) * n / (double)hands;
+    }
+
+    // a share of the deals
+    void write_share(std::ostream &out, const std::string &statistic, int cards, const std::string &value,
+                     uint64_t count, uint64_t total, std::optional<double> exact = {}) {
+        const double p = total ? (double)count / (double)total : 0;
+        const double std_error = total ? std::sqrt(p * (1 - p) / (double)total) : 0;
+        write_row(out, statistic, cards, value, count, total, p, std_error, exact);
+    }
+
+    // a share of the hands, squares holds the squares of the counts per deal
+    void write_hand_share(std::ostream &out, const std::string &statistic, int cards, const std::string &value,
+                          uint64_t count, uint64_t squares, uint64_t hands, uint64_t deals,
+                          std::optional<double> exact = {}) {
+        const double p = hands ? (double)count / (double)hands : 0;
+        write_row(out, statistic, cards, value, count, hands, p, deal_std_error(count, squares, hands, deals), exact);
+    }
+
+    void write_hand_counts(std::ostream &out, const HandCounts &counts, const HandCounts &squares, int cards,
+                           uint64_t deals) {
+        const uint64_t hands = counts.hands;
+        write_hand_share(out, "bomb", cards, "", counts.bombs, squares.bombs, hands, deals);
+        write_hand_share(out, "four_of_a_kind", cards, "", counts.four_of_a_kinds, squares.four_of_a_kinds, hands,
+                         deals);
+        write_hand_share(out, "straight_flush", cards, "", counts.straight_flushes, squares.straight_flushes, hands,
+                         deals);
+        write_share(out, "table_bomb", cards, "", counts.tables_with_bomb, deals);
+        for (int length = 0; length <= HandCounts::max_size; ++length) {
+            if (length == 0 || length >= 5) {
+                write_hand_share(out, "longest_street", cards, std::to_string(length), counts.longest_street[length],
+                                 squares.longest_street[length], hands, deals);
+            }
+        }
+
+        for (int size = 0; size <= HandCounts::max_size; ++size) {
+            if (counts.partition_size[size]) {
+                write_hand_share(out, "partition_size", cards, std::to_string(size), counts.partition_size[size],
+                                 squares.partition_size[size], hands, deals);
+            }
+        }
+        const double n = (double)hands;
+        write_row(out, "partition_size_mean", cards, "", {}, hands, n ? (double)counts.partition_sizes / n : 0,
+                  deal_std_error(counts.partition_sizes, squares.partition_sizes, hands, deals), {});
+
+        // a hand of h cards holds a given card with probability h / 56 and two given cards with h (h - 1) / (56 55)
+        const double holds_one = (double)cards / card_table::nof_cards;
+        const double holds_two = holds_one * (cards - 1) / (card_table::nof_cards - 1);
+        for (int a = 0; a < HandCounts::nof_specials; ++a) {
+            for (int b = a; b < HandCounts::nof_specials; ++b) {
+                const std::string value = a == b ? special_names[a]
+                                                 : std::string(special_names[a]) + '+' + special_names[b];
+                write_hand_share(out, "special_cards", cards, value, counts.specials[a][b], squares.specials[a][b],
+                                 hands, deals, a == b ? holds_one : holds_two);
+            }
+        }
+        write_row(out, "leads_mean", cards, "", {}, hands, n ? (double)counts.leads / n : 0, 0, {});
+    }
+}
+
+void HandCounts::merge(const HandCounts &other) {
+    hands += other.hands;
+    bombs += other.bombs;
+    four_of_a_kinds += other.four_of_a_kinds;
+    straight_flushes += other.straight_flushes;
+    tables_with_bomb += other.tables_with_bomb;
+    for (int i = 0; i <= max_size; ++i) {
+        longest_street[i] += other.longest_street[i];
+        partition_size[i] += other.partition_size[i];
+    }
+    partition_sizes += other.partition_sizes;
+    for (int a = 0; a < nof_specials; ++a) {
+        for (int b = 0; b < nof_specials; ++b) { specials[a][b] += other.specials[a][b]; }
+    }
+    leads += other.leads;
+}
+
+void HandCounts::add_squares(const HandCounts &deal) {
+    auto square = [](uint64_t count) { return count * count; };
+    hands += square(deal.hands);
+    bombs += square(deal.bombs);
+    four_of_a_kinds += square(deal.four_of_a_kinds);
+    straight_flushes += square(deal.straight_flushes);
+    tables_with_bomb += square(deal.tables_with_bomb);
+    for (int i = 0; i <= max_size; ++i) {
+        longest_street[i] += square(deal.longest_street[i]);
+        partition_size[i] += square(deal.partition_size[i]);
+    }
+    partition_sizes += square(deal.partition_sizes);
+    for (int a = 0; a < nof_specials; ++a) {
+        for (int b = 0; b < nof_specials; ++b) { specials[a][b] += square(deal.specials[a][b]); }
+    }
+    leads += square(deal.leads);
+}
+
+void DealCounts::merge(const DealCounts &other) {
+    deals += other.deals;
+    first_eight.merge(other.first_eight);
+    full.merge(other.full);
+    first_eight_squares.merge(other.first_eight_squares);
+    full_squares.merge(other.full_squares);
+    for (int id = 0; id < card_table::nof_cards; ++id) {
+        for (int seat = 0; seat < nof_players; ++seat) { card_seat[id][seat] += other.card_seat[id][seat]; }
+    }
+}
+
+void DealCounts::write_csv(std::ostream &out) const {
+    out << "statistic,cards,value,count,total,estimate,std_error,exact\n";
+    write_hand_counts(out, first_eight, first_eight_squares, 8, deals);
+    write_hand_counts(out, full, full_squares, HandCounts::max_size, deals);
+
+    // every card goes to every seat with probability 1/4, the chi-square statistic of the counts has 56 * 3 degrees
+    // of freedom and their number as expected value
+    const double expected = (double)deals / nof_players;
+    double chi_square = 0;
+    for (int id = 0; id < card_table::nof_cards; ++id) {
+        for (int seat = 0; seat < nof_players; ++seat) {
+            const double diff = (double)card_seat[id][seat] - expected;
+            chi_square += expected > 0 ? diff * diff / expected : 0;
+        }
+    }
+    const int degrees = card_table::nof_cards * (nof_players - 1);
+    write_row(out, "card_seat_chi_square", HandCounts::max_size, "", {}, deals, chi_square,
+              std::sqrt(2.0 * degrees), degrees);
+}
+
+DealStatistics::DealStatistics(const Settings &settings) : _settings(settings) {
+    if (settings.block_size == 0) { throw TichuException("DealStatistics needs blocks of at least one deal"); }
+}
+
+void DealStatistics::count_hand(const CardSet &hand, HandCounts &counts) {
+    ++counts.hands;
+
+    bool has_four = false;
+    bool has_flush = false;
+    int longest = 0;
+    const std::vector<CardCombination> leads = MoveGenerator::get_legal_moves(hand, {});
+    for (const CardCombination &combi: leads) {
+        const int type = combi.get_combination_type();
+        const int length = (int)combi.get_cards().size();
+        if (type == BOMB) {
+            has_four |= length == 4;
+            has_flush |= length >= 5;
+        }
+        // a straight flush can be led as a street as well
+        if (type == STRASS || (type == BOMB && length >= 5)) { longest = std::max(longest, length); }
+    }
+    counts.leads += leads.size();
+    counts.bombs += has_four || has_flush;
+    counts.four_of_a_kinds += has_four;
+    counts.straight_flushes += has_flush;
+    ++counts.longest_street[longest];
+    const int partition_size = HandPartition::solve(hand).size();
+    ++counts.partition_size[partition_size];
+    counts.partition_sizes += partition_size;
+
+    // the special cards have the ids 0 to 3
+    for (int a = 0; a < HandCounts::nof_specials; ++a) {
+        if (!hand.contains(Card::from_id(a))) { continue; }
+        for (int b = a; b < HandCounts::nof_specials; ++b) {
+            counts.specials[a][b] += hand.contains(Card::from_id(b));
+        }
+    }
+}
+
+void DealStatistics::count_deals(uint64_t first, uint64_t last, DealCounts &counts) const {
+    std::vector<player_ptr> players;
+    for (int seat = 0; seat < nof_players; ++seat) {
+        players.push_back(std::make_shared<Player>(UUID::create(), "seat " + std::to_string(seat), Team::A));
+    }
+
+    std::string err;
+    DrawPile pile;
+    for (uint64_t deal = first; deal < last; ++deal) {
+        Xoshiro256 rng = Xoshiro256::for_index(_settings.seed, deal);
+        pile.setup_game(err);
+        for (const player_ptr &player: players) { player->restore(CardSet(), CardSet(), false, false, Tichu::NONE); }
+
+        // the deal of the game: 8 cards to every seat, the Grand Tichu calls, then 6 more
+        for (int nof_cards: {8, HandCounts::max_size - 8}) {
+            if (!pile.deal(players, nof_cards, rng, err)) { throw TichuException(err); }
+            HandCounts deal_counts;
+            for (const player_ptr &player: players) { count_hand(player->get_hand().get_card_set(), deal_counts); }
+            deal_counts.tables_with_bomb = deal_counts.bombs != 0;
+            (nof_cards == 8 ? counts.first_eight : counts.full).merge(deal_counts);
+            (nof_cards == 8 ? counts.first_eight_squares : counts.full_squares).add_squares(deal_counts);
+        }
+
+        for (int seat = 0; seat < nof_players; ++seat) {
+            for (uint64_t rest = players[seat]->get_hand().get_card_set().get_mask(); rest; rest &= rest - 1) {
+                ++counts.card_seat[std::countr_zero(rest)][seat];
+            }
+        }
+        ++counts.deals;
+    }
+}
+
+DealCounts DealStatistics::run() const {
+    const auto start = std::chrono::steady_clock::now();
+    const uint64_t nof_blocks = (_settings.nof_deals + _settings.block_size - 1) / _settings.block_size;
+    std::atomic<uint64_t> next_block{0};
+    std::mutex counts_mutex;
+    DealCounts res;
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < std::max(_settings.nof_threads, 1); ++i) {
+        workers.emplace_back([&]() {
+            DealCounts counts;
+            for (uint64_t block = next_block++; block < nof_blocks; block = next_block++) {
+                const uint64_t first = block * _settings.block_size;
+                count_deals(first, std::min(first + _settings.block_size, _settings.nof_deals), counts);
+            }
+            std::lock_guard<std::mutex> lock(counts_mutex);
+            res.merge(counts);
+        });
+    }
+    for (std::thread &worker: workers) { worker.join(); }
+
+    res.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return res;
+}
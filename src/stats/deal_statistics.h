@@ -0,0 +1,123 @@
+/*! \class DealStatistics
+    \brief Counts properties of the hands dealt by the game, over many random deals.
+
+ Every deal goes through the DrawPile of the game: 8 cards to each of the four seats, then 6 more. The hands are
+ looked at after the first 8 cards, where the Grand Tichu is called, and with all 14 cards. Per hand the counts
+ are: whether it holds a bomb (four of a kind or straight flush), the longest street it can lead, the size of its
+ HandPartition and which special cards it holds together. Per deal the counts are whether any seat holds a bomb
+ and which seat got each card, to check the shuffle.
+
+ The hands are classified with the MoveGenerator, all combinations a hand can lead are listed, so the statistics
+ double as a workload of the combination engine. Deal i is dealt from a generator seeded with the seed and i, so
+ the counts do not depend on the number of threads. The deals are handed out in blocks, a thread that is done with
+ its block takes the next one.
+*/
+
+#ifndef TICHU_DEAL_STATISTICS_H
+#define TICHU_DEAL_STATISTICS_H
+
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include "../common/game_state/cards/card_set.h"
+
+/**
+ * \struct HandCounts
+ * \brief Counts over the hands of one size, four per deal.
+ */
+struct HandCounts {
+    static constexpr int max_size = card_table::nof_cards / 4;
+    // the special cards in the order of their ids: Phoenix, Dragon, Dog, Mah Jong
+    static constexpr int nof_specials = 4;
+
+    uint64_t hands = 0;
+    uint64_t bombs = 0;
+    uint64_t four_of_a_kinds = 0;
+    uint64_t straight_flushes = 0;
+    // deals with a bomb in any hand
+    uint64_t tables_with_bomb = 0;
+    // index 0 for hands without a street
+    std::array<uint64_t, max_size + 1> longest_street{};
+    std::array<uint64_t, max_size + 1> partition_size{};
+    // the HandPartition sizes summed up
+    uint64_t partition_sizes = 0;
+    // hands holding both special cards, the diagonal counts the hands holding the card
+    std::array<std::array<uint64_t, nof_specials>, nof_specials> specials{};
+    // all leads summed up, the work done by the MoveGenerator
+    uint64_t leads = 0;
+
+    void merge(const HandCounts &other);
+
+    /**
+     * \brief Adds the square of every count of deal, the counts of the four hands of one deal.
+     */
+    void add_squares(const HandCounts &deal);
+};
+
+/**
+ * \struct DealCounts
+ * \brief The counts of DealStatistics::run.
+ */
+struct DealCounts {
+    uint64_t deals = 0;
+    // after the first 8 cards and after all 14
+    HandCounts first_eight;
+    HandCounts full;
+    // the squares of the counts of every deal summed up. The four hands of a deal hold different cards, so they are
+    // not independent and the standard errors of the hand counts are taken over the deals
+    HandCounts first_eight_squares;
+    HandCounts full_squares;
+    // how often card id went to seat
+    std::array<std::array<uint64_t, 4>, card_table::nof_cards> card_seat{};
+    double seconds = 0;
+
+    void merge(const DealCounts &other);
+
+    /**
+     * \brief Writes the statistics as csv: the estimate with its standard error and the exact value, if known. The
+     * standard errors take the deal as the sampling unit.
+     */
+    void write_csv(std::ostream &out) const;
+};
+
+class DealStatistics {
+
+public:
+    /**
+     * \struct Settings
+     * \brief The deals to count and the threads to count them on.
+     */
+    struct Settings {
+        uint64_t nof_deals = 100000;
+        int nof_threads = 1;
+        uint64_t seed = 1;
+        // deals taken by a thread at once
+        uint64_t block_size = 256;
+    };
+
+private:
+    Settings _settings;
+
+public:
+    explicit DealStatistics(const Settings &settings);
+
+    [[nodiscard]] const Settings &get_settings() const { return _settings; }
+
+    /**
+     * \brief Adds the hand to the counts of its hand size, tables_with_bomb is left to the caller.
+     */
+    static void count_hand(const CardSet &hand, HandCounts &counts);
+
+    /**
+     * \brief Deals and counts deals first to last - 1, used by the threads of run.
+     */
+    void count_deals(uint64_t first, uint64_t last, DealCounts &counts) const;
+
+    /**
+     * \brief Counts all deals on the threads and measures the time taken.
+     */
+    [[nodiscard]] DealCounts run() const;
+};
+
+
+#endif //TICHU_DEAL_STATISTICS_H
@@ -0,0 +1,75 @@
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "deal_statistics.h"
+
+static void print_usage() {
+    std::cerr << "usage: Tichu-deals [--deals N] [--threads N] [--seed N] [--out FILE] [--scaling]" << std::endl;
+}
+
+// the same deals on 1, 2, 4, ... threads up to the given number, as csv
+static void write_scaling(const DealStatistics::Settings &settings, std::ostream &out) {
+    std::vector<int> nof_threads;
+    for (int threads = 1; threads < settings.nof_threads; threads *= 2) { nof_threads.push_back(threads); }
+    nof_threads.push_back(settings.nof_threads);
+
+    out << "threads,deals,seconds,deals_per_second,speedup\n";
+    double base = 0;
+    for (int threads: nof_threads) {
+        DealStatistics::Settings run_settings = settings;
+        run_settings.nof_threads = threads;
+        const DealCounts counts = DealStatistics(run_settings).run();
+        const double rate = (double)counts.deals / counts.seconds;
+        if (base == 0) { base = rate; }
+        out << threads << ',' << counts.deals << ',' << counts.seconds << ',' << rate << ',' << rate / base << '\n';
+        out.flush();
+    }
+}
+
+int main(int argc, char *argv[]) {
+    DealStatistics::Settings settings;
+    settings.nof_threads = (int)std::max(std::thread::hardware_concurrency(), 1u);
+    std::string out_path;
+    bool scaling = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const bool has_value = i + 1 < argc;
+        if (!std::strcmp(argv[i], "--deals") && has_value) {
+            settings.nof_deals = std::stoull(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--threads") && has_value) {
+            settings.nof_threads = std::max(std::stoi(argv[++i]), 1);
+        } else if (!std::strcmp(argv[i], "--seed") && has_value) {
+            settings.seed = std::stoull(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--out") && has_value) {
+            out_path = argv[++i];
+        } else if (!std::strcmp(argv[i], "--scaling")) {
+            scaling = true;
+        } else {
+            print_usage();
+            return 1;
+        }
+    }
+
+    std::ofstream file;
+    if (!out_path.empty()) {
+        file.open(out_path);
+        if (!file) {
+            std::cerr << "could not open " << out_path << std::endl;
+            return 1;
+        }
+    }
+    std::ostream &out = out_path.empty() ? std::cout : file;
+
+    if (scaling) {
+        write_scaling(settings, out);
+        return 0;
+    }
+
+    const DealCounts counts = DealStatistics(settings).run();
+    counts.write_csv(out);
+    std::cerr << counts.deals << " deals on " << settings.nof_threads << " threads in " << counts.seconds << " s, "
+              << (double)counts.deals / counts.seconds << " deals/s" << std::endl;
+    return 0;
+}
@@ -0,0 +1,157 @@
+#include "gtest/gtest.h"
+#include "../src/common/bot_player.h"
+
+#include <deque>
+
+// the part of the server the bots talk to: requests are applied to a GameState and the states are sent back
+class LocalTable {
+
+private:
+    std::vector<BotPlayer> &_bots;
+    std::deque<std::pair<int, ServerMsg>> _outbox;
+
+    // the message goes through json like on the network, the state sent does not change with the game
+    void send(int bot, const GameState &state, const std::vector<Event> &events) {
+        json data;
+        to_json(data, ServerMsg(full_state_response{state, events}));
+        ServerMsg msg;
+        from_json(data, msg);
+        _outbox.emplace_back(bot, msg);
+    }
+
+    void broadcast(const std::vector<Event> &events) {
+        for (int i = 0; i < (int)_bots.size(); ++i) { send(i, game, events); }
+    }
+
+    [[nodiscard]] Player &player_of(const ClientMsg &msg) const {
+        return *game.get_players().at(game.get_player_index(msg.get_player_id()));
+    }
+
+    bool handle(int bot, const ClientMsg &msg, std::string &err) {
+        switch (msg.get_type()) {
+            case ClientMsgType::join_game: {
+                const auto data = msg.get_msg_data<join_game_req>();
+                auto player = std::make_shared<Player>(msg.get_player_id(), data.player_name, (Team)data.team);
+                if (!game.add_player(player, err)) { return false; }
+                broadcast({});
+                return true;
+            }
+            case ClientMsgType::call_grand_tichu:
+                if (!game.call_grand_tichu(player_of(msg), msg.get_msg_data<grand_tichu_req>().grand_tichu_call, err)) {
+                    return false;
+                }
+                broadcast({});
+                return true;
+            case ClientMsgType::call_small_tichu:
+                if (!game.call_small_tichu(player_of(msg), msg.get_msg_data<small_tichu_req>().small_tichu_call, err)) {
+                    return false;
+                }
+                broadcast({Event{EventType::SMALL_TICHU, msg.get_player_id(), {}, {}, {}}});
+                return true;
+            case ClientMsgType::swap: {
+                std::vector<std::vector<Event>> events(4);
+                if (!game.swap_cards(player_of(msg), msg.get_msg_data<swap_req>().cards, events, err)) { return false; }
+                for (int i = 0; i < 4; ++i) {
+                    const int index = game.get_player_index(_bots[i].get_id());
+                    if (!events.at(index).empty()) { send(i, game, events.at(index)); }
+                }
+                return true;
+            }
+            case ClientMsgType::play_combi: {
+                const auto data = msg.get_msg_data<play_combi_req>();
+                std::vector<Event> events;
+                if (!game.play_combi(player_of(msg), data.played_combi, events, err, data.wish)) { return false; }
+                ++nof_plays;
+                broadcast(events);
+                return true;
+            }
+            case ClientMsgType::dragon:
+                if (!game.dragon_selection(player_of(msg), msg.get_msg_data<dragon_req>().selected_player, err)) {
+                    return false;
+                }
+                broadcast({Event{EventType::SELECTION_END, msg.get_msg_data<dragon_req>().selected_player, {}, {}, {}}});
+                return true;
+            default:
+                err = "unexpected request";
+                return false;
+        }
+    }
+
+public:
+    GameState game;
+    int nof_rejected = 0;
+    int nof_plays = 0;
+
+    explicit LocalTable(std::vector<BotPlayer> &bots) : _bots(bots) {}
+
+    void request(int bot, const ClientMsg &msg) {
+        std::string err;
+        if (!handle(bot, msg, err)) {
+            ++nof_rejected;
+            _outbox.emplace_back(bot, ServerMsg(server_message{MessageType::Info, err}));
+        }
+    }
+
+    void start() {
+        std::string err;
+        ASSERT_TRUE(game.start_game(err)) << err;
+        broadcast({Event{EventType::GAME_START, {}, {}, {}, {}}});
+    }
+
+    // delivers the next message to its bot and applies the answer, false if no message is left
+    bool step() {
+        if (_outbox.empty()) { return false; }
+        auto [bot, msg] = _outbox.front();
+        _outbox.pop_front();
+        if (std::optional<ClientMsg> answer = _bots.at(bot).process(msg)) { request(bot, *answer); }
+        return true;
+    }
+};
+
+static IsmctsSearch::Settings quick_settings() {
+    IsmctsSearch::Settings settings;
+    settings.budget = std::chrono::milliseconds(0);
+    settings.max_iterations = 40;
+    return settings;
+}
+
+TEST(BotPlayerTest, PlaysRoundsThroughMessages) {
+    std::vector<BotPlayer> bots;
+    for (int i = 0; i < 4; ++i) { bots.emplace_back("bot " + std::to_string(i), 0, quick_settings()); }
+    LocalTable table(bots);
+    for (int i = 0; i < 4; ++i) { table.request(i, bots[i].join()); }
+    while (table.step()) {}
+    ASSERT_TRUE(table.game.is_full());
+
+    table.game.set_seed(11);
+    table.start();
+    // a round is over once its score is added, the second round starts from the state the first one left
+    int nof_rounds = 0;
+    int total = 0;
+    for (int steps = 0; steps < 40000 && nof_rounds < 2 && table.step(); ++steps) {
+        const int score = table.game.get_score_team_A() + table.game.get_score_team_B();
+        nof_rounds += score != total;
+        total = score;
+    }
+    EXPECT_EQ(nof_rounds, 2);
+    EXPECT_EQ(table.nof_rejected, 0);
+    EXPECT_GT(table.nof_plays, 20);
+}
+
+TEST(BotPlayerTest, AnswersEachStateOnce) {
+    std::vector<BotPlayer> bots;
+    for (int i = 0; i < 4; ++i) { bots.emplace_back("bot " + std::to_string(i), 0, quick_settings()); }
+    LocalTable table(bots);
+    for (int i = 0; i < 4; ++i) { table.request(i, bots[i].join()); }
+    while (table.step()) {}
+    table.game.set_seed(3);
+    table.start();
+
+    const full_state_response state{table.game, {}};
+    EXPECT_TRUE(bots[0].process(state).has_value());
+    EXPECT_FALSE(bots[0].process(state).has_value());
+    // decide answers again, the request is the Grand Tichu call
+    const std::optional<ClientMsg> request = bots[0].decide(table.game);
+    ASSERT_TRUE(request.has_value());
+    EXPECT_EQ(request->get_type(), ClientMsgType::call_grand_tichu);
+}
@@ -0,0 +1,89 @@
+#include "gtest/gtest.h"
+#include "../src/common/game_state/cards/card_set.h"
+#include "../src/common/game_state/player/hand.h"
+#include "../src/common/game_state/cards/won_cards_pile.h"
+
+#include <random>
+
+TEST(CardSetTest, InsertRemoveContains) {
+    CardSet cards;
+    cards.insert(Card(KING, RED));
+    cards.insert(DRAGON);
+    cards.insert(Card(KING, RED));
+
+    EXPECT_EQ(cards.size(), 2);
+    EXPECT_TRUE(cards.contains(DRAGON));
+    EXPECT_FALSE(cards.contains(PHONIX));
+
+    cards.erase(DRAGON);
+    EXPECT_EQ(cards.size(), 1);
+    EXPECT_FALSE(cards.contains(DRAGON));
+    EXPECT_EQ(CardSet::full_deck().size(), 56);
+}
+
+TEST(CardSetTest, SortedIteration) {
+    std::vector<Card> cards = {DRAGON, Card(ACE, GREEN), PHONIX, Card(TWO, SCHWARZ), HUND, ONE, Card(TWO, GREEN)};
+    CardSet set(cards);
+
+    std::vector<Card> sorted = cards;
+    std::sort(sorted.begin(), sorted.end());
+
+    EXPECT_EQ(set.to_vector(), sorted);
+    for (int i = 0; i < set.size(); i++) {
+        EXPECT_EQ(set.nth(i), sorted.at(i));
+    }
+}
+
+TEST(CardSetTest, RankHistogramAndSuits) {
+    CardSet set(std::vector<Card>{Card(FIVE, RED), Card(FIVE, BLUE), Card(FIVE, GREEN), Card(SIX, RED), PHONIX});
+
+    auto histogram = set.rank_histogram();
+    EXPECT_EQ(histogram[FIVE], 3);
+    EXPECT_EQ(histogram[SIX], 1);
+    EXPECT_EQ(histogram[SEVEN], 0);
+    EXPECT_EQ(histogram[SPECIAL], 1);
+
+    EXPECT_EQ(set.suit_mask(RED).size(), 2);
+    EXPECT_EQ(set.suit_mask(GREEN).size(), 1);  // the Phoenix is not part of any suit
+    EXPECT_EQ(set.rank_mask(), (1 << (SPECIAL - 1)) | (1 << (FIVE - 1)) | (1 << (SIX - 1)));
+    EXPECT_EQ(set.rank_mask(3), 1 << (FIVE - 1));
+}
+
+TEST(CardSetTest, HandRemoveCards) {
+    hand h(std::vector<Card>{Card(TWO, RED), Card(THREE, RED), DRAGON});
+    std::string err;
+
+    EXPECT_FALSE(h.remove_cards({Card(TWO, RED), Card(FOUR, RED)}, err));
+    EXPECT_EQ(h.get_nof_cards(), 3);
+    EXPECT_TRUE(h.remove_cards({Card(TWO, RED), DRAGON}, err));
+    EXPECT_EQ(h.get_cards(), std::vector<Card>{Card(THREE, RED)});
+    EXPECT_FALSE(h.add_card(Card(THREE, RED), err));
+    EXPECT_EQ(h.count_occurances(Card(THREE, GREEN)), 1);
+}
+
+TEST(CardSetTest, Score) {
+    std::mt19937_64 rng(3);
+    for (int i = 0; i < 1000; ++i) {
+        CardSet cards(rng());
+        int expected = 0;
+        for (Card card: cards) { expected += card.get_value(); }
+        ASSERT_EQ(cards.score(), expected);
+    }
+
+    WonCardsPile pile;
+    pile.add_cards(std::vector<CardCombination>{CardCombination(DRAGON), CardCombination(Card(KING, RED)),
+                                                CardCombination({Card(FIVE, RED), Card(FIVE, BLUE)})});
+    EXPECT_EQ(pile.get_nof_cards(), 4);
+    EXPECT_EQ(pile.get_score(), 45);
+    pile.add_cards(CardCombination(PHONIX));
+    EXPECT_EQ(pile.get_score(), 20);
+
+    hand h;
+    std::string err;
+    h.add_cards({Card(TEN, GREEN), Card(TWO, GREEN)}, err);
+    EXPECT_TRUE(err.empty());
+    h.add_cards({Card(TEN, GREEN), Card(KING, GREEN)}, err);
+    EXPECT_FALSE(err.empty());
+    EXPECT_EQ(h.get_nof_cards(), 3);
+    EXPECT_EQ(h.get_score(), 20);
+}
@@ -0,0 +1,92 @@
+#include "gtest/gtest.h"
+#include "../src/common/game_state/card_tracker.h"
+#include "../src/common/game_state/game_state.h"
+#include "../src/common/game_state/cards/move_generator.h"
+#include "test_tables.h"
+
+#include <random>
+
+static uint64_t other_hands(const GameSnapshot &state, int observer) {
+    uint64_t res = 0;
+    for (int seat = 0; seat < 4; ++seat) {
+        if (seat != observer) { res |= state.hands[seat]; }
+    }
+    return res;
+}
+
+TEST(CardTrackerTest, FollowsEngineMoves) {
+    std::mt19937 rng(9);
+    int nof_excluded = 0;
+    for (int round = 0; round < 40; ++round) {
+        GameState game;
+        deal_table(game, round + 1);
+        GameEngine engine(game.to_snapshot());
+        CardTracker tracker(engine.get_state());
+
+        std::vector<Move> moves;
+        while (!(engine.get_state().flags & GameSnapshot::round_finished)) {
+            const GameSnapshot before = engine.get_state();
+            engine.get_legal_moves(engine.get_current_player(), moves);
+            const Move move = moves.at(rng() % moves.size());
+            tracker.apply(before, move);
+            engine.apply(move);
+
+            const GameSnapshot &state = engine.get_state();
+            if (state.phase == SWAPPING || (state.flags & GameSnapshot::round_finished)) { continue; }
+            for (int observer = 0; observer < 4; ++observer) {
+                EXPECT_EQ(tracker.get_hand(observer).get_mask(), state.hands[observer]);
+                EXPECT_EQ(tracker.get_out(observer).get_mask(), other_hands(state, observer));
+                for (int seat = 0; seat < 4; ++seat) {
+                    // the hidden hands are never ruled out, the cards passed in the swap are known
+                    EXPECT_TRUE(tracker.get_candidates(observer, seat).contains(state.get_hand(seat)));
+                    EXPECT_TRUE(state.get_hand(seat).contains(tracker.get_known(observer, seat)));
+                }
+            }
+            for (int seat = 0; seat < 4; ++seat) { nof_excluded += !tracker.get_excluded(seat).empty(); }
+        }
+    }
+    // some passes and leads under a wish did happen
+    EXPECT_GT(nof_excluded, 0);
+}
+
+TEST(CardTrackerTest, FollowsEventsOfAClient) {
+    std::mt19937 rng(4);
+    for (int round = 0; round < 20; ++round) {
+        GameState game;
+        std::vector<player_ptr> players = deal_table(game, round + 100);
+        CardTracker tracker;
+        std::string err;
+
+        // the events of the swap are sent to each seat, the tracker follows seat 0
+        std::vector<std::vector<Event>> swap_events(4);
+        for (const player_ptr &player: players) {
+            std::vector<Card> cards = player->get_hand().get_cards();
+            std::shuffle(cards.begin(), cards.end(), rng);
+            ASSERT_TRUE(game.swap_cards(*player, {cards.begin(), cards.begin() + 3}, swap_events, err)) << err;
+        }
+        for (const Event &event: swap_events.at(0)) { tracker.apply(0, event, game); }
+        EXPECT_EQ(tracker.get_known(0, 1).size(), 1);
+
+        for (int turn = 0; turn < 200 && game.get_game_phase() != PREROUND; ++turn) {
+            std::vector<Event> events;
+            if (game.get_game_phase() == SELECTING) {
+                const int player = game.get_last_player_idx();
+                ASSERT_TRUE(game.dragon_selection(*players.at(player), players.at((player + 1) % 4)->get_id(), err));
+                continue;
+            }
+            const player_ptr &player = players.at(game.get_next_player_idx());
+            auto moves = MoveGenerator::get_legal_moves(player->get_hand(), game.get_active_pile().get_top_combi(),
+                                                        game.get_wish());
+            ASSERT_TRUE(game.play_combi(*player, moves.at(rng() % moves.size()), events, err)) << err;
+            for (const Event &event: events) { tracker.apply(0, event, game); }
+            if (game.get_game_phase() != INROUND) { continue; }
+
+            const GameSnapshot state = game.to_snapshot();
+            EXPECT_EQ(tracker.get_out(0).get_mask(), other_hands(state, 0)) << "turn " << turn;
+            for (int seat = 1; seat < 4; ++seat) {
+                EXPECT_TRUE(tracker.get_candidates(0, seat).contains(state.get_hand(seat)));
+            }
+            EXPECT_EQ(tracker.count_out(0, ACE), CardSet(other_hands(state, 0)).count_rank(ACE));
+        }
+    }
+}
@@ -2,6 +2,17 @@
 #include "../src/common/messages.h"
 #include "../src/common/game_state/cards/card_combination.h"
 
+TEST(CombiTest, CardOrder){
+    EXPECT_LT(HUND, Card(TWO, GREEN));
+    EXPECT_LT(ONE, Card(TWO, GREEN));
+    EXPECT_LT(Card(TWO, SCHWARZ), Card(THREE, GREEN));
+    EXPECT_LT(Card(ACE, SCHWARZ), PHONIX);
+    EXPECT_LT(PHONIX, DRAGON);
+    EXPECT_EQ(Card(FIVE, RED).get_value(), 5);
+    EXPECT_EQ(PHONIX.get_value(), -25);
+    EXPECT_EQ(DRAGON.get_value(), 25);
+}
+
 TEST(CombiTest, Singles){
     std::vector<Card> single_two;
     single_two.push_back(Card(TWO, RED, 0));
@@ -118,6 +129,32 @@ TEST(CombiTest, Bombs){
     EXPECT_EQ(combi_bomb.get_combination_rank(), TWO);
 }
 
+TEST(CombiTest, Stairs){
+    CardCombination stairs({Card(THREE, RED), Card(FOUR, GREEN), Card(THREE, BLUE), Card(FOUR, SCHWARZ)});
+    CardCombination phoenix_stairs({Card(SEVEN, RED), PHONIX, Card(FIVE, BLUE), Card(SIX, SCHWARZ), Card(FIVE, RED), Card(SEVEN, GREEN)});
+    CardCombination gap_stairs({Card(THREE, RED), Card(THREE, BLUE), Card(FIVE, RED), Card(FIVE, GREEN)});
+
+    EXPECT_EQ(stairs.get_combination_type(), TREPPE);
+    EXPECT_EQ(stairs.get_combination_rank(), THREE);
+    EXPECT_EQ(phoenix_stairs.get_combination_type(), TREPPE);
+    EXPECT_EQ(phoenix_stairs.get_combination_rank(), FIVE);
+    EXPECT_EQ(gap_stairs.get_combination_type(), NONE);
+}
+
+TEST(CombiTest, SpecialStreets){
+    CardCombination majong_street({ONE, Card(TWO, RED), Card(THREE, RED), Card(FOUR, RED), Card(FIVE, RED)});
+    CardCombination phoenix_below_ace({Card(TEN, RED), Card(JACK, RED), Card(QUEEN, GREEN), Card(KING, RED), Card(ACE, RED), PHONIX});
+    CardCombination same_suit_gaps({Card(TWO, RED), Card(FOUR, RED), Card(SIX, RED), Card(EIGHT, RED), Card(TEN, RED)});
+    CardCombination dog_and_dragon({HUND, DRAGON});
+
+    EXPECT_EQ(majong_street.get_combination_type(), STRASS);
+    EXPECT_EQ(majong_street.get_combination_rank(), 1);
+    EXPECT_EQ(phoenix_below_ace.get_combination_type(), STRASS);
+    EXPECT_EQ(phoenix_below_ace.get_combination_rank(), NINE);
+    EXPECT_EQ(same_suit_gaps.get_combination_type(), NONE);
+    EXPECT_EQ(dog_and_dragon.get_combination_type(), NONE);
+}
+
 TEST(CombiTest, Passing){
     std::vector<Card> pass;
     CardCombination combi_pass(pass);
@@ -267,9 +304,12 @@ TEST(CombiTest, CanBePlayedOn) {
 
     // DRAGON & PHOENIX
     EXPECT_EQ(combi_phoenix.can_be_played_on(combi_single_two, err), true);
-    EXPECT_EQ(combi_phoenix.get_combination_rank(), 2);
+    EXPECT_EQ(combi_phoenix.played_on(combi_single_two).get_combination_rank(), 2);
     EXPECT_EQ(combi_phoenix.can_be_played_on(combi_single_king, err), true);
-    EXPECT_EQ(combi_phoenix.get_combination_rank(), 13);
+    EXPECT_EQ(combi_phoenix.played_on(combi_single_king).get_combination_rank(), 13);
+    EXPECT_EQ(combi_phoenix.get_combination_rank(), -1);
+    EXPECT_EQ(combi_single_king.can_be_played_on(combi_phoenix.played_on(combi_single_king), err), false);
+    EXPECT_EQ(CardCombination(Card(ACE, RED)).can_be_played_on(combi_phoenix.played_on(combi_single_king), err), true);
     EXPECT_EQ(combi_phoenix.can_be_played_on(combi_dragon, err), false);
     
     // DOUBLE
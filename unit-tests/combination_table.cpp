@@ -0,0 +1,135 @@
+#include "gtest/gtest.h"
+#include "../src/common/game_state/cards/combination_table.h"
+#include "../src/common/game_state/cards/move_generator.h"
+
+#include <array>
+#include <random>
+
+// Every set of cards is equivalent to one with the same signature (number of cards per rank, special cards and
+// whether it is of a single suit), so enumerating the signatures of up to 14 cards covers every input.
+class SignatureEnumerator {
+private:
+    std::vector<Card> _cards;
+    int _max_count = 0;
+    int _checked = 0;
+    int _failures = 0;
+
+    void check(const std::vector<Card> &cards) {
+        ++_checked;
+        auto [type, rank] = CardCombination::classify_cards(cards);
+        Classification res = CombinationTable::classify(CardSet(cards));
+        if (res.type != type || (type != NONE && res.rank != rank) || res.length != cards.size()) {
+            if (++_failures <= 10) {
+                std::string desc;
+                for (Card card: cards) { desc += std::to_string(card.get_id()) + " "; }
+                ADD_FAILURE() << "cards " << desc << "expected " << type << "/" << rank << " got " << (int)res.type
+                              << "/" << (int)res.rank;
+            }
+        }
+    }
+
+    void leaf(bool has_specials) {
+        check(_cards);
+        // the same ranks with all cards of one suit
+        if (!has_specials && _max_count == 1 && _cards.size() >= 5) {
+            std::vector<Card> same_suit;
+            for (Card card: _cards) { same_suit.emplace_back(card.get_rank(), GREEN); }
+            check(same_suit);
+        }
+    }
+
+    void enumerate(int rank, int remaining, bool has_specials) {
+        if (rank > ACE || remaining == 0) {
+            leaf(has_specials);
+            return;
+        }
+        enumerate(rank + 1, remaining, has_specials);
+        const int max_count = _max_count;
+        for (int count = 1; count <= std::min(remaining, (int)card_table::nof_suits); ++count) {
+            // rotate the suits with the rank, so consecutive single cards are of different suits
+            _cards.emplace_back(rank, (rank + count) % card_table::nof_suits + 1);
+            _max_count = std::max(max_count, count);
+            enumerate(rank + 1, remaining - count, has_specials);
+        }
+        _cards.resize(_cards.size() - std::min(remaining, (int)card_table::nof_suits));
+        _max_count = max_count;
+    }
+
+public:
+    int run(const std::vector<Card> &specials, int max_size) {
+        _cards = specials;
+        enumerate(TWO, max_size - (int)specials.size(), !specials.empty());
+        return _checked;
+    }
+
+    [[nodiscard]] int get_failures() const { return _failures; }
+};
+
+TEST(CombinationTableTest, MatchesClassifier) {
+    const std::array<Card, 4> specials = {PHONIX, DRAGON, HUND, ONE};
+    SignatureEnumerator enumerator;
+    int checked = 0;
+    for (int subset = 0; subset < 16; ++subset) {
+        std::vector<Card> cards;
+        for (int i = 0; i < 4; ++i) {
+            if (subset & (1 << i)) { cards.push_back(specials[i]); }
+        }
+        // with the Dog or the Dragon no multi card combination is possible, a few regular cards are enough
+        bool only_alone = cards.size() > 0 && (subset & 0b0110);
+        checked = enumerator.run(cards, only_alone ? (int)cards.size() + 3 : 14);
+    }
+    EXPECT_EQ(enumerator.get_failures(), 0);
+    EXPECT_GT(checked, 10000000);
+}
+
+TEST(CombinationTableTest, Signature) {
+    CardSet street(std::vector<Card>{Card(TWO, RED), Card(THREE, RED), Card(FOUR, RED), Card(FIVE, RED),
+                                     Card(SIX, RED)});
+    EXPECT_TRUE(CombinationTable::signature(street.get_mask()) & CombinationTable::same_suit_flag);
+    EXPECT_EQ(CombinationTable::classify(street).type, BOMB);
+
+    street.erase(Card(SIX, RED));
+    street.insert(Card(SIX, BLUE));
+    EXPECT_FALSE(CombinationTable::signature(street.get_mask()) & CombinationTable::same_suit_flag);
+    EXPECT_EQ(CombinationTable::classify(street).type, STRASS);
+
+    CardSet fullhouse(std::vector<Card>{Card(TWO, RED), Card(TWO, BLUE), Card(NINE, RED), Card(NINE, GREEN), PHONIX});
+    Classification res = CombinationTable::classify(fullhouse);
+    EXPECT_EQ(res.type, FULLHOUSE);
+    EXPECT_EQ(res.rank, NINE);
+    EXPECT_EQ(res.length, 5);
+}
+
+TEST(CombinationTableTest, BatchBackendsAgree) {
+    std::mt19937_64 rng(11);
+    std::vector<uint64_t> masks;
+    // random sets of every size and all the combinations of random hands
+    for (int i = 0; i < 2000; ++i) {
+        uint64_t mask = rng() & CardSet::full_mask;
+        for (int drop = (int)(rng() % 6); drop > 0; --drop) { mask &= rng(); }
+        masks.push_back(mask);
+    }
+    for (int i = 0; i < 20; ++i) {
+        uint64_t hand = 0;
+        while (std::popcount(hand) < 14) { hand |= 1ull << (rng() % card_table::nof_cards); }
+        for (const CardCombination &combi: MoveGenerator::get_legal_moves(CardSet(hand), {})) {
+            masks.push_back(CardSet(combi.get_cards()).get_mask());
+        }
+    }
+
+    const size_t count = masks.size();
+    const int best = (int)CombinationTable::get_backend();
+    for (int backend = 0; backend <= best; ++backend) {
+        std::vector<uint8_t> types(count);
+        std::vector<int8_t> ranks(count);
+        std::vector<uint8_t> lengths(count);
+        CombinationTable::classify_batch((CombinationTable::Backend)backend, masks.data(), count, types.data(),
+                                         ranks.data(), lengths.data());
+        for (size_t i = 0; i < count; ++i) {
+            Classification expected = CombinationTable::classify(CardSet(masks[i]));
+            ASSERT_EQ(types[i], expected.type) << "backend " << backend << " mask " << masks[i];
+            ASSERT_EQ(ranks[i], expected.rank) << "backend " << backend << " mask " << masks[i];
+            ASSERT_EQ(lengths[i], expected.length) << "backend " << backend << " mask " << masks[i];
+        }
+    }
+}
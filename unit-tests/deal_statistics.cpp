@@ -0,0 +1,97 @@
+#include "gtest/gtest.h"
+#include "../src/stats/deal_statistics.h"
+
+#include <sstream>
+
+// the fields of the csv row starting with prefix
+static std::vector<std::string> csv_row(const std::string &csv, const std::string &prefix) {
+    std::istringstream lines(csv);
+    std::string line;
+    while (std::getline(lines, line)) {
+        if (line.rfind(prefix, 0) != 0) { continue; }
+        std::vector<std::string> fields;
+        std::istringstream row(line);
+        std::string field;
+        while (std::getline(row, field, ',')) { fields.push_back(field); }
+        return fields;
+    }
+    ADD_FAILURE() << "no row " << prefix;
+    return {};
+}
+
+TEST(DealStatisticsTest, CountsBombs) {
+    HandCounts counts;
+    DealStatistics::count_hand(CardSet(std::vector<Card>{Card(SEVEN, GREEN), Card(SEVEN, RED), Card(SEVEN, BLUE),
+                                                         Card(SEVEN, SCHWARZ), Card(TWO, GREEN), Card(NINE, RED)}),
+                               counts);
+    EXPECT_EQ(counts.hands, 1);
+    EXPECT_EQ(counts.bombs, 1);
+    EXPECT_EQ(counts.four_of_a_kinds, 1);
+    EXPECT_EQ(counts.straight_flushes, 0);
+    EXPECT_EQ(counts.longest_street[0], 1);
+
+    // a straight flush is a bomb and the longest street of its hand
+    DealStatistics::count_hand(CardSet(std::vector<Card>{Card(THREE, GREEN), Card(FOUR, GREEN), Card(FIVE, GREEN),
+                                                         Card(SIX, GREEN), Card(SEVEN, GREEN), Card(NINE, RED),
+                                                         Card(KING, RED)}),
+                               counts);
+    EXPECT_EQ(counts.hands, 2);
+    EXPECT_EQ(counts.bombs, 2);
+    EXPECT_EQ(counts.four_of_a_kinds, 1);
+    EXPECT_EQ(counts.straight_flushes, 1);
+    EXPECT_EQ(counts.longest_street[5], 1);
+    EXPECT_EQ(counts.partition_sizes, counts.partition_size[1] + 2 * counts.partition_size[2]
+                                      + 3 * counts.partition_size[3]);
+}
+
+TEST(DealStatisticsTest, CountsSpecialCards) {
+    HandCounts counts;
+    DealStatistics::count_hand(CardSet(std::vector<Card>{PHONIX, DRAGON, Card(TWO, GREEN), Card(FIVE, RED),
+                                                         Card(NINE, BLUE), Card(JACK, SCHWARZ), Card(KING, GREEN),
+                                                         Card(ACE, RED)}),
+                               counts);
+    // Phoenix, Dragon, Dog, Mah Jong
+    const std::array<std::array<uint64_t, HandCounts::nof_specials>, HandCounts::nof_specials> expected = {{
+            {1, 1, 0, 0},
+            {0, 1, 0, 0},
+            {0, 0, 0, 0},
+            {0, 0, 0, 0},
+    }};
+    EXPECT_EQ(counts.specials, expected);
+    EXPECT_EQ(counts.bombs, 0);
+    EXPECT_EQ(counts.longest_street[0], 1);
+
+    HandCounts twice = counts;
+    twice.merge(counts);
+    EXPECT_EQ(twice.hands, 2);
+    EXPECT_EQ(twice.specials[0][1], 2);
+    EXPECT_EQ(twice.partition_sizes, 2 * counts.partition_sizes);
+}
+
+TEST(DealStatisticsTest, SameCsvOnAnyNumberOfThreads) {
+    DealStatistics::Settings settings;
+    settings.nof_deals = 60;
+    settings.block_size = 7;
+    settings.seed = 3;
+    std::ostringstream single;
+    DealStatistics(settings).run().write_csv(single);
+
+    settings.nof_threads = 3;
+    const DealCounts counts = DealStatistics(settings).run();
+    EXPECT_EQ(counts.deals, 60);
+    EXPECT_EQ(counts.full.hands, 240);
+    EXPECT_EQ(counts.full_squares.hands, 60 * 16);
+    std::ostringstream threaded;
+    counts.write_csv(threaded);
+    EXPECT_EQ(threaded.str(), single.str());
+
+    // every deal puts the Phoenix in exactly one of the four full hands, the share has no error over the deals
+    const std::vector<std::string> phoenix = csv_row(single.str(), "special_cards,14,phoenix,");
+    ASSERT_EQ(phoenix.size(), 8);
+    EXPECT_DOUBLE_EQ(std::stod(phoenix[5]), 0.25);
+    EXPECT_DOUBLE_EQ(std::stod(phoenix[6]), 0.0);
+    // in the first 8 cards it does not
+    const std::vector<std::string> first_eight = csv_row(single.str(), "special_cards,8,phoenix,");
+    ASSERT_EQ(first_eight.size(), 8);
+    EXPECT_GT(std::stod(first_eight[6]), 0.0);
+}
@@ -0,0 +1,120 @@
+#include "gtest/gtest.h"
+#include "../src/common/game_state/endgame_solver.h"
+#include "../src/common/game_state/game_state.h"
+#include "test_tables.h"
+
+#include <bit>
+#include <random>
+
+// a position of a dealt round played at random until at most max_cards are left in the hands, false if the round
+// ended before
+static bool random_endgame(uint64_t seed, int max_cards, GameSnapshot &res) {
+    std::string err;
+    GameState game;
+    start_table(game, seed);
+    for (int i = 0; i < 4; ++i) {
+        // a Grand Tichu in some rounds, so the calls are part of the value
+        const Tichu tichu = seed % 6 == (uint64_t)i ? Tichu::GRAND_TICHU : Tichu::NONE;
+        EXPECT_TRUE(game.call_grand_tichu(*game.get_players().at(i), tichu, err)) << err;
+    }
+
+    std::mt19937 rng(seed);
+    GameEngine engine(game.to_snapshot());
+    std::vector<Move> moves;
+    while (!(engine.get_state().flags & GameSnapshot::round_finished)) {
+        const GameSnapshot &state = engine.get_state();
+        int nof_cards = 0;
+        for (uint64_t hand: state.hands) { nof_cards += std::popcount(hand); }
+        if (state.phase != SWAPPING && nof_cards <= max_cards) {
+            res = state;
+            return true;
+        }
+        engine.get_legal_moves(engine.get_current_player(), moves);
+        engine.apply(moves.at(rng() % moves.size()));
+    }
+    return false;
+}
+
+// plain minimax without table or pruning
+static int minimax(GameEngine &engine, int root_difference) {
+    const GameSnapshot &state = engine.get_state();
+    if (state.flags & GameSnapshot::round_finished) { return state.score_a - state.score_b - root_difference; }
+    const bool maximizing = engine.get_current_player() % 2 == 0;
+    std::vector<Move> moves;
+    engine.get_legal_moves(engine.get_current_player(), moves);
+    int best = maximizing ? -100000 : 100000;
+    for (const Move &move: moves) {
+        const UndoRecord record = engine.apply(move);
+        const int value = minimax(engine, root_difference);
+        engine.undo(record);
+        best = maximizing ? std::max(best, value) : std::min(best, value);
+    }
+    return best;
+}
+
+TEST(EndgameSolverTest, MatchesMinimax) {
+    int nof_positions = 0;
+    for (uint64_t seed = 1; seed <= 200 && nof_positions < 40; ++seed) {
+        GameSnapshot state;
+        if (!random_endgame(seed, 8, state)) { continue; }
+        ++nof_positions;
+        GameEngine engine(state);
+        const int expected = minimax(engine, state.score_a - state.score_b);
+
+        for (int nof_threads: {1, 3}) {
+            EndgameSolver solver({nof_threads, std::chrono::seconds(60), 1 << 12});
+            const EndgameResult res = solver.solve(state);
+            ASSERT_TRUE(res.complete) << "seed " << seed;
+            EXPECT_EQ(res.value, expected) << "seed " << seed << ", " << nof_threads << " threads";
+            // the root move itself reaches the value, whatever order the threads finished in
+            const UndoRecord record = engine.apply(res.line.front());
+            EXPECT_EQ(minimax(engine, state.score_a - state.score_b), expected)
+                    << "seed " << seed << ", " << nof_threads << " threads";
+            engine.undo(record);
+
+            // the line plays the round to its end and scores the value
+            GameEngine line(state);
+            for (const Move &move: res.line) { line.apply(move); }
+            EXPECT_TRUE(line.get_state().flags & GameSnapshot::round_finished) << "seed " << seed;
+            EXPECT_EQ(line.get_state().score_a - line.get_state().score_b - (state.score_a - state.score_b),
+                      expected) << "seed " << seed;
+        }
+    }
+    EXPECT_GE(nof_positions, 20);
+}
+
+TEST(EndgameSolverTest, KeepsTableBetweenCalls) {
+    GameSnapshot state;
+    uint64_t seed = 1;
+    while (!random_endgame(seed, 10, state)) { ++seed; }
+    EndgameSolver solver({1, std::chrono::seconds(60), 1 << 16});
+    const EndgameResult first = solver.solve(state);
+    const EndgameResult second = solver.solve(state);
+    ASSERT_TRUE(first.complete);
+    ASSERT_TRUE(second.complete);
+    EXPECT_EQ(first.value, second.value);
+    EXPECT_LT(second.nodes, first.nodes);
+
+    solver.clear();
+    EXPECT_EQ(solver.solve(state).nodes, first.nodes);
+}
+
+TEST(EndgameSolverTest, StopsAtTheBudget) {
+    // a full round right after the swap can not be solved in a millisecond
+    GameSnapshot state;
+    ASSERT_TRUE(random_endgame(3, 56, state));
+    EndgameSolver solver({2, std::chrono::milliseconds(1), 1 << 12});
+    const EndgameResult res = solver.solve(state);
+    EXPECT_FALSE(res.complete);
+    EXPECT_LT(res.seconds, 1.0);
+}
+
+TEST(EndgameSolverTest, FinishedRound) {
+    GameEngine engine;
+    GameSnapshot state = engine.get_state();
+    state.flags |= GameSnapshot::round_finished;
+    const EndgameResult res = EndgameSolver({}).solve(state);
+    EXPECT_TRUE(res.complete);
+    EXPECT_EQ(res.value, 0);
+    EXPECT_TRUE(res.line.empty());
+}
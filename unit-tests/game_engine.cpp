@@ -0,0 +1,215 @@
+#include "gtest/gtest.h"
+#include "../src/common/game_state/game_engine.h"
+#include "../src/common/game_state/game_state.h"
+#include "../src/common/game_state/zobrist.h"
+#include "test_tables.h"
+
+#include <random>
+
+// the move of the current player, or now and then a bomb of another player
+static Move pick_move(const GameEngine &engine, std::mt19937 &rng) {
+    std::vector<Move> moves;
+    if (engine.get_state().phase == INROUND && rng() % 2) {
+        engine.get_legal_moves((int)(rng() % 4), moves);
+        std::erase_if(moves, [](const Move &move) { return (move.key >> 16) != BOMB; });
+    }
+    if (moves.empty()) { engine.get_legal_moves(engine.get_current_player(), moves); }
+    EXPECT_FALSE(moves.empty());
+    return moves.at(rng() % moves.size());
+}
+
+static bool apply_to_state(GameState &state, const Move &move) {
+    std::string err;
+    const player_ptr &player = state.get_players().at(move.player);
+    bool res = false;
+    if (move.type == MoveType::SWAP) {
+        std::vector<std::vector<Event>> events(4);
+        std::vector<Card> cards = {Card::from_id(move.swap[0]), Card::from_id(move.swap[1]),
+                                   Card::from_id(move.swap[2])};
+        res = state.swap_cards(*player, cards, events, err);
+    } else if (move.type == MoveType::GIFT) {
+        res = state.dragon_selection(*player, state.get_players().at(move.target)->get_id(), err);
+    } else {
+        std::vector<Event> events;
+        CardCombination combi = move.type == MoveType::PASS ? CardCombination()
+                                                            : CardCombination(CardSet(move.cards).to_vector());
+        std::optional<Card> wish;
+        if (move.wish) { wish = Card(move.wish, GREEN); }
+        res = state.play_combi(*player, combi, events, err, wish);
+    }
+    EXPECT_TRUE(res) << err;
+    return res;
+}
+
+TEST(GameEngineTest, MatchesGameState) {
+    std::mt19937 rng(5);
+    for (int game = 0; game < 20; ++game) {
+        GameState state;
+        deal_table(state);
+        GameEngine engine(state.to_snapshot());
+
+        // the GameState deals the next round when one ends, it is compared up to the last move of the round
+        for (int step = 0; step < 500; ++step) {
+            const Move move = pick_move(engine, rng);
+            engine.apply(move);
+            if (engine.get_state().flags & GameSnapshot::round_finished) { break; }
+            ASSERT_TRUE(apply_to_state(state, move));
+            ASSERT_EQ(engine.get_state(), state.to_snapshot()) << "game " << game << " step " << step;
+        }
+        EXPECT_TRUE(engine.get_state().flags & GameSnapshot::round_finished);
+    }
+}
+
+TEST(GameEngineTest, UndoRestoresEveryState) {
+    std::mt19937 rng(8);
+    for (int game = 0; game < 20; ++game) {
+        GameState state;
+        deal_table(state);
+        GameEngine engine(state.to_snapshot());
+
+        std::vector<GameSnapshot> states;
+        std::vector<UndoRecord> records;
+        while (engine.get_current_player() != GameSnapshot::no_player) {
+            states.push_back(engine.get_state());
+            records.push_back(engine.apply(pick_move(engine, rng)));
+            ASSERT_EQ(engine.get_state().hash, Zobrist::hash(engine.get_state()));
+        }
+        const GameSnapshot &end = engine.get_state();
+        EXPECT_EQ(end.phase, PREROUND);
+        // all card points are counted unless a team finished first and second
+        if (end.nof_finished == 3) { EXPECT_EQ(end.score_a + end.score_b, 100); }
+
+        while (!records.empty()) {
+            engine.undo(records.back());
+            records.pop_back();
+            ASSERT_EQ(engine.get_state(), states.back()) << "game " << game << " move " << records.size();
+            states.pop_back();
+        }
+    }
+}
+
+TEST(GameEngineTest, DoubleVictory) {
+    GameSnapshot snapshot;
+    snapshot.phase = INROUND;
+    snapshot.hands[0] = CardSet(Card(ACE, RED)).get_mask();
+    snapshot.hands[1] = CardSet(Card(TWO, RED)).get_mask();
+    snapshot.hands[3] = CardSet(Card(THREE, RED)).get_mask();
+    snapshot.won[1] = CardSet(Card(KING, RED)).get_mask();
+    snapshot.add_finisher(2);
+    snapshot.set_tichu(2, (int)Tichu::TICHU);
+    snapshot.set_tichu(1, (int)Tichu::TICHU);
+    GameEngine engine(snapshot);
+    snapshot = engine.get_state();
+
+    std::vector<Move> moves;
+    engine.get_legal_moves(0, moves);
+    ASSERT_EQ(moves.size(), 1);
+    UndoRecord record = engine.apply(moves.front());
+    EXPECT_EQ(engine.get_state().phase, PREROUND);
+    EXPECT_EQ(engine.get_state().score_a, 300);
+    EXPECT_EQ(engine.get_state().score_b, -100);
+    EXPECT_EQ(engine.get_state().next, 2);
+    EXPECT_EQ(engine.get_current_player(), GameSnapshot::no_player);
+
+    engine.undo(record);
+    EXPECT_EQ(engine.get_state(), snapshot);
+}
+
+TEST(GameEngineTest, DogBombAndDragon) {
+    GameSnapshot snapshot;
+    snapshot.phase = INROUND;
+    snapshot.hands[0] = CardSet(std::vector<Card>{HUND, DRAGON, Card(TWO, RED)}).get_mask();
+    snapshot.hands[1] = CardSet(std::vector<Card>{Card(FIVE, GREEN), Card(FIVE, RED), Card(FIVE, BLUE),
+                                                  Card(FIVE, SCHWARZ), Card(SIX, RED), Card(TWO, GREEN)}).get_mask();
+    snapshot.hands[2] = CardSet(std::vector<Card>{Card(SEVEN, RED), Card(EIGHT, RED)}).get_mask();
+    snapshot.hands[3] = CardSet(std::vector<Card>{Card(NINE, RED), Card(TEN, RED)}).get_mask();
+    GameEngine engine(snapshot);
+
+    // the Dog passes the turn to the partner
+    engine.apply(Move::play(0, CardCombination(HUND)));
+    EXPECT_EQ(engine.get_state().next, 2);
+
+    // a bomb out of turn, the player after the bomber continues
+    std::vector<Move> moves;
+    engine.get_legal_moves(1, moves);
+    ASSERT_EQ(moves.size(), 1);
+    engine.apply(moves.front());
+    EXPECT_EQ(engine.get_state().next, 2);
+    EXPECT_EQ(engine.get_state().last, 1);
+
+    for (int player: {2, 3, 0}) { engine.apply(Move::pass(player)); }
+    EXPECT_EQ(engine.get_state().won[1], CardSet(std::vector<Card>{HUND, Card(FIVE, GREEN), Card(FIVE, RED),
+                                                                   Card(FIVE, BLUE), Card(FIVE, SCHWARZ)}).get_mask());
+    EXPECT_EQ(engine.get_current_player(), 1);
+
+    // the Dragon trick is given away by its winner
+    engine.apply(Move::play(1, CardCombination(Card(SIX, RED))));
+    engine.apply(Move::pass(2));
+    engine.apply(Move::pass(3));
+    engine.apply(Move::play(0, CardCombination(DRAGON)));
+    for (int player: {1, 2, 3}) { engine.apply(Move::pass(player)); }
+    EXPECT_EQ(engine.get_state().phase, SELECTING);
+    EXPECT_EQ(engine.get_current_player(), 0);
+    engine.get_legal_moves(0, moves);
+    ASSERT_EQ(moves.size(), 2);
+    UndoRecord record = engine.apply(Move::gift(0, 3));
+    EXPECT_EQ(engine.get_state().phase, INROUND);
+    EXPECT_EQ(engine.get_state().won[3], CardSet(std::vector<Card>{DRAGON, Card(SIX, RED)}).get_mask());
+    EXPECT_EQ(engine.get_current_player(), 0);
+
+    engine.undo(record);
+    EXPECT_EQ(engine.get_state().phase, SELECTING);
+    EXPECT_EQ(engine.get_state().won[3], 0);
+}
+
+TEST(GameEngineTest, HashCoversThePosition) {
+    GameSnapshot snapshot;
+    snapshot.phase = INROUND;
+    snapshot.hands[0] = CardSet(std::vector<Card>{Card(TWO, RED), Card(THREE, RED)}).get_mask();
+    snapshot.hands[1] = CardSet(std::vector<Card>{Card(TWO, GREEN), Card(THREE, GREEN)}).get_mask();
+    const uint64_t hash = Zobrist::hash(snapshot);
+
+    // the same cards in other hands, a pass, the turn, the wish and a Tichu call all change the key
+    GameSnapshot other = snapshot;
+    std::swap(other.hands[0], other.hands[1]);
+    EXPECT_NE(Zobrist::hash(other), hash);
+    for (uint8_t GameSnapshot::*field: {&GameSnapshot::skipped, &GameSnapshot::next, &GameSnapshot::wish,
+                                        &GameSnapshot::tichu}) {
+        other = snapshot;
+        other.*field = 2;
+        EXPECT_NE(Zobrist::hash(other), hash);
+    }
+    // the scores are not part of the position
+    other = snapshot;
+    other.score_a = 100;
+    EXPECT_EQ(Zobrist::hash(other), hash);
+
+    // the swaps handed in in two orders reach the same position
+    snapshot.phase = SWAPPING;
+    snapshot.hands[0] |= CardSet(Card(FOUR, RED)).get_mask();
+    snapshot.hands[1] |= CardSet(Card(FOUR, GREEN)).get_mask();
+    const Move from_first = Move::swap_cards(0, Card(TWO, RED), Card(THREE, RED), Card(FOUR, RED));
+    const Move from_second = Move::swap_cards(1, Card(TWO, GREEN), Card(THREE, GREEN), Card(FOUR, GREEN));
+    GameEngine first(snapshot);
+    GameEngine second(snapshot);
+    first.apply(from_first);
+    first.apply(from_second);
+    second.apply(from_second);
+    second.apply(from_first);
+    EXPECT_EQ(first.get_state().hash, second.get_state().hash);
+    EXPECT_NE(first.get_state().hash, GameEngine(snapshot).get_state().hash);
+
+    // before everyone swapped, only the cards handed in tell the positions apart
+    GameEngine red(snapshot);
+    GameEngine reversed(snapshot);
+    red.apply(from_first);
+    reversed.apply(Move::swap_cards(0, Card(FOUR, RED), Card(THREE, RED), Card(TWO, RED)));
+    EXPECT_NE(red.get_state(), reversed.get_state());
+    EXPECT_NE(red.get_state().hash, reversed.get_state().hash);
+    EXPECT_EQ(red.get_state().hash, Zobrist::hash(red.get_state()));
+
+    // so does the player who started the round
+    other = snapshot;
+    other.start = 2;
+    EXPECT_NE(Zobrist::hash(other), Zobrist::hash(snapshot));
+}
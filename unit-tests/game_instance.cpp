@@ -0,0 +1,105 @@
+#include "gtest/gtest.h"
+#include "../src/server/game_instance.h"
+#include "../src/server/bot_pool.h"
+#include "../src/server/bot_seat.h"
+
+#include <thread>
+
+static void use_quick_bots() {
+    IsmctsSearch::Settings settings;
+    settings.budget = std::chrono::milliseconds(0);
+    settings.max_iterations = 20;
+    bot_pool::set_settings(settings);
+}
+
+// polls the game until a player went out of the round, the bots play on the threads of the bot_pool
+static bool wait_for_finisher(GameInstance &game) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+    while (std::chrono::steady_clock::now() < deadline) {
+        const GameState state = game.clone_game_state();
+        if (!state.get_round_finish_order().empty() || state.get_score_team_A() + state.get_score_team_B() != 0) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+}
+
+TEST(GameInstanceTest, BotsFillTableAndPlay) {
+    use_quick_bots();
+    auto game = std::make_shared<GameInstance>();
+    std::string err;
+    ASSERT_TRUE(game->fill_with_bots(err)) << err;
+    EXPECT_TRUE(game->is_started());
+    EXPECT_FALSE(game->get_waiting_since().has_value());
+    const GameState state = game->clone_game_state();
+    for (const player_ptr &player: state.get_players()) {
+        EXPECT_TRUE(game->is_bot(player->get_id()));
+    }
+    EXPECT_FALSE(game->fill_with_bots(err));
+    EXPECT_TRUE(wait_for_finisher(*game));
+}
+
+TEST(GameInstanceTest, BotReplacesDisconnectedPlayer) {
+    use_quick_bots();
+    auto game = std::make_shared<GameInstance>();
+    auto human = std::make_shared<Player>(UUID::create(), "human", Team::RANDOM);
+    std::string err;
+    // the human has no connection, the states sent to it are dropped
+    ASSERT_TRUE(game->try_add_player(human, err)) << err;
+    EXPECT_TRUE(game->get_waiting_since().has_value());
+    EXPECT_FALSE(game->replace_with_bot(human, err));
+
+    ASSERT_TRUE(game->fill_with_bots(err)) << err;
+    EXPECT_FALSE(game->is_bot(human->get_id()));
+    ASSERT_TRUE(game->replace_with_bot(human, err)) << err;
+    EXPECT_TRUE(game->is_bot(human->get_id()));
+    EXPECT_FALSE(game->replace_with_bot(human, err));
+    EXPECT_TRUE(wait_for_finisher(*game));
+}
+
+TEST(GameInstanceTest, BotSeatAnswersAfterAFailedState) {
+    use_quick_bots();
+    auto game = std::make_shared<GameInstance>();
+    auto human = std::make_shared<Player>(UUID::create(), "human", Team::RANDOM);
+    std::string err;
+    ASSERT_TRUE(game->try_add_player(human, err)) << err;
+    ASSERT_TRUE(game->fill_with_bots(err)) << err;
+    ASSERT_EQ(game->clone_game_state().get_game_phase(), PREROUND);
+
+    // a seat of its own plays the human, the first state it gets makes the bot throw
+    auto seat = std::make_shared<BotSeat>(human, game, bot_pool::get_settings());
+    json data;
+    to_json(data, game->clone_game_state());
+    json stranger;
+    to_json(stranger, Player("stranger"));
+    data["_round_finish_order"] = json::array({stranger});
+    GameState broken;
+    from_json(data, broken);
+    ASSERT_THROW((void)broken.to_snapshot(), TichuException);
+    seat->deliver({broken, {}});
+    seat->deliver({game->clone_game_state(), {}});
+
+    // the Grand Tichu call of the human ends the PREROUND, the other seats are bots
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+    while (game->clone_game_state().get_game_phase() == PREROUND && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_NE(game->clone_game_state().get_game_phase(), PREROUND);
+}
+
+TEST(GameInstanceTest, InvalidBotSettingsReleaseTheLock) {
+    IsmctsSearch::Settings settings;
+    settings.budget = std::chrono::milliseconds(0);
+    settings.max_iterations = 0;
+    bot_pool::set_settings(settings);
+    auto game = std::make_shared<GameInstance>();
+    std::string err;
+    EXPECT_THROW(game->fill_with_bots(err), TichuException);
+    EXPECT_TRUE(game->clone_game_state().get_players().empty());
+
+    // the game is not locked for good, its bots are seated with valid settings
+    use_quick_bots();
+    ASSERT_TRUE(game->fill_with_bots(err)) << err;
+    EXPECT_TRUE(game->is_started());
+}
@@ -0,0 +1,172 @@
+#include "gtest/gtest.h"
+#include "../src/common/game_state/game_state.h"
+#include "../src/common/game_state/cards/move_generator.h"
+#include "test_tables.h"
+
+#include <cstring>
+
+// the first three cards of each hand are passed on
+static bool swap_first_cards(GameState &state, const player_ptr &player) {
+    std::string err;
+    std::vector<std::vector<Event>> events(4);
+    auto cards = player->get_hand().get_cards();
+    return state.swap_cards(*player, {cards.begin(), cards.begin() + 3}, events, err);
+}
+
+TEST(GameStateTest, TablesCollectCallsIndependently) {
+    GameState first;
+    GameState second;
+    auto first_players = start_table(first);
+    auto second_players = start_table(second);
+    std::string err;
+
+    // interleaved Grand Tichu calls on two tables
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(first.call_grand_tichu(*first_players.at(i), Tichu::NONE, err)) << err;
+        if (i < 3) { EXPECT_TRUE(second.call_grand_tichu(*second_players.at(i), Tichu::NONE, err)) << err; }
+    }
+    EXPECT_EQ(first.get_game_phase(), SWAPPING);
+    EXPECT_EQ(second.get_game_phase(), PREROUND);
+
+    // answering twice does not count twice
+    EXPECT_FALSE(second.call_grand_tichu(*second_players.at(0), Tichu::NONE, err));
+    EXPECT_EQ(second.get_game_phase(), PREROUND);
+    EXPECT_TRUE(second.call_grand_tichu(*second_players.at(3), Tichu::NONE, err)) << err;
+    EXPECT_EQ(second.get_game_phase(), SWAPPING);
+
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_TRUE(swap_first_cards(first, first_players.at(i)));
+        EXPECT_TRUE(swap_first_cards(second, second_players.at(i)));
+    }
+    EXPECT_FALSE(swap_first_cards(first, first_players.at(0)));
+    EXPECT_EQ(first.get_game_phase(), SWAPPING);
+
+    // the collected swaps survive the serialization
+    json data;
+    to_json(data, first);
+    GameState received;
+    from_json(data, received);
+    EXPECT_EQ(data["_responded_players"], 0b0111);
+    auto received_players = received.get_players();
+    ASSERT_EQ(received_players.size(), 4);
+    EXPECT_EQ(received.get_game_phase(), SWAPPING);
+    EXPECT_FALSE(swap_first_cards(received, received_players.at(0)));
+    EXPECT_EQ(received.get_game_phase(), SWAPPING);
+    EXPECT_TRUE(swap_first_cards(received, received_players.at(3)));
+    EXPECT_EQ(received.get_game_phase(), INROUND);
+    for (const player_ptr &player: received_players) { EXPECT_EQ(player->get_nof_cards(), 14); }
+
+    EXPECT_TRUE(swap_first_cards(first, first_players.at(3)));
+    EXPECT_EQ(first.get_game_phase(), INROUND);
+    EXPECT_EQ(second.get_game_phase(), SWAPPING);
+    for (const player_ptr &player: first_players) { EXPECT_EQ(player->get_nof_cards(), 14); }
+}
+
+TEST(GameStateTest, SnapshotRoundTrip) {
+    GameState game;
+    auto players = start_table(game);
+    std::string err;
+    game.call_grand_tichu(*players.at(0), Tichu::GRAND_TICHU, err);
+    for (int i = 1; i < 4; ++i) { game.call_grand_tichu(*players.at(i), Tichu::NONE, err); }
+    for (int i = 0; i < 4; ++i) { swap_first_cards(game, players.at(i)); }
+    ASSERT_EQ(game.get_game_phase(), INROUND);
+
+    // a few plays, so the trick and the hands are not trivial
+    for (int turn = 0; turn < 3; ++turn) {
+        const player_ptr &player = players.at(game.get_next_player_idx());
+        auto moves = MoveGenerator::get_legal_moves(player->get_hand(), game.get_active_pile().get_top_combi());
+        std::vector<Event> events;
+        ASSERT_TRUE(game.play_combi(*player, moves.front(), events, err)) << err;
+    }
+
+    GameSnapshot snapshot = game.to_snapshot();
+    EXPECT_EQ(snapshot.get_tichu(0), (int)Tichu::GRAND_TICHU);
+    EXPECT_EQ(snapshot.get_draw_pile().size(), 0);
+
+    GameSnapshot copy;
+    std::memcpy(&copy, &snapshot, sizeof(GameSnapshot));
+    EXPECT_EQ(copy, snapshot);
+
+    // loading the snapshot into another table gives the same state
+    GameState other;
+    start_table(other);
+    ASSERT_TRUE(other.restore(snapshot, err)) << err;
+    EXPECT_EQ(other.to_snapshot(), snapshot);
+    EXPECT_EQ(other.get_active_pile().get_top_combi()->get_key(), game.get_active_pile().get_top_combi()->get_key());
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ(other.get_players().at(i)->get_hand(), players.at(i)->get_hand());
+    }
+
+    // and so does the json round trip of the GameState
+    json data;
+    to_json(data, game);
+    GameState received;
+    from_json(data, received);
+    EXPECT_EQ(received.to_snapshot(), snapshot);
+}
+
+TEST(GameStateTest, SnapshotRejectsUnknownFinisher) {
+    GameState game;
+    start_table(game);
+    json data;
+    to_json(data, game);
+    json stranger;
+    to_json(stranger, Player("stranger"));
+    data["_round_finish_order"] = json::array({stranger});
+
+    GameState received;
+    from_json(data, received);
+    EXPECT_THROW((void)received.to_snapshot(), TichuException);
+}
+
+TEST(GameStateTest, SnapshotOfNextRoundIsNotFinished) {
+    GameState game;
+    auto players = start_table(game);
+    std::string err;
+    for (const player_ptr &player: players) { game.call_grand_tichu(*player, Tichu::NONE, err); }
+    ASSERT_EQ(game.get_game_phase(), SWAPPING);
+
+    // the flag of the last round is still set while the next one is dealt
+    json data;
+    to_json(data, game);
+    data["_is_round_finished"] = true;
+    GameState received;
+    from_json(data, received);
+    EXPECT_FALSE(received.to_snapshot().flags & GameSnapshot::round_finished);
+}
+
+TEST(GameStateTest, SeedReplaysDeals) {
+    // the deals of a seed, as the cards of each seat after the Grand Tichu calls
+    auto deal = [](uint64_t seed) {
+        GameState game;
+        game.set_seed(seed);
+        EXPECT_EQ(game.get_seed(), seed);
+        auto players = start_table(game);
+        std::string err;
+        for (const player_ptr &player: players) { game.call_grand_tichu(*player, Tichu::NONE, err); }
+        std::vector<uint64_t> hands;
+        for (const player_ptr &player: players) { hands.push_back(player->get_hand().get_card_set().get_mask()); }
+        return hands;
+    };
+
+    std::vector<uint64_t> hands = deal(42);
+    uint64_t all = 0;
+    for (uint64_t hand: hands) {
+        EXPECT_EQ(std::popcount(hand), 14);
+        EXPECT_EQ(all & hand, 0);
+        all |= hand;
+    }
+    EXPECT_EQ(all, CardSet::full_mask);
+    EXPECT_EQ(deal(42), hands);
+    EXPECT_NE(deal(43), hands);
+}
+
+TEST(GameStateTest, RandomBelowIsUniform) {
+    Xoshiro256 rng(7);
+    std::array<int, 14> counts{};
+    for (int i = 0; i < 140000; ++i) { ++counts.at(rng.below(14)); }
+    for (int count: counts) {
+        EXPECT_GT(count, 9500);
+        EXPECT_LT(count, 10500);
+    }
+}
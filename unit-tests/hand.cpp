@@ -0,0 +1,91 @@
+#include "gtest/gtest.h"
+#include "../src/common/game_state/player/hand.h"
+#include "../src/common/game_state/cards/move_generator.h"
+
+#include <random>
+
+// the bombs of the hand recomputed from scratch
+static bool expect_bombs(const hand &h) {
+    const CardSet &cards = h.get_card_set();
+    bool any = false;
+    for (int rank = TWO; rank <= ACE; ++rank) {
+        bool four = cards.count_rank(rank) == 4;
+        any |= four;
+        if (((h.get_four_of_a_kind_ranks() >> (rank - 1)) & 1) != four) { return false; }
+    }
+    for (int suit = GREEN; suit <= SCHWARZ; ++suit) {
+        for (int rank = TWO; rank <= ACE; ++rank) {
+            int low = rank;
+            int high = rank;
+            while (cards.contains(Card(rank, suit)) && low > TWO && cards.contains(Card(low - 1, suit))) { --low; }
+            while (cards.contains(Card(rank, suit)) && high < ACE && cards.contains(Card(high + 1, suit))) { ++high; }
+            bool in_bomb = cards.contains(Card(rank, suit)) && high - low + 1 >= 5;
+            any |= in_bomb;
+            if (((h.get_street_bomb_ranks(suit) >> (rank - 1)) & 1) != in_bomb) { return false; }
+        }
+    }
+    return any == h.has_bomb();
+}
+
+TEST(HandTest, BombTrackingFollowsAddAndRemove) {
+    std::mt19937 rng(5);
+    std::string err;
+    hand h;
+    for (int step = 0; step < 5000; ++step) {
+        Card card = Card::from_id((uint8_t)(rng() % card_table::nof_cards));
+        if (h.get_card_set().contains(card)) {
+            h.remove_card(card, err);
+        } else {
+            h.add_card(card, err);
+        }
+        ASSERT_TRUE(expect_bombs(h)) << "step " << step;
+
+        if (step % 500 == 0) {
+            // removing several cards at once and the round trip through json
+            auto cards = h.get_cards();
+            h.remove_cards(std::vector<Card>(cards.begin(), cards.begin() + cards.size() / 2), err);
+            ASSERT_TRUE(expect_bombs(h));
+            json data;
+            to_json(data, h);
+            hand received;
+            from_json(data, received);
+            ASSERT_TRUE(expect_bombs(received));
+            EXPECT_EQ(received.has_bomb(), h.has_bomb());
+        }
+    }
+}
+
+TEST(HandTest, IsBomb) {
+    std::mt19937 rng(9);
+    for (int round = 0; round < 200; ++round) {
+        std::vector<Card> deck = CardSet::full_deck().to_vector();
+        std::shuffle(deck.begin(), deck.end(), rng);
+        // large hands hold bombs more often
+        hand h(std::vector<Card>(deck.begin(), deck.begin() + 24));
+
+        for (const CardCombination &combi: MoveGenerator::get_legal_moves(h.get_card_set(), {})) {
+            EXPECT_EQ(h.is_bomb(CardSet(combi.get_cards())), combi.get_combination_type() == BOMB);
+        }
+        if (!h.has_bomb()) {
+            EXPECT_FALSE(h.is_bomb(CardSet(std::vector<Card>{Card(TWO, GREEN), Card(TWO, RED), Card(TWO, BLUE),
+                                                             Card(TWO, SCHWARZ)})));
+        }
+    }
+
+    hand street({Card(NINE, BLUE), Card(TEN, BLUE), Card(JACK, BLUE), Card(QUEEN, BLUE), Card(KING, BLUE),
+                 Card(ACE, BLUE)});
+    EXPECT_TRUE(street.has_bomb());
+    EXPECT_TRUE(street.is_bomb(CardSet(std::vector<Card>{Card(TEN, BLUE), Card(JACK, BLUE), Card(QUEEN, BLUE),
+                                                         Card(KING, BLUE), Card(ACE, BLUE)})));
+    EXPECT_FALSE(street.is_bomb(CardSet(std::vector<Card>{Card(NINE, BLUE), Card(TEN, BLUE), Card(JACK, BLUE),
+                                                          Card(QUEEN, BLUE), Card(ACE, BLUE)})));
+}
+
+TEST(HandTest, GetCardsKeepsTheBuffer) {
+    hand h({Card(KING, RED), Card(TWO, GREEN), DRAGON});
+    std::vector<Card> cards(14);
+    const Card *buffer = cards.data();
+    h.get_cards(cards);
+    EXPECT_EQ(cards, h.get_cards());
+    EXPECT_EQ(cards.data(), buffer);
+}
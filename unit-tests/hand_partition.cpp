@@ -0,0 +1,107 @@
+#include "gtest/gtest.h"
+#include "../src/common/game_state/cards/hand_partition.h"
+#include "../src/common/game_state/cards/move_generator.h"
+
+#include <map>
+#include <random>
+
+// the reference: the fewest combinations and then the most bombs, over every combination containing the lowest card
+static std::pair<int, int> best_split(uint64_t cards, std::map<uint64_t, std::pair<int, int>> &memo) {
+    if (!cards) { return {0, 0}; }
+    if (auto it = memo.find(cards); it != memo.end()) { return it->second; }
+    const uint64_t lowest = cards & -cards;
+    std::pair<int, int> best{INT32_MAX, 0};
+    for (const CardCombination &combi: MoveGenerator::get_legal_moves(CardSet(cards), std::nullopt)) {
+        const uint64_t mask = CardSet(combi.get_cards()).get_mask();
+        if (!(mask & lowest)) { continue; }
+        auto [size, bombs] = best_split(cards & ~mask, memo);
+        const int is_bomb = combi.get_combination_type() == BOMB ? 1 : 0;
+        if (size + 1 < best.first || (size + 1 == best.first && bombs + is_bomb > best.second)) {
+            best = {size + 1, bombs + is_bomb};
+        }
+    }
+    return memo[cards] = best;
+}
+
+// every group is a combination, the groups are disjoint and cover the hand
+static void expect_valid(const CardSet &hand, const HandPartition &partition) {
+    uint64_t covered = 0;
+    int bombs = 0;
+    for (int i = 0; i < partition.size(); ++i) {
+        const uint64_t group = partition.get_group(i).get_mask();
+        EXPECT_EQ(covered & group, 0);
+        covered |= group;
+        const CardCombination combi(partition.get_group(i).to_vector());
+        EXPECT_NE(combi.get_combination_type(), NONE) << "group " << i;
+        bombs += combi.get_combination_type() == BOMB;
+    }
+    EXPECT_EQ(covered, hand.get_mask());
+    EXPECT_GE(bombs, partition.get_nof_bombs());
+}
+
+TEST(HandPartitionTest, MatchesExhaustiveSearch) {
+    std::mt19937 rng(11);
+    for (int round = 0; round < 300; ++round) {
+        std::vector<Card> deck = CardSet::full_deck().to_vector();
+        std::shuffle(deck.begin(), deck.end(), rng);
+        // few ranks, so the hands have doubles, full houses and stairs
+        CardSet hand;
+        for (Card card: deck) {
+            if (hand.size() == 10) { break; }
+            if (card.get_rank() == SPECIAL || card.get_rank() <= 2 + round % 6) { hand.insert(card); }
+        }
+
+        std::map<uint64_t, std::pair<int, int>> memo;
+        const auto [size, bombs] = best_split(hand.get_mask(), memo);
+        const HandPartition partition = HandPartition::solve(hand);
+        expect_valid(hand, partition);
+        EXPECT_EQ(partition.size(), size) << "round " << round;
+        EXPECT_EQ(partition.get_nof_bombs(), bombs) << "round " << round;
+    }
+}
+
+TEST(HandPartitionTest, FullHandsArePartitioned) {
+    std::mt19937 rng(3);
+    for (int round = 0; round < 200; ++round) {
+        std::vector<Card> deck = CardSet::full_deck().to_vector();
+        std::shuffle(deck.begin(), deck.end(), rng);
+        const CardSet hand(std::vector<Card>(deck.begin(), deck.begin() + 14));
+        const HandPartition partition = HandPartition::solve(hand);
+        expect_valid(hand, partition);
+        EXPECT_EQ((int)partition.get_combinations().size(), partition.size());
+    }
+    EXPECT_EQ(HandPartition::solve(CardSet()).size(), 0);
+}
+
+TEST(HandPartitionTest, SpecialCards) {
+    // the Phoenix fills the gap of the street, the Dog and the Dragon are played alone
+    const CardSet hand(std::vector<Card>{Card(TWO, RED), Card(THREE, GREEN), Card(FOUR, BLUE), Card(SIX, RED),
+                                         PHONIX, HUND, DRAGON});
+    const HandPartition partition = HandPartition::solve(hand);
+    ASSERT_EQ(partition.size(), 3);
+    EXPECT_EQ(partition.get_group(0), CardSet(HUND));
+    EXPECT_EQ(partition.get_combinations().at(1).get_combination_type(), STRASS);
+    EXPECT_EQ(partition.get_group(2), CardSet(DRAGON));
+
+    // the Majong starts a street
+    const CardSet majong(std::vector<Card>{ONE, Card(TWO, RED), Card(THREE, GREEN), Card(FOUR, BLUE),
+                                           Card(FIVE, RED)});
+    EXPECT_EQ(HandPartition::solve(majong).size(), 1);
+}
+
+TEST(HandPartitionTest, TieBreaks) {
+    // a four of a kind and a double: the bomb stays intact instead of forming stairs and a double
+    const CardSet bomb(std::vector<Card>{Card(SEVEN, GREEN), Card(SEVEN, RED), Card(SEVEN, BLUE),
+                                         Card(SEVEN, SCHWARZ), Card(EIGHT, GREEN), Card(EIGHT, RED)});
+    const HandPartition with_bomb = HandPartition::solve(bomb);
+    EXPECT_EQ(with_bomb.size(), 2);
+    EXPECT_EQ(with_bomb.get_nof_bombs(), 1);
+
+    // the aces stay a double of their own, the fives complete the full house
+    const CardSet aces(std::vector<Card>{Card(FIVE, GREEN), Card(FIVE, RED), Card(KING, GREEN), Card(KING, RED),
+                                         Card(KING, BLUE), Card(ACE, GREEN), Card(ACE, BLUE)});
+    const HandPartition with_aces = HandPartition::solve(aces);
+    ASSERT_EQ(with_aces.size(), 2);
+    EXPECT_EQ(with_aces.get_group(1), CardSet(std::vector<Card>{Card(ACE, GREEN), Card(ACE, BLUE)}));
+    EXPECT_EQ(with_aces.get_control(), 13 + 14);
+}
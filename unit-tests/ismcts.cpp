@@ -0,0 +1,148 @@
+#include "gtest/gtest.h"
+#include "../src/common/game_state/ismcts.h"
+#include "../src/common/game_state/game_state.h"
+#include "test_tables.h"
+
+#include <bit>
+#include <random>
+
+// positions of random rounds seen from the player to move, with a tracker that followed the moves
+struct Position {
+    GameSnapshot state;
+    CardTracker tracker;
+    int observer;
+};
+
+static std::vector<Position> random_positions(int nof_rounds, int every) {
+    std::vector<Position> res;
+    std::mt19937 rng(17);
+    for (int round = 0; round < nof_rounds; ++round) {
+        GameState game;
+        deal_table(game, round + 1);
+
+        GameEngine engine(game.to_snapshot());
+        CardTracker tracker(engine.get_state());
+        std::vector<Move> moves;
+        for (int turn = 0; !(engine.get_state().flags & GameSnapshot::round_finished); ++turn) {
+            const GameSnapshot &state = engine.get_state();
+            if (state.phase != SWAPPING && turn % every == 0) {
+                res.push_back({state, tracker, engine.get_current_player()});
+            }
+            engine.get_legal_moves(engine.get_current_player(), moves);
+            const Move move = moves.at(rng() % moves.size());
+            tracker.apply(state, move);
+            engine.apply(move);
+        }
+    }
+    return res;
+}
+
+TEST(IsmctsTest, DeterminizeKeepsWhatTheObserverKnows) {
+    Xoshiro256 rng(5);
+    int nof_checked = 0;
+    int nof_violations = 0;
+    for (const Position &position: random_positions(30, 3)) {
+        const GameSnapshot &view = position.state;
+        const int observer = position.observer;
+        GameSnapshot deal;
+        IsmctsSearch::determinize(view, observer, position.tracker, rng, deal);
+
+        // only the hidden hands change, the cards stay with the other seats
+        GameSnapshot same = deal;
+        std::copy(std::begin(view.hands), std::end(view.hands), std::begin(same.hands));
+        EXPECT_EQ(same, view);
+        EXPECT_EQ(deal.hands[observer], view.hands[observer]);
+        uint64_t dealt = 0;
+        uint64_t hidden = 0;
+        for (int seat = 0; seat < 4; ++seat) {
+            if (seat == observer) { continue; }
+            EXPECT_EQ(std::popcount(deal.hands[seat]), std::popcount(view.hands[seat]));
+            EXPECT_EQ(dealt & deal.hands[seat], 0u);
+            dealt |= deal.hands[seat];
+            hidden |= view.hands[seat];
+            EXPECT_TRUE(CardSet(deal.hands[seat]).contains(position.tracker.get_known(observer, seat)));
+            nof_violations += (deal.hands[seat] & position.tracker.get_excluded(seat).get_mask()) != 0;
+        }
+        EXPECT_EQ(dealt, hidden);
+        ++nof_checked;
+    }
+    EXPECT_GT(nof_checked, 300);
+    // the real deal keeps the ruled out ranks, the random deal almost always finds one that does
+    EXPECT_LE(nof_violations, nof_checked / 50);
+}
+
+TEST(IsmctsTest, SearchesLegalMoves) {
+    IsmctsSearch::Settings settings;
+    settings.budget = std::chrono::milliseconds(0);
+    settings.max_iterations = 100;
+    settings.seed = 3;
+    const IsmctsSearch search(settings);
+
+    std::vector<Move> moves;
+    int nof_searched = 0;
+    for (const Position &position: random_positions(4, 5)) {
+        GameEngine(position.state).get_legal_moves(position.observer, moves);
+        const IsmctsResult res = search.search(position.state, position.observer, position.tracker);
+        EXPECT_NE(std::find(moves.begin(), moves.end(), res.move), moves.end());
+        if (moves.size() == 1) { continue; }
+        ++nof_searched;
+
+        EXPECT_EQ(res.iterations, 100u);
+        uint64_t visits = 0;
+        for (const auto &[move, count]: res.visits) {
+            EXPECT_NE(std::find(moves.begin(), moves.end(), move), moves.end());
+            visits += count;
+        }
+        EXPECT_EQ(visits, 100u);
+        EXPECT_EQ(res.visits.front().first, res.move);
+
+        // one thread with an iteration budget searches the same tree again
+        const IsmctsResult again = search.search(position.state, position.observer, position.tracker);
+        EXPECT_EQ(again.move, res.move);
+        EXPECT_EQ(again.visits, res.visits);
+    }
+    EXPECT_GT(nof_searched, 5);
+}
+
+TEST(IsmctsTest, MergesThreads) {
+    IsmctsSearch::Settings settings;
+    settings.nof_threads = 3;
+    settings.budget = std::chrono::milliseconds(0);
+    settings.max_iterations = 300;
+    const IsmctsSearch search(settings);
+
+    std::vector<Move> moves;
+    for (const Position &position: random_positions(2, 7)) {
+        GameEngine(position.state).get_legal_moves(position.observer, moves);
+        if (moves.size() == 1) { continue; }
+        const IsmctsResult res = search.search(position.state, position.observer, position.tracker);
+        EXPECT_EQ(res.iterations, 300u);
+        uint64_t visits = 0;
+        for (const auto &[move, count]: res.visits) { visits += count; }
+        EXPECT_EQ(visits, 300u);
+        EXPECT_NE(std::find(moves.begin(), moves.end(), res.move), moves.end());
+    }
+}
+
+TEST(IsmctsTest, StopsAtTheTimeBudget) {
+    IsmctsSearch::Settings settings;
+    settings.nof_threads = 2;
+    settings.budget = std::chrono::milliseconds(20);
+    const IsmctsSearch search(settings);
+
+    std::vector<Move> moves;
+    for (const Position &position: random_positions(1, 1)) {
+        GameEngine(position.state).get_legal_moves(position.observer, moves);
+        if (moves.size() == 1) { continue; }
+        const IsmctsResult res = search.search(position.state, position.observer, position.tracker);
+        EXPECT_GT(res.iterations, 0u);
+        EXPECT_LT(res.seconds, 1.0);
+        break;
+    }
+}
+
+TEST(IsmctsTest, NeedsABudget) {
+    IsmctsSearch::Settings settings;
+    settings.budget = std::chrono::milliseconds(0);
+    EXPECT_THROW(IsmctsSearch{settings}, TichuException);
+}
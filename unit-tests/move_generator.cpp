@@ -0,0 +1,97 @@
+#include "gtest/gtest.h"
+#include "../src/common/game_state/cards/move_generator.h"
+
+#include <random>
+#include <set>
+
+// classifies every subset of the hand, the reference the MoveGenerator has to agree with
+static std::set<uint64_t> brute_force_moves(const CardSet &hand, const std::optional<CardCombination> &top) {
+    std::vector<Card> cards = hand.to_vector();
+    std::set<uint64_t> res;
+    std::string err;
+    for (uint32_t subset = 1; subset < (1u << cards.size()); ++subset) {
+        std::vector<Card> selection;
+        for (int i = 0; i < cards.size(); ++i) {
+            if (subset & (1u << i)) { selection.push_back(cards.at(i)); }
+        }
+        CardCombination combi(selection);
+        if (combi.get_combination_type() != NONE && combi.can_be_played_on(top, err)) {
+            res.insert(CardSet(selection).get_mask());
+        }
+    }
+    return res;
+}
+
+static std::set<uint64_t> generated_moves(const CardSet &hand, const std::optional<CardCombination> &top) {
+    std::set<uint64_t> res;
+    for (const CardCombination &combi: MoveGenerator::get_legal_moves(hand, top)) {
+        if (combi.get_combination_type() == PASS) { continue; }
+        EXPECT_TRUE(res.insert(CardSet(combi.get_cards()).get_mask()).second) << "duplicate move";
+    }
+    // the plain data plays carry the key the combination has on the trick
+    std::vector<LegalPlay> plays;
+    MoveGenerator::get_legal_plays(hand.get_mask(), top ? top->get_key() : 0, 0, plays);
+    for (const LegalPlay &play: plays) {
+        EXPECT_EQ(play.key, CardCombination(CardSet(play.cards).to_vector()).played_on(top).get_key());
+    }
+    return res;
+}
+
+TEST(MoveGeneratorTest, MatchesBruteForce) {
+    std::mt19937 rng(42);
+    std::vector<std::optional<CardCombination>> tops = {
+            std::nullopt,
+            CardCombination(Card(NINE, RED)),
+            CardCombination({Card(FIVE, RED), Card(FIVE, GREEN)}),
+            CardCombination({Card(FOUR, RED), Card(FOUR, GREEN), Card(FOUR, BLUE)}),
+            CardCombination({Card(THREE, RED), Card(THREE, GREEN), Card(THREE, BLUE), Card(SIX, RED), Card(SIX, BLUE)}),
+            CardCombination({Card(THREE, RED), Card(FOUR, GREEN), Card(FIVE, BLUE), Card(SIX, RED), Card(SEVEN, BLUE)}),
+            CardCombination({Card(THREE, RED), Card(THREE, GREEN), Card(FOUR, BLUE), Card(FOUR, RED)}),
+            CardCombination({Card(TWO, RED), Card(TWO, GREEN), Card(TWO, BLUE), Card(TWO, SCHWARZ)}),
+            CardCombination(HUND),
+            CardCombination(ONE),
+    };
+
+    for (int round = 0; round < 30; ++round) {
+        std::vector<Card> deck = CardSet::full_deck().to_vector();
+        std::shuffle(deck.begin(), deck.end(), rng);
+        // small hands keep the number of subsets low, denser hands make more combinations
+        int n = 8 + round % 5;
+        CardSet hand(std::vector<Card>(deck.begin(), deck.begin() + n));
+
+        for (const auto &top: tops) {
+            EXPECT_EQ(generated_moves(hand, top), brute_force_moves(hand, top));
+        }
+    }
+}
+
+TEST(MoveGeneratorTest, PhoenixStreetsAndStairs) {
+    CardSet hand(std::vector<Card>{Card(TWO, RED), Card(THREE, RED), Card(THREE, GREEN), Card(FOUR, BLUE),
+                                   Card(FOUR, RED), Card(SIX, GREEN), Card(SIX, RED), Card(SEVEN, RED), PHONIX});
+    for (const auto &top: {std::optional<CardCombination>(), std::optional<CardCombination>(CardCombination(Card(FIVE, RED)))}) {
+        EXPECT_EQ(generated_moves(hand, top), brute_force_moves(hand, top));
+    }
+}
+
+TEST(MoveGeneratorTest, PassAndWish) {
+    hand h(std::vector<Card>{Card(TWO, RED), Card(SEVEN, GREEN), Card(SEVEN, RED), Card(KING, BLUE)});
+
+    auto leading = MoveGenerator::get_legal_moves(h, {});
+    for (const auto &combi: leading) {
+        EXPECT_NE(combi.get_combination_type(), PASS);
+    }
+
+    CardCombination top(Card(FIVE, BLUE));
+    auto moves = MoveGenerator::get_legal_moves(h, top, Card(SEVEN, SCHWARZ));
+    ASSERT_EQ(moves.size(), 2);
+    for (const auto &combi: moves) {
+        EXPECT_EQ(combi.get_combination_type(), SINGLE);
+        EXPECT_EQ(combi.get_combination_rank(), SEVEN);
+    }
+
+    // the wish can't be fulfilled on a higher card, passing is allowed again
+    CardCombination high_top(Card(ACE, BLUE));
+    auto high_moves = MoveGenerator::get_legal_moves(h, high_top, Card(SEVEN, SCHWARZ));
+    ASSERT_EQ(high_moves.size(), 1);
+    EXPECT_EQ(high_moves.at(0).get_combination_type(), PASS);
+}
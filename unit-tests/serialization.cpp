@@ -61,10 +61,40 @@ TEST(SerializationTest, Card) {
     EXPECT_EQ(send, receive);
 }
 
+TEST(SerializationTest, CardWireFormat) {
+    json data = json::parse(R"({"_rank": 13, "_suit": 3, "_value": 10})");
+    Card receive{};
+    from_json(data, receive);
+
+    EXPECT_EQ(receive, Card(KING, BLUE));
+    EXPECT_EQ(receive.get_value(), 10);
+
+    json invalid = json::parse(R"({"_rank": 17, "_suit": 18, "_value": 19})");
+    EXPECT_THROW(from_json(invalid, receive), TichuException);
+}
+
+TEST(SerializationTest, CombinationIsReclassified) {
+    // a client claiming a bomb for a double of kings
+    json data = json::parse(R"({"_cards": [{"_rank": 13, "_suit": 1, "_value": 10}, {"_rank": 13, "_suit": 2, "_value": 10}],
+                                "_combination_type": 4, "_combination_rank": 14})");
+    CardCombination receive;
+    from_json(data, receive);
+    EXPECT_EQ(receive.get_combination_type(), DOUBLE);
+    EXPECT_EQ(receive.get_combination_rank(), KING);
+
+    // the rank of a Phoenix on the ActivePile survives the round trip
+    auto phoenix = CardCombination(PHONIX).played_on(CardCombination(Card(NINE, RED)));
+    json phoenix_data;
+    to_json(phoenix_data, phoenix);
+    from_json(phoenix_data, receive);
+    EXPECT_EQ(receive.get_key(), phoenix.get_key());
+    EXPECT_EQ(receive.get_combination_rank(), NINE);
+}
+
 
 TEST(SerializationTest, Hand) {
     std::vector<Card> cards = {
-            {Card(11, 12, 13), Card(14, 15, 16), Card(17, 18, 19)},
+            {Card(JACK, GREEN), Card(ACE, RED), Card(FIVE, BLUE)},
     };
     auto send = hand(cards);
     json data;
@@ -84,9 +114,9 @@ TEST(SerializationTest, Hand) {
 TEST(SerializationTest, Player) {
     auto player = Player("name");
     std::string err;
-    player.add_card_to_hand(Card(11, 12, 13), err);
-    player.add_card_to_hand(Card(12, 13, 14), err);
-    player.add_card_to_hand(Card(10, 2, 1), err);
+    player.add_card_to_hand(Card(JACK, GREEN), err);
+    player.add_card_to_hand(Card(QUEEN, SCHWARZ), err);
+    player.add_card_to_hand(Card(TEN, RED), err);
     auto send = Player("name");
     json data;
     to_json(data, send);
@@ -103,10 +133,10 @@ TEST(SerializationTest, Player) {
 
 TEST(SerializationTest, DiscardPile) {
     std::vector<Card> cards1 = {
-            {Card(11, 12, 13), Card(14, 15, 16), Card(17, 18, 19)},
+            {Card(JACK, GREEN), Card(ACE, RED), Card(FIVE, BLUE)},
     };
     std::vector<Card> cards2 = {
-            {Card(11, 12, 13), Card(14, 15, 16), Card(17, 18, 19)},
+            {Card(JACK, GREEN), Card(ACE, RED), Card(FIVE, BLUE)},
     };
     CardCombination combi1(cards1);
     CardCombination combi2(cards2);
@@ -122,7 +152,7 @@ TEST(SerializationTest, DiscardPile) {
 
 TEST(SerializationTest, DrawPile) {
     std::vector<Card> cards = {
-            {Card(11, 12, 13), Card(14, 15, 16), Card(17, 18, 19)},
+            {Card(JACK, GREEN), Card(ACE, RED), Card(FIVE, BLUE)},
     };
     auto send = DrawPile(cards);
     json data;
@@ -135,11 +165,11 @@ TEST(SerializationTest, DrawPile) {
 
 TEST(SerializationTest, FullStateResponse) {
     std::vector<std::vector<Card>> all_cards = {
-            {Card(11, 12, 13), Card(14, 15, 16), Card(17, 18, 19)},
-            {Card(21, 22, 23), Card(24, 25, 26), Card(27, 28, 29)},
-            {Card(31, 32, 33), Card(34, 35, 36), Card(37, 38, 39)},
-            {Card(41, 42, 43), Card(44, 45, 46), Card(47, 48, 49)},
-            {Card(51, 52, 53), Card(54, 55, 56), Card(57, 58, 59)},
+            {Card(TWO, GREEN), Card(THREE, RED), Card(FOUR, BLUE)},
+            {Card(FIVE, SCHWARZ), Card(SIX, GREEN), Card(SEVEN, RED)},
+            {Card(EIGHT, BLUE), Card(NINE, SCHWARZ), Card(TEN, GREEN)},
+            {Card(JACK, RED), Card(QUEEN, BLUE), Card(KING, SCHWARZ)},
+            {Card(ACE, GREEN), PHONIX, DRAGON},
     };
 
     std::vector<player_ptr> players = {
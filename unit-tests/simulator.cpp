@@ -0,0 +1,30 @@
+#include "gtest/gtest.h"
+#include "../src/sim/simulator.h"
+
+static void expect_same_games(const SimulationStats &first, const SimulationStats &second) {
+    EXPECT_EQ(first.games, second.games);
+    EXPECT_EQ(first.rounds, second.rounds);
+    EXPECT_EQ(first.moves, second.moves);
+    EXPECT_EQ(first.wins_a, second.wins_a);
+    EXPECT_EQ(first.wins_b, second.wins_b);
+    EXPECT_EQ(first.points_a, second.points_a);
+    EXPECT_EQ(first.points_b, second.points_b);
+}
+
+TEST(SimulatorTest, ResultsOnlyDependOnTheSeed) {
+    auto greedy = SeatPolicy::create("greedy");
+    auto random = SeatPolicy::create("random");
+    ASSERT_TRUE(greedy && random);
+    const Simulator simulator({greedy.get(), random.get(), greedy.get(), random.get()}, 7);
+
+    const SimulationStats single = simulator.run(12, 1);
+    EXPECT_EQ(single.games, 12);
+    EXPECT_LE(single.wins_a + single.wins_b, single.games);
+    EXPECT_GE(single.rounds, single.games);
+    expect_same_games(simulator.run(12, 4), single);
+    expect_same_games(simulator.run(12, 1), single);
+
+    // another seed plays other games
+    const Simulator other({greedy.get(), random.get(), greedy.get(), random.get()}, 8);
+    EXPECT_NE(other.run(12, 1).moves, single.moves);
+}
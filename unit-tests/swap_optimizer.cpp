@@ -0,0 +1,53 @@
+#include "gtest/gtest.h"
+#include "../src/common/game_state/swap_optimizer.h"
+#include "../src/common/utils.h"
+
+// a bomb of sevens, the Dragon and the Mah Jong with a low street, and scattered singles
+static const CardSet hand(std::vector<Card>{ONE, Card(TWO, RED), Card(THREE, BLUE), Card(FOUR, GREEN),
+                                            Card(FIVE, RED), Card(SEVEN, GREEN), Card(SEVEN, RED),
+                                            Card(SEVEN, BLUE), Card(SEVEN, SCHWARZ), Card(NINE, GREEN),
+                                            Card(JACK, BLUE), Card(QUEEN, RED), Card(ACE, GREEN), DRAGON});
+
+TEST(SwapOptimizerTest, StrengthCountsCombinations) {
+    const CardSet street(std::vector<Card>{Card(TWO, RED), Card(THREE, BLUE), Card(FOUR, GREEN), Card(FIVE, RED),
+                                           Card(SIX, GREEN)});
+    const CardSet singles(std::vector<Card>{Card(TWO, RED), Card(FOUR, BLUE), Card(SIX, GREEN), Card(EIGHT, RED),
+                                            Card(TEN, GREEN)});
+    EXPECT_GT(SwapOptimizer::strength(street), SwapOptimizer::strength(singles));
+    // with the same combinations the higher cards are stronger
+    EXPECT_GT(SwapOptimizer::strength(CardSet(Card(ACE, RED))), SwapOptimizer::strength(CardSet(Card(TWO, RED))));
+}
+
+TEST(SwapOptimizerTest, KeepsTheBombAndTheHighCards) {
+    const SwapChoice choice = SwapOptimizer({}).choose(hand);
+    CardSet given;
+    for (Card card: choice.cards) {
+        EXPECT_TRUE(hand.contains(card));
+        given |= CardSet(card);
+    }
+    EXPECT_EQ(given.size(), 3);
+    for (Card kept: {Card(SEVEN, GREEN), Card(SEVEN, RED), Card(SEVEN, BLUE), Card(SEVEN, SCHWARZ), DRAGON,
+                     Card(ACE, GREEN)}) {
+        EXPECT_FALSE(given.contains(kept));
+    }
+    // the highest of the three goes to the partner
+    EXPECT_GT(choice.cards[1].get_sort_key(), choice.cards[0].get_sort_key());
+    EXPECT_GT(choice.cards[1].get_sort_key(), choice.cards[2].get_sort_key());
+}
+
+TEST(SwapOptimizerTest, SameChoiceWithAnyNumberOfThreads) {
+    SwapOptimizer::Settings settings;
+    settings.seed = 9;
+    const SwapChoice one = SwapOptimizer(settings).choose(hand);
+    settings.nof_threads = 4;
+    const SwapChoice four = SwapOptimizer(settings).choose(hand);
+    EXPECT_EQ(one.cards, four.cards);
+    EXPECT_EQ(one.strength, four.strength);
+}
+
+TEST(SwapOptimizerTest, NeedsAFullHand) {
+    EXPECT_THROW((void)SwapOptimizer({}).choose(hand - CardSet(DRAGON)), TichuException);
+    SwapOptimizer::Settings settings;
+    settings.nof_samples = 0;
+    EXPECT_THROW(SwapOptimizer{settings}, TichuException);
+}
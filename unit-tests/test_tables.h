@@ -0,0 +1,35 @@
+// The tables of four players the unit tests start their games from.
+
+#ifndef TICHU_TEST_TABLES_H
+#define TICHU_TEST_TABLES_H
+
+#include "gtest/gtest.h"
+#include "../src/common/game_state/game_state.h"
+
+#include <optional>
+
+// a started table, the first 8 cards are dealt. The teams are drawn at the start, the seats are the order of
+// get_players()
+inline std::vector<player_ptr> start_table(GameState &state, std::optional<uint64_t> seed = {}) {
+    std::string err;
+    if (seed) { state.set_seed(*seed); }
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(state.add_player(std::make_shared<Player>("player " + std::to_string(i)), err)) << err;
+    }
+    EXPECT_TRUE(state.start_game(err)) << err;
+    return state.get_players();
+}
+
+// a dealt table in the SWAPPING phase, nobody called a Grand Tichu
+inline std::vector<player_ptr> deal_table(GameState &state, std::optional<uint64_t> seed = {}) {
+    std::vector<player_ptr> players = start_table(state, seed);
+    std::string err;
+    for (const player_ptr &player: players) {
+        EXPECT_TRUE(state.call_grand_tichu(*player, Tichu::NONE, err)) << err;
+    }
+    EXPECT_EQ(state.get_game_phase(), SWAPPING);
+    return players;
+}
+
+
+#endif //TICHU_TEST_TABLES_H
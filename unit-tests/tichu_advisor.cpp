@@ -0,0 +1,67 @@
+#include "gtest/gtest.h"
+#include "../src/common/game_state/tichu_advisor.h"
+#include "../src/common/utils.h"
+
+static TichuAdvisor::Settings samples(uint64_t nof_samples, int nof_threads = 1) {
+    TichuAdvisor::Settings settings;
+    settings.budget = std::chrono::milliseconds(0);
+    settings.max_samples = nof_samples;
+    settings.nof_threads = nof_threads;
+    settings.seed = 3;
+    return settings;
+}
+
+static const CardSet strong_start(std::vector<Card>{DRAGON, PHONIX, Card(ACE, GREEN), Card(ACE, RED),
+                                                    Card(ACE, BLUE), Card(ACE, SCHWARZ), Card(KING, RED),
+                                                    Card(KING, BLUE)});
+static const CardSet weak_start(std::vector<Card>{HUND, Card(TWO, RED), Card(THREE, GREEN), Card(FOUR, BLUE),
+                                                  Card(SIX, RED), Card(SEVEN, SCHWARZ), Card(EIGHT, GREEN),
+                                                  Card(TEN, BLUE)});
+
+TEST(TichuAdvisorTest, StrongHandsGoOutFirst) {
+    const TichuAdvisor advisor(samples(400));
+    const TichuAdvice strong = advisor.advise(strong_start, Tichu::GRAND_TICHU);
+    const TichuAdvice weak = advisor.advise(weak_start, Tichu::GRAND_TICHU);
+    EXPECT_EQ(strong.samples, 400);
+    EXPECT_GT(strong.probability, 0.5);
+    EXPECT_LT(weak.probability, 0.4);
+    EXPECT_GT(strong.probability - weak.probability, 0.25);
+    EXPECT_TRUE(TichuAdvisor::should_call(strong));
+    EXPECT_FALSE(TichuAdvisor::should_call(weak));
+    EXPECT_NEAR(strong.expected_delta, (2 * strong.probability - 1) * 200, 1e-9);
+    EXPECT_GT(strong.std_error, 0);
+    EXPECT_LT(strong.std_error, 0.03);
+
+    // six more cards can only help, and a Tichu is worth half a Grand Tichu
+    const CardSet full = strong_start | CardSet(std::vector<Card>{Card(QUEEN, RED), Card(QUEEN, BLUE),
+                                                                  Card(JACK, RED), Card(JACK, BLUE),
+                                                                  Card(TEN, RED), Card(TEN, GREEN)});
+    const TichuAdvice tichu = advisor.advise(full, Tichu::TICHU);
+    EXPECT_GT(tichu.probability, strong.probability);
+    EXPECT_NEAR(tichu.expected_delta, (2 * tichu.probability - 1) * 100, 1e-9);
+    EXPECT_GT(advisor.advise(full, Tichu::TICHU, true).probability, 0.5);
+}
+
+TEST(TichuAdvisorTest, SameResultWithAnyNumberOfThreads) {
+    const TichuAdvice one = TichuAdvisor(samples(200, 1)).advise(strong_start, Tichu::GRAND_TICHU);
+    const TichuAdvice four = TichuAdvisor(samples(200, 4)).advise(strong_start, Tichu::GRAND_TICHU);
+    EXPECT_EQ(one.samples, four.samples);
+    EXPECT_EQ(one.probability, four.probability);
+}
+
+TEST(TichuAdvisorTest, StopsAtTheTimeBudget) {
+    TichuAdvisor::Settings settings;
+    settings.budget = std::chrono::milliseconds(20);
+    settings.nof_threads = 2;
+    const TichuAdvice advice = TichuAdvisor(settings).advise(weak_start, Tichu::GRAND_TICHU);
+    EXPECT_GT(advice.samples, 0);
+    EXPECT_LT(advice.seconds, 0.2);
+}
+
+TEST(TichuAdvisorTest, RejectsWhatItCannotAdvise) {
+    EXPECT_THROW(TichuAdvisor(samples(0)), TichuException);
+    const TichuAdvisor advisor(samples(10));
+    EXPECT_THROW((void)advisor.advise(weak_start - CardSet(HUND), Tichu::GRAND_TICHU), TichuException);
+    EXPECT_THROW((void)advisor.advise(weak_start, Tichu::TICHU, true), TichuException);
+    EXPECT_THROW((void)advisor.advise(weak_start, Tichu::NONE), TichuException);
+}
@@ -0,0 +1,50 @@
+#include "gtest/gtest.h"
+#include "../src/common/game_state/cards/wish_solver.h"
+#include "../src/common/game_state/cards/move_generator.h"
+
+#include <random>
+
+// the reference: is any legal move containing the wished rank
+static bool generator_can_fulfill(const CardSet &hand, const std::optional<CardCombination> &top, int wish) {
+    for (const CardCombination &combi: MoveGenerator::get_legal_moves(hand, top)) {
+        if (combi.count_occurances(Card(wish, GREEN))) { return true; }
+    }
+    return false;
+}
+
+TEST(WishSolverTest, MatchesMoveGenerator) {
+    std::mt19937 rng(7);
+    for (int round = 0; round < 300; ++round) {
+        std::vector<Card> deck = CardSet::full_deck().to_vector();
+        std::shuffle(deck.begin(), deck.end(), rng);
+        CardSet hand(std::vector<Card>(deck.begin(), deck.begin() + 14));
+        CardSet other(std::vector<Card>(deck.begin() + 14, deck.begin() + 28));
+
+        // use the moves of another hand as top combinations
+        auto tops = MoveGenerator::get_legal_moves(other, {});
+        std::vector<std::optional<CardCombination>> sampled = {std::nullopt};
+        for (int i = 0; i < 8 && !tops.empty(); ++i) {
+            sampled.push_back(tops.at(rng() % tops.size()));
+        }
+
+        for (const auto &top: sampled) {
+            for (int wish = TWO; wish <= ACE; ++wish) {
+                EXPECT_EQ(WishSolver::can_fulfill(hand, top, wish), generator_can_fulfill(hand, top, wish))
+                        << "wish " << wish << " top type " << (top ? top->get_combination_type() : -1);
+            }
+        }
+    }
+}
+
+TEST(WishSolverTest, PhoenixAndBombs) {
+    CardSet hand(std::vector<Card>{Card(SEVEN, RED), Card(EIGHT, GREEN), Card(TEN, BLUE), Card(JACK, RED), PHONIX});
+    CardCombination street({Card(THREE, RED), Card(FOUR, GREEN), Card(FIVE, BLUE), Card(SIX, RED), Card(SEVEN, BLUE)});
+    CardCombination pair({Card(SIX, RED), Card(SIX, GREEN)});
+
+    EXPECT_TRUE(WishSolver::can_fulfill(hand, street, EIGHT));
+    EXPECT_TRUE(WishSolver::can_fulfill(hand, pair, SEVEN));
+    EXPECT_FALSE(WishSolver::can_fulfill(hand, pair, NINE));
+
+    CardSet bomb_hand(std::vector<Card>{Card(NINE, RED), Card(NINE, GREEN), Card(NINE, BLUE), Card(NINE, SCHWARZ)});
+    EXPECT_TRUE(WishSolver::can_fulfill(bomb_hand, CardCombination(DRAGON), NINE));
+}